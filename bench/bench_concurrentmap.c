@@ -0,0 +1,206 @@
+/*
+ Throughput benchmark of cConcurrentMap
+
+ Runs a mixed find/insert workload (CCM_BENCH_FIND_PERCENT % finds over a pre-populated key
+ range) with 1 to 64 threads, on cConcurrentMap and on a single hashed cMap guarded by a global
+ mutex, and prints the total operations per second of each.
+
+ Build (POSIX): the bench_concurrentmap target of CMake, or
+   cc -O2 -I.. bench_concurrentmap.c ../cconcurrentmap.c ../cmap.c ../callocator.c ../cfind.c -lpthread
+
+ Usage:
+   bench_concurrentmap [operations per thread] [shard count]
+ ------------------------------------------------------------------------------------------------*/
+
+#define _POSIX_C_SOURCE 200112L
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include <pthread.h>
+#include "cconcurrentmap.h"
+
+#define CCM_BENCH_KEY_RANGE         ((unsigned long)(1UL << 16))
+#define CCM_BENCH_FIND_PERCENT      90UL
+#define CCM_BENCH_MAX_THREADS       64
+
+typedef struct {
+    cConcurrentMap* pMap;
+    cMap* pLockedMap;
+    pthread_mutex_t* pMutex;
+    unsigned long seed;
+    unsigned long opCount;
+    unsigned long hitCount;
+} benchThreadArg;
+
+/*Small xorshift generator, so that the threads do not share the state of rand()*/
+static unsigned long benchNextRandom(unsigned long* pState)
+{
+    unsigned long x = *pState;
+    x ^= (x << 13) & 0xFFFFFFFFUL;
+    x ^= (x >> 17);
+    x ^= (x << 5) & 0xFFFFFFFFUL;
+    *pState = x;
+    return x;
+}
+
+static void* benchShardedWorker(void* pArg)
+{
+    benchThreadArg* arg = (benchThreadArg*)pArg;
+    unsigned long hitCount = 0UL;
+    unsigned long seed = arg->seed;
+    unsigned long opIdx;
+
+    for(opIdx = 0; opIdx < arg->opCount; ++opIdx)
+    {
+        const unsigned long random = benchNextRandom(&seed);
+        const unsigned long key = random % CCM_BENCH_KEY_RANGE;
+        unsigned long value = opIdx;
+
+        if(((random >> 20) % 100UL) < CCM_BENCH_FIND_PERCENT)
+        {
+            hitCount += (0 == cConcurrentMap_find(arg->pMap, &key, &value)) ? 1UL : 0UL;
+        }
+        else
+        {
+            (void)cConcurrentMap_insert(arg->pMap, &key, &value);
+        }
+    }
+
+    /*Written once, so that the neighbour arguments do not share a cache line in the loop*/
+    arg->seed = seed;
+    arg->hitCount = hitCount;
+
+    return NULL;
+}
+
+static void* benchLockedWorker(void* pArg)
+{
+    benchThreadArg* arg = (benchThreadArg*)pArg;
+    unsigned long hitCount = 0UL;
+    unsigned long seed = arg->seed;
+    unsigned long opIdx;
+
+    for(opIdx = 0; opIdx < arg->opCount; ++opIdx)
+    {
+        const unsigned long random = benchNextRandom(&seed);
+        const unsigned long key = random % CCM_BENCH_KEY_RANGE;
+        unsigned long value = opIdx;
+        cPair pair;
+
+        pthread_mutex_lock(arg->pMutex);
+
+        if(((random >> 20) % 100UL) < CCM_BENCH_FIND_PERCENT)
+        {
+            hitCount += (0 == cMap_find(arg->pLockedMap, &key, &pair)) ? 1UL : 0UL;
+        }
+        else
+        {
+            pair.first  = (void*)&key;
+            pair.second = (void*)&value;
+            (void)cMap_insert(arg->pLockedMap, &pair);
+        }
+
+        pthread_mutex_unlock(arg->pMutex);
+    }
+
+    /*Written once, so that the neighbour arguments do not share a cache line in the loop*/
+    arg->seed = seed;
+    arg->hitCount = hitCount;
+
+    return NULL;
+}
+
+/*Runs the worker on "threadCount" threads and returns the elapsed time in seconds*/
+static double benchRun(void* (*worker)(void*), benchThreadArg* argList, const int threadCount)
+{
+    pthread_t threadList[CCM_BENCH_MAX_THREADS];
+    struct timespec start;
+    struct timespec stop;
+    int threadIdx;
+
+    clock_gettime(CLOCK_MONOTONIC, &start);
+
+    for(threadIdx = 0; threadIdx < threadCount; ++threadIdx)
+    {
+        pthread_create(&threadList[threadIdx], NULL, worker, &argList[threadIdx]);
+    }
+
+    for(threadIdx = 0; threadIdx < threadCount; ++threadIdx)
+    {
+        pthread_join(threadList[threadIdx], NULL);
+    }
+
+    clock_gettime(CLOCK_MONOTONIC, &stop);
+
+    return (double)(stop.tv_sec - start.tv_sec) + ((double)(stop.tv_nsec - start.tv_nsec) * 1e-9);
+}
+
+int main(int argc, char** argv)
+{
+    const unsigned long opCount = (argc > 1) ? strtoul(argv[1], NULL, 10) : 200000UL;
+    const size_t shardCount = (argc > 2) ? (size_t)strtoul(argv[2], NULL, 10) : (size_t)(0);
+    benchThreadArg argList[CCM_BENCH_MAX_THREADS];
+    cConcurrentMap map;
+    cMap lockedMap;
+    pthread_mutex_t mutex;
+    unsigned long key;
+    int threadCount;
+
+    if(0 != constructCConcurrentMap(&map, unsigned long, unsigned long, shardCount, NULL, NULL))
+    {
+        fprintf(stderr, "cannot construct the map\n");
+        return EXIT_FAILURE;
+    }
+
+    constructCHashMap(&lockedMap, unsigned long, unsigned long, NULL, NULL);
+    pthread_mutex_init(&mutex, NULL);
+
+    /*Populate half of the key range*/
+    for(key = 0; key < CCM_BENCH_KEY_RANGE; key += 2)
+    {
+        cPair pair;
+        pair.first  = (void*)&key;
+        pair.second = (void*)&key;
+        (void)cConcurrentMap_insert(&map, &key, &key);
+        (void)cMap_insert(&lockedMap, &pair);
+    }
+
+    printf("%-8s %18s %18s %8s\n", "threads", "sharded ops/s", "global lock ops/s", "speedup");
+
+    for(threadCount = 1; threadCount <= CCM_BENCH_MAX_THREADS; threadCount *= 2)
+    {
+        double shardedTime;
+        double lockedTime;
+        int threadIdx;
+
+        for(threadIdx = 0; threadIdx < threadCount; ++threadIdx)
+        {
+            argList[threadIdx].pMap       = &map;
+            argList[threadIdx].pLockedMap = &lockedMap;
+            argList[threadIdx].pMutex     = &mutex;
+            argList[threadIdx].seed       = 2463534242UL + (unsigned long)threadIdx * 7919UL;
+            argList[threadIdx].opCount    = opCount;
+            argList[threadIdx].hitCount   = 0UL;
+        }
+        shardedTime = benchRun(benchShardedWorker, argList, threadCount);
+
+        for(threadIdx = 0; threadIdx < threadCount; ++threadIdx)
+        {
+            argList[threadIdx].seed     = 2463534242UL + (unsigned long)threadIdx * 7919UL;
+            argList[threadIdx].hitCount = 0UL;
+        }
+        lockedTime = benchRun(benchLockedWorker, argList, threadCount);
+
+        printf("%-8d %18.0f %18.0f %7.2fx\n", threadCount,
+               ((double)opCount * threadCount) / shardedTime,
+               ((double)opCount * threadCount) / lockedTime,
+               lockedTime / shardedTime);
+    }
+
+    pthread_mutex_destroy(&mutex);
+    cMap_clear(&lockedMap);
+    cConcurrentMap_destroy(&map);
+
+    return EXIT_SUCCESS;
+}
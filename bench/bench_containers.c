@@ -0,0 +1,706 @@
+/*
+ Operation benchmark of the containers
+
+ Measures insert, find, erase and iterate of cVector, cMap (linear, hashed and sorted modes),
+ cStaticArray, cStaticMap, cStaticHashMap and cStaticSortedMap with the driver of benchcommon.h, and writes the JSON report.
+
+ - cVector      : insert appends, find searches an element, erase removes a position.
+ - cMap         : keys are size_t, values are of the element size. The maps are prepared by
+                  cMap_buildFrom.
+ - cStaticArray : integer values of 1, 2, 4 and 8 bytes, with the vectorized find.
+ - cStaticMap   : size_t keys and integer values of 1, 2, 4 and 8 bytes, with the vectorized find.
+ - cStaticHashMap : size_t keys and integer values of 1, 2, 4 and 8 bytes, with the default hash.
+ - cStaticSortedMap : size_t keys and integer values of 1, 2, 4 and 8 bytes, with binary search.
+
+ The capacity of a static container is fixed at compile time, so each of them is instantiated
+ for twice the prepared sizes up to BENCH_STATIC_MAX_SIZE, and a case uses the smallest one.
+
+ Usage:
+   bench_containers [--max-size N] [--max-bytes N] [--elem-size N] [--container NAME] [--output PATH]
+ ------------------------------------------------------------------------------------------------*/
+
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include "benchcommon.h"
+#include "cvector.h"
+#include "cmap.h"
+#include "cStaticArray.h"
+#include "cStaticMap.h"
+#include "cStaticHashMap.h"
+#include "cStaticSortedMap.h"
+
+/*Largest element size measured*/
+#define BENCH_MAX_ELEM_SIZE     256
+
+/*Largest prepared size of the static containers*/
+#define BENCH_STATIC_MAX_SIZE   4096
+
+/*Element buffer, aligned for the aligned element sizes of cVector and cMap*/
+typedef union {
+    size_t alignment;
+    unsigned char bytes[BENCH_MAX_ELEM_SIZE];
+} benchElem;
+
+/*Allocates the struct of a container, recorded in the heap usage*/
+static void* bench_allocStruct(size_t size)
+{
+    void* ptr = malloc(size);
+
+    if(NULL != ptr)
+    {
+        bench_recordAlloc(size);
+    }
+
+    return ptr;
+}
+
+static void bench_freeStruct(void* ptr, size_t size)
+{
+    bench_recordFree(size);
+    free(ptr);
+}
+
+
+/*cVector*/
+/*---------------------------------------------------------------------------*/
+static void* benchVector_create(size_t elemSize)
+{
+    cVector* pVector = (cVector*)bench_allocStruct(sizeof(cVector));
+
+    if(NULL != pVector)
+    {
+        concreteConstructCVector(pVector, elemSize);
+        (void)cVector_setAllocator(pVector, bench_countingAllocator());
+    }
+
+    return (void*)pVector;
+}
+
+static void benchVector_destroy(void* container)
+{
+    cVector_clear((cVector*)container);
+    bench_freeStruct(container, sizeof(cVector));
+}
+
+static void benchVector_fill(void* container, size_t count)
+{
+    cVector* pVector = (cVector*)container;
+    benchElem elem;
+    size_t idx;
+
+    for(idx = 0; idx < count; ++idx)
+    {
+        bench_makeElem(&elem, pVector->elemSize, 2 * idx);
+        (void)cVector_pushb(pVector, &elem);
+    }
+}
+
+static int benchVector_insert(void* container, size_t draw)
+{
+    cVector* pVector = (cVector*)container;
+    benchElem elem;
+
+    bench_makeElem(&elem, pVector->elemSize, (2 * draw) + 1);
+    return cVector_pushb(pVector, &elem);
+}
+
+static int benchVector_find(void* container, size_t draw)
+{
+    cVector* pVector = (cVector*)container;
+    benchElem elem;
+
+    bench_makeElem(&elem, pVector->elemSize, 2 * draw);
+    return (cVector_find(pVector, &elem) < cVector_size(pVector)) ? 1 : 0;
+}
+
+static int benchVector_erase(void* container, size_t draw)
+{
+    cVector* pVector = (cVector*)container;
+    const size_t size = cVector_size(pVector);
+
+    return (size > 0) ? cVector_eraseAt(pVector, draw % size) : -1;
+}
+
+static size_t benchVector_iterate(void* container)
+{
+    cVector* pVector = (cVector*)container;
+    const size_t size = cVector_size(pVector);
+    size_t sum = 0;
+    size_t idx;
+
+    for(idx = 0; idx < size; ++idx)
+    {
+        sum += *(const unsigned char*)cVector_getAt(pVector, idx);
+    }
+
+    return sum;
+}
+
+static size_t benchVector_size(void* container)
+{
+    return cVector_size((cVector*)container);
+}
+/*---------------------------------------------------------------------------*/
+
+
+/*cMap*/
+/*---------------------------------------------------------------------------*/
+/*Orders the keys by value, so that the prepared keys are appended to a sorted map*/
+static int benchMap_compareKey(const void* key1, const void* key2, size_t keySize)
+{
+    const size_t value1 = *(const size_t*)key1;
+    const size_t value2 = *(const size_t*)key2;
+    (void)keySize;
+
+    return (value1 < value2) ? -1 : ((value1 > value2) ? 1 : 0);
+}
+
+static void* benchMap_alloc(void)
+{
+    return bench_allocStruct(sizeof(cMap));
+}
+
+static void* benchMap_create(size_t elemSize)
+{
+    cMap* pMap = (cMap*)benchMap_alloc();
+
+    if(NULL != pMap)
+    {
+        concreteConstructCMap(pMap, sizeof(size_t), elemSize);
+        (void)cMap_setAllocator(pMap, bench_countingAllocator());
+    }
+
+    return (void*)pMap;
+}
+
+static void* benchHashMap_create(size_t elemSize)
+{
+    cMap* pMap = (cMap*)benchMap_alloc();
+
+    if(NULL != pMap)
+    {
+        concreteConstructCHashMap(pMap, sizeof(size_t), elemSize, NULL, NULL);
+        (void)cMap_setAllocator(pMap, bench_countingAllocator());
+    }
+
+    return (void*)pMap;
+}
+
+static void* benchSortedMap_create(size_t elemSize)
+{
+    cMap* pMap = (cMap*)benchMap_alloc();
+
+    if(NULL != pMap)
+    {
+        concreteConstructCSortedMap(pMap, sizeof(size_t), elemSize, benchMap_compareKey);
+        (void)cMap_setAllocator(pMap, bench_countingAllocator());
+    }
+
+    return (void*)pMap;
+}
+
+static void benchMap_destroy(void* container)
+{
+    cMap_clear((cMap*)container);
+    bench_freeStruct(container, sizeof(cMap));
+}
+
+/*The pairs are built at once, as the duplicate check of the linear map would make
+  the insertions O(n^2)*/
+static void benchMap_fill(void* container, size_t count)
+{
+    cMap* pMap = (cMap*)container;
+    size_t* keys = (size_t*)malloc(count * sizeof(size_t));
+    unsigned char* values = (unsigned char*)malloc(count * pMap->valueSize);
+
+    if((NULL != keys) && (NULL != values))
+    {
+        size_t idx;
+
+        for(idx = 0; idx < count; ++idx)
+        {
+            keys[idx] = 2 * idx;
+            bench_makeElem(&values[idx * pMap->valueSize], pMap->valueSize, 2 * idx);
+        }
+
+        (void)cMap_buildFrom(pMap, keys, values, count);
+    }
+
+    free((void*)values);
+    free((void*)keys);
+}
+
+static int benchMap_insert(void* container, size_t draw)
+{
+    cMap* pMap = (cMap*)container;
+    size_t key = (2 * draw) + 1;
+    benchElem value;
+    cPair pair;
+
+    bench_makeElem(&value, pMap->valueSize, key);
+    pair.first  = (void*)&key;
+    pair.second = (void*)&value;
+
+    return cMap_insert(pMap, &pair);
+}
+
+static int benchMap_find(void* container, size_t draw)
+{
+    const size_t key = 2 * draw;
+    cPair pair;
+
+    return (0 == cMap_find((cMap*)container, &key, &pair)) ? 1 : 0;
+}
+
+static int benchMap_erase(void* container, size_t draw)
+{
+    const size_t key = 2 * draw;
+
+    return cMap_erase((cMap*)container, &key);
+}
+
+static size_t benchMap_iterate(void* container)
+{
+    cMap* pMap = (cMap*)container;
+    const size_t size = cMap_size(pMap);
+    size_t sum = 0;
+    size_t idx;
+
+    for(idx = 0; idx < size; ++idx)
+    {
+        cPair pair;
+
+        if(0 == cMap_getAt(pMap, idx, &pair))
+        {
+            sum += *(const size_t*)pair.first + *(const unsigned char*)pair.second;
+        }
+    }
+
+    return sum;
+}
+
+static size_t benchMap_size(void* container)
+{
+    return cMap_size((cMap*)container);
+}
+/*---------------------------------------------------------------------------*/
+
+
+/*cStaticArray*/
+/*---------------------------------------------------------------------------*/
+/*Defines an array type of VALUE_TYPE holding ARRAY_ALLOC elements and its benchmark functions*/
+#define BENCH_STATIC_ARRAY_DEFINITIONS(TYPENAME, VALUE_TYPE, ARRAY_ALLOC)\
+\
+typedef cStaticArray(VALUE_TYPE, ARRAY_ALLOC) TYPENAME;\
+\
+cStaticArray_METHOD_DECLARATIONS(TYPENAME, VALUE_TYPE)\
+\
+cStaticArray_INTEGER_METHOD_DEFINITIONS(TYPENAME, VALUE_TYPE)\
+\
+static void* TYPENAME##_benchCreate(size_t elemSize)\
+{\
+    TYPENAME* me = (TYPENAME*)bench_allocStruct(sizeof(TYPENAME));\
+    (void)elemSize;\
+    if(NULL != me)\
+    {\
+        TYPENAME##_clear(me);\
+    }\
+    return (void*)me;\
+}\
+\
+static void TYPENAME##_benchDestroy(void* container)\
+{\
+    bench_freeStruct(container, sizeof(TYPENAME));\
+}\
+\
+static void TYPENAME##_benchFill(void* container, size_t count)\
+{\
+    size_t idx;\
+    for(idx = 0; idx < count; ++idx)\
+    {\
+        const VALUE_TYPE value = (VALUE_TYPE)(2 * idx);\
+        (void)TYPENAME##_pushb((TYPENAME*)container, &value);\
+    }\
+}\
+\
+static int TYPENAME##_benchInsert(void* container, size_t draw)\
+{\
+    const VALUE_TYPE value = (VALUE_TYPE)((2 * draw) + 1);\
+    return TYPENAME##_pushb((TYPENAME*)container, &value);\
+}\
+\
+static int TYPENAME##_benchFind(void* container, size_t draw)\
+{\
+    const VALUE_TYPE value = (VALUE_TYPE)(2 * draw);\
+    return (TYPENAME##_find((TYPENAME*)container, &value) < TYPENAME##_size((TYPENAME*)container)) ? 1 : 0;\
+}\
+\
+static int TYPENAME##_benchErase(void* container, size_t draw)\
+{\
+    const size_t size = TYPENAME##_size((TYPENAME*)container);\
+    return (size > 0) ? TYPENAME##_eraseAt((TYPENAME*)container, draw % size) : -1;\
+}\
+\
+static size_t TYPENAME##_benchIterate(void* container)\
+{\
+    const TYPENAME* me = (const TYPENAME*)container;\
+    size_t sum = 0;\
+    size_t idx;\
+    for(idx = 0; idx < me->arraySize; ++idx)\
+    {\
+        sum += (size_t)me->valueList[idx];\
+    }\
+    return sum;\
+}\
+\
+static size_t TYPENAME##_benchSize(void* container)\
+{\
+    return TYPENAME##_size((TYPENAME*)container);\
+}
+
+/*benchContainer of an array type defined by BENCH_STATIC_ARRAY_DEFINITIONS, used for the
+  prepared sizes above the half of the previous capacity*/
+#define BENCH_STATIC_ARRAY_CONTAINER(TYPENAME, VALUE_TYPE, ARRAY_ALLOC)\
+    {"cStaticArray", sizeof(VALUE_TYPE), (ARRAY_ALLOC) / 16 + 1, (ARRAY_ALLOC) / 2, (BENCH_OP_FIND | BENCH_OP_ERASE),\
+     TYPENAME##_benchCreate, TYPENAME##_benchDestroy, TYPENAME##_benchFill, TYPENAME##_benchInsert,\
+     TYPENAME##_benchFind, TYPENAME##_benchErase, TYPENAME##_benchIterate, TYPENAME##_benchSize}
+/*---------------------------------------------------------------------------*/
+
+
+/*cStaticMap*/
+/*---------------------------------------------------------------------------*/
+/*Defines a map type of size_t keys and VALUE_TYPE values holding MAP_ALLOC pairs and its
+  benchmark functions*/
+#define BENCH_STATIC_MAP_DEFINITIONS(TYPENAME, VALUE_TYPE, MAP_ALLOC)\
+\
+typedef cStaticMap(size_t, VALUE_TYPE, MAP_ALLOC) TYPENAME;\
+\
+cStaticMap_METHOD_DECLARATIONS(TYPENAME, size_t, VALUE_TYPE)\
+\
+cStaticMap_INTEGER_METHOD_DEFINITIONS(TYPENAME, size_t, VALUE_TYPE)\
+\
+static void* TYPENAME##_benchCreate(size_t elemSize)\
+{\
+    TYPENAME* me = (TYPENAME*)bench_allocStruct(sizeof(TYPENAME));\
+    (void)elemSize;\
+    if(NULL != me)\
+    {\
+        TYPENAME##_clear(me);\
+    }\
+    return (void*)me;\
+}\
+\
+static void TYPENAME##_benchDestroy(void* container)\
+{\
+    bench_freeStruct(container, sizeof(TYPENAME));\
+}\
+\
+static void TYPENAME##_benchFill(void* container, size_t count)\
+{\
+    TYPENAME* me = (TYPENAME*)container;\
+    size_t idx;\
+    for(idx = 0; idx < count; ++idx)\
+    {\
+        me->keyList[idx]   = 2 * idx;\
+        me->valueList[idx] = (VALUE_TYPE)(2 * idx);\
+    }\
+    me->mapSize = count;\
+}\
+\
+static int TYPENAME##_benchInsert(void* container, size_t draw)\
+{\
+    const size_t key = (2 * draw) + 1;\
+    const VALUE_TYPE value = (VALUE_TYPE)key;\
+    return TYPENAME##_insert((TYPENAME*)container, &key, &value);\
+}\
+\
+static int TYPENAME##_benchFind(void* container, size_t draw)\
+{\
+    const size_t key = 2 * draw;\
+    return (0 == TYPENAME##_find((TYPENAME*)container, &key, NULL)) ? 1 : 0;\
+}\
+\
+static int TYPENAME##_benchErase(void* container, size_t draw)\
+{\
+    const size_t key = 2 * draw;\
+    return TYPENAME##_erase((TYPENAME*)container, &key);\
+}\
+\
+static size_t TYPENAME##_benchIterate(void* container)\
+{\
+    const TYPENAME* me = (const TYPENAME*)container;\
+    size_t sum = 0;\
+    size_t idx;\
+    for(idx = 0; idx < me->mapSize; ++idx)\
+    {\
+        sum += me->keyList[idx] + (size_t)me->valueList[idx];\
+    }\
+    return sum;\
+}\
+\
+static size_t TYPENAME##_benchSize(void* container)\
+{\
+    return TYPENAME##_size((TYPENAME*)container);\
+}
+
+/*benchContainer of a map type defined by BENCH_STATIC_MAP_DEFINITIONS*/
+#define BENCH_STATIC_MAP_CONTAINER(TYPENAME, VALUE_TYPE, MAP_ALLOC)\
+    {"cStaticMap", sizeof(VALUE_TYPE), (MAP_ALLOC) / 16 + 1, (MAP_ALLOC) / 2, (BENCH_OP_INSERT | BENCH_OP_FIND | BENCH_OP_ERASE),\
+     TYPENAME##_benchCreate, TYPENAME##_benchDestroy, TYPENAME##_benchFill, TYPENAME##_benchInsert,\
+     TYPENAME##_benchFind, TYPENAME##_benchErase, TYPENAME##_benchIterate, TYPENAME##_benchSize}
+/*---------------------------------------------------------------------------*/
+
+
+/*cStaticHashMap*/
+/*---------------------------------------------------------------------------*/
+/*Defines a hash map type of size_t keys and VALUE_TYPE values with MAP_ALLOC slots and its
+  benchmark functions. The driver fills it up to half of the slots.*/
+#define BENCH_STATIC_HASH_MAP_DEFINITIONS(TYPENAME, VALUE_TYPE, MAP_ALLOC)\
+\
+typedef cStaticHashMap(size_t, VALUE_TYPE, MAP_ALLOC) TYPENAME;\
+\
+cStaticHashMap_METHOD_DECLARATIONS(TYPENAME, size_t, VALUE_TYPE)\
+\
+cStaticHashMap_METHOD_DEFINITIONS(TYPENAME, size_t, VALUE_TYPE)\
+\
+static void* TYPENAME##_benchCreate(size_t elemSize)\
+{\
+    TYPENAME* me = (TYPENAME*)bench_allocStruct(sizeof(TYPENAME));\
+    (void)elemSize;\
+    if(NULL != me)\
+    {\
+        TYPENAME##_clear(me);\
+    }\
+    return (void*)me;\
+}\
+\
+static void TYPENAME##_benchDestroy(void* container)\
+{\
+    bench_freeStruct(container, sizeof(TYPENAME));\
+}\
+\
+static void TYPENAME##_benchFill(void* container, size_t count)\
+{\
+    TYPENAME* me = (TYPENAME*)container;\
+    size_t idx;\
+    for(idx = 0; idx < count; ++idx)\
+    {\
+        const size_t key = 2 * idx;\
+        const VALUE_TYPE value = (VALUE_TYPE)key;\
+        (void)TYPENAME##_insert(me, &key, &value);\
+    }\
+}\
+\
+static int TYPENAME##_benchInsert(void* container, size_t draw)\
+{\
+    const size_t key = (2 * draw) + 1;\
+    const VALUE_TYPE value = (VALUE_TYPE)key;\
+    return TYPENAME##_insert((TYPENAME*)container, &key, &value);\
+}\
+\
+static int TYPENAME##_benchFind(void* container, size_t draw)\
+{\
+    const size_t key = 2 * draw;\
+    return (0 == TYPENAME##_find((TYPENAME*)container, &key, NULL)) ? 1 : 0;\
+}\
+\
+static int TYPENAME##_benchErase(void* container, size_t draw)\
+{\
+    const size_t key = 2 * draw;\
+    return TYPENAME##_erase((TYPENAME*)container, &key);\
+}\
+\
+static size_t TYPENAME##_benchIterate(void* container)\
+{\
+    const TYPENAME* me = (const TYPENAME*)container;\
+    size_t sum = 0;\
+    size_t slot;\
+    for(slot = 0; slot < (MAP_ALLOC); ++slot)\
+    {\
+        if(0 != TYPENAME##_isUsed(me, slot))\
+        {\
+            sum += me->keyList[slot] + (size_t)me->valueList[slot];\
+        }\
+    }\
+    return sum;\
+}\
+\
+static size_t TYPENAME##_benchSize(void* container)\
+{\
+    return TYPENAME##_size((TYPENAME*)container);\
+}
+
+/*benchContainer of a hash map type defined by BENCH_STATIC_HASH_MAP_DEFINITIONS*/
+#define BENCH_STATIC_HASH_MAP_CONTAINER(TYPENAME, VALUE_TYPE, MAP_ALLOC)\
+    {"cStaticHashMap", sizeof(VALUE_TYPE), (MAP_ALLOC) / 16 + 1, (MAP_ALLOC) / 2, 0U,\
+     TYPENAME##_benchCreate, TYPENAME##_benchDestroy, TYPENAME##_benchFill, TYPENAME##_benchInsert,\
+     TYPENAME##_benchFind, TYPENAME##_benchErase, TYPENAME##_benchIterate, TYPENAME##_benchSize}
+/*---------------------------------------------------------------------------*/
+
+
+/*cStaticSortedMap*/
+/*---------------------------------------------------------------------------*/
+/*Defines a sorted map type of size_t keys and VALUE_TYPE values holding MAP_ALLOC pairs and
+  its benchmark functions*/
+#define BENCH_STATIC_SORTED_MAP_DEFINITIONS(TYPENAME, VALUE_TYPE, MAP_ALLOC)\
+\
+typedef cStaticSortedMap(size_t, VALUE_TYPE, MAP_ALLOC) TYPENAME;\
+\
+cStaticSortedMap_METHOD_DECLARATIONS(TYPENAME, size_t, VALUE_TYPE)\
+\
+cStaticSortedMap_METHOD_DEFINITIONS(TYPENAME, size_t, VALUE_TYPE)\
+\
+static void* TYPENAME##_benchCreate(size_t elemSize)\
+{\
+    TYPENAME* me = (TYPENAME*)bench_allocStruct(sizeof(TYPENAME));\
+    (void)elemSize;\
+    if(NULL != me)\
+    {\
+        TYPENAME##_clear(me);\
+    }\
+    return (void*)me;\
+}\
+\
+static void TYPENAME##_benchDestroy(void* container)\
+{\
+    bench_freeStruct(container, sizeof(TYPENAME));\
+}\
+\
+static void TYPENAME##_benchFill(void* container, size_t count)\
+{\
+    TYPENAME* me = (TYPENAME*)container;\
+    size_t idx;\
+    /*The keys are written in order, as a const table would be initialized*/\
+    for(idx = 0; idx < count; ++idx)\
+    {\
+        me->keyList[idx]   = 2 * idx;\
+        me->valueList[idx] = (VALUE_TYPE)(2 * idx);\
+    }\
+    me->mapSize = count;\
+}\
+\
+static int TYPENAME##_benchInsert(void* container, size_t draw)\
+{\
+    const size_t key = (2 * draw) + 1;\
+    const VALUE_TYPE value = (VALUE_TYPE)key;\
+    return TYPENAME##_insert((TYPENAME*)container, &key, &value);\
+}\
+\
+static int TYPENAME##_benchFind(void* container, size_t draw)\
+{\
+    const size_t key = 2 * draw;\
+    return (0 == TYPENAME##_find((TYPENAME*)container, &key, NULL)) ? 1 : 0;\
+}\
+\
+static int TYPENAME##_benchErase(void* container, size_t draw)\
+{\
+    const size_t key = 2 * draw;\
+    return TYPENAME##_erase((TYPENAME*)container, &key);\
+}\
+\
+static size_t TYPENAME##_benchIterate(void* container)\
+{\
+    const TYPENAME* me = (const TYPENAME*)container;\
+    size_t sum = 0;\
+    size_t idx;\
+    for(idx = 0; idx < me->mapSize; ++idx)\
+    {\
+        sum += me->keyList[idx] + (size_t)me->valueList[idx];\
+    }\
+    return sum;\
+}\
+\
+static size_t TYPENAME##_benchSize(void* container)\
+{\
+    return TYPENAME##_size((TYPENAME*)container);\
+}
+
+/*benchContainer of a map type defined by BENCH_STATIC_SORTED_MAP_DEFINITIONS*/
+#define BENCH_STATIC_SORTED_MAP_CONTAINER(TYPENAME, VALUE_TYPE, MAP_ALLOC)\
+    {"cStaticSortedMap", sizeof(VALUE_TYPE), (MAP_ALLOC) / 16 + 1, (MAP_ALLOC) / 2, (BENCH_OP_INSERT | BENCH_OP_ERASE),\
+     TYPENAME##_benchCreate, TYPENAME##_benchDestroy, TYPENAME##_benchFill, TYPENAME##_benchInsert,\
+     TYPENAME##_benchFind, TYPENAME##_benchErase, TYPENAME##_benchIterate, TYPENAME##_benchSize}
+/*---------------------------------------------------------------------------*/
+
+
+/*Applies MACRO to the capacities of the static containers, twice the prepared sizes of the
+  driver up to BENCH_STATIC_MAX_SIZE*/
+#define BENCH_STATIC_CAPACITIES(MACRO, TYPENAME, VALUE_TYPE)\
+    MACRO(TYPENAME##16, VALUE_TYPE, 16)\
+    MACRO(TYPENAME##128, VALUE_TYPE, 128)\
+    MACRO(TYPENAME##1024, VALUE_TYPE, 1024)\
+    MACRO(TYPENAME##8192, VALUE_TYPE, (2 * BENCH_STATIC_MAX_SIZE))
+
+#define BENCH_STATIC_CONTAINERS(MACRO, TYPENAME, VALUE_TYPE)\
+    MACRO(TYPENAME##16, VALUE_TYPE, 16),\
+    MACRO(TYPENAME##128, VALUE_TYPE, 128),\
+    MACRO(TYPENAME##1024, VALUE_TYPE, 1024),\
+    MACRO(TYPENAME##8192, VALUE_TYPE, (2 * BENCH_STATIC_MAX_SIZE))
+
+BENCH_STATIC_CAPACITIES(BENCH_STATIC_ARRAY_DEFINITIONS, benchArray8_, uint8_t)
+BENCH_STATIC_CAPACITIES(BENCH_STATIC_ARRAY_DEFINITIONS, benchArray16_, uint16_t)
+BENCH_STATIC_CAPACITIES(BENCH_STATIC_ARRAY_DEFINITIONS, benchArray32_, uint32_t)
+BENCH_STATIC_CAPACITIES(BENCH_STATIC_ARRAY_DEFINITIONS, benchArray64_, uint64_t)
+
+BENCH_STATIC_CAPACITIES(BENCH_STATIC_MAP_DEFINITIONS, benchMap8_, uint8_t)
+BENCH_STATIC_CAPACITIES(BENCH_STATIC_MAP_DEFINITIONS, benchMap16_, uint16_t)
+BENCH_STATIC_CAPACITIES(BENCH_STATIC_MAP_DEFINITIONS, benchMap32_, uint32_t)
+BENCH_STATIC_CAPACITIES(BENCH_STATIC_MAP_DEFINITIONS, benchMap64_, uint64_t)
+
+BENCH_STATIC_CAPACITIES(BENCH_STATIC_HASH_MAP_DEFINITIONS, benchHashMap8_, uint8_t)
+BENCH_STATIC_CAPACITIES(BENCH_STATIC_HASH_MAP_DEFINITIONS, benchHashMap16_, uint16_t)
+BENCH_STATIC_CAPACITIES(BENCH_STATIC_HASH_MAP_DEFINITIONS, benchHashMap32_, uint32_t)
+BENCH_STATIC_CAPACITIES(BENCH_STATIC_HASH_MAP_DEFINITIONS, benchHashMap64_, uint64_t)
+
+BENCH_STATIC_CAPACITIES(BENCH_STATIC_SORTED_MAP_DEFINITIONS, benchSortedMap8_, uint8_t)
+BENCH_STATIC_CAPACITIES(BENCH_STATIC_SORTED_MAP_DEFINITIONS, benchSortedMap16_, uint16_t)
+BENCH_STATIC_CAPACITIES(BENCH_STATIC_SORTED_MAP_DEFINITIONS, benchSortedMap32_, uint32_t)
+BENCH_STATIC_CAPACITIES(BENCH_STATIC_SORTED_MAP_DEFINITIONS, benchSortedMap64_, uint64_t)
+
+static const benchContainer benchContainerList[] = {
+    {"cVector", 0, 0, 0, (BENCH_OP_FIND | BENCH_OP_ERASE),
+     benchVector_create, benchVector_destroy, benchVector_fill, benchVector_insert,
+     benchVector_find, benchVector_erase, benchVector_iterate, benchVector_size},
+    {"cMap", 0, 0, 0, (BENCH_OP_INSERT | BENCH_OP_FIND | BENCH_OP_ERASE),
+     benchMap_create, benchMap_destroy, benchMap_fill, benchMap_insert,
+     benchMap_find, benchMap_erase, benchMap_iterate, benchMap_size},
+    {"cMap_hashed", 0, 0, 0, 0U,
+     benchHashMap_create, benchMap_destroy, benchMap_fill, benchMap_insert,
+     benchMap_find, benchMap_erase, benchMap_iterate, benchMap_size},
+    {"cMap_sorted", 0, 0, 0, (BENCH_OP_INSERT | BENCH_OP_ERASE),
+     benchSortedMap_create, benchMap_destroy, benchMap_fill, benchMap_insert,
+     benchMap_find, benchMap_erase, benchMap_iterate, benchMap_size},
+    BENCH_STATIC_CONTAINERS(BENCH_STATIC_ARRAY_CONTAINER, benchArray8_, uint8_t),
+    BENCH_STATIC_CONTAINERS(BENCH_STATIC_ARRAY_CONTAINER, benchArray16_, uint16_t),
+    BENCH_STATIC_CONTAINERS(BENCH_STATIC_ARRAY_CONTAINER, benchArray32_, uint32_t),
+    BENCH_STATIC_CONTAINERS(BENCH_STATIC_ARRAY_CONTAINER, benchArray64_, uint64_t),
+    BENCH_STATIC_CONTAINERS(BENCH_STATIC_MAP_CONTAINER, benchMap8_, uint8_t),
+    BENCH_STATIC_CONTAINERS(BENCH_STATIC_MAP_CONTAINER, benchMap16_, uint16_t),
+    BENCH_STATIC_CONTAINERS(BENCH_STATIC_MAP_CONTAINER, benchMap32_, uint32_t),
+    BENCH_STATIC_CONTAINERS(BENCH_STATIC_MAP_CONTAINER, benchMap64_, uint64_t),
+    BENCH_STATIC_CONTAINERS(BENCH_STATIC_HASH_MAP_CONTAINER, benchHashMap8_, uint8_t),
+    BENCH_STATIC_CONTAINERS(BENCH_STATIC_HASH_MAP_CONTAINER, benchHashMap16_, uint16_t),
+    BENCH_STATIC_CONTAINERS(BENCH_STATIC_HASH_MAP_CONTAINER, benchHashMap32_, uint32_t),
+    BENCH_STATIC_CONTAINERS(BENCH_STATIC_HASH_MAP_CONTAINER, benchHashMap64_, uint64_t),
+    BENCH_STATIC_CONTAINERS(BENCH_STATIC_SORTED_MAP_CONTAINER, benchSortedMap8_, uint8_t),
+    BENCH_STATIC_CONTAINERS(BENCH_STATIC_SORTED_MAP_CONTAINER, benchSortedMap16_, uint16_t),
+    BENCH_STATIC_CONTAINERS(BENCH_STATIC_SORTED_MAP_CONTAINER, benchSortedMap32_, uint32_t),
+    BENCH_STATIC_CONTAINERS(BENCH_STATIC_SORTED_MAP_CONTAINER, benchSortedMap64_, uint64_t)
+};
+
+int main(int argc, char** argv)
+{
+    benchOptions options;
+    int result = EXIT_FAILURE;
+
+    if(0 == benchOptions_parse(&options, argc, argv))
+    {
+        if(0 == bench_run("ccontainers", benchContainerList, sizeof(benchContainerList) / sizeof(benchContainerList[0]), &options))
+        {
+            result = EXIT_SUCCESS;
+        }
+    }
+
+    return result;
+}
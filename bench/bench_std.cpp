@@ -0,0 +1,306 @@
+/*
+ Operation benchmark of the C++ standard containers
+
+ Measures std::vector and std::unordered_map with the same driver and operations as
+ bench_containers, so that their reports can be compared:
+
+ - std::vector        : insert appends, find searches an element, erase removes a position.
+ - std::unordered_map : keys are size_t, values are of the element size.
+
+ The containers allocate through a counting allocator, so that allocs/op and the peak heap
+ usage are measured as for cVector and cMap.
+
+ Usage:
+   bench_std [--max-size N] [--max-bytes N] [--elem-size N] [--container NAME] [--output PATH]
+ ------------------------------------------------------------------------------------------------*/
+
+#include <cstdlib>
+#include <cstring>
+#include <new>
+#include <vector>
+#include <unordered_map>
+#include <algorithm>
+#include <functional>
+#include "benchcommon.h"
+
+namespace {
+
+/*Element of ELEM_SIZE bytes compared bytewise, as the C containers do*/
+template<size_t ELEM_SIZE>
+struct benchElem {
+    unsigned char bytes[ELEM_SIZE];
+
+    bool operator==(const benchElem& other) const
+    {
+        return 0 == std::memcmp(bytes, other.bytes, ELEM_SIZE);
+    }
+};
+
+/*Allocator recording the allocations of the containers with bench_recordAlloc*/
+template<typename T>
+struct benchAllocator {
+    typedef T value_type;
+
+    benchAllocator() {}
+
+    template<typename U>
+    benchAllocator(const benchAllocator<U>&) {}
+
+    T* allocate(size_t count)
+    {
+        void* ptr = std::malloc(count * sizeof(T));
+
+        if(NULL == ptr)
+        {
+            throw std::bad_alloc();
+        }
+        bench_recordAlloc(count * sizeof(T));
+
+        return static_cast<T*>(ptr);
+    }
+
+    void deallocate(T* ptr, size_t count)
+    {
+        bench_recordFree(count * sizeof(T));
+        std::free(ptr);
+    }
+
+    template<typename U>
+    bool operator==(const benchAllocator<U>&) const { return true; }
+
+    template<typename U>
+    bool operator!=(const benchAllocator<U>&) const { return false; }
+};
+
+/*Allocates the object of a container, recorded in the heap usage. The exceptions of the
+  standard containers are not let through the C driver.*/
+template<typename T>
+void* benchCreate()
+{
+    T* container = NULL;
+
+    try
+    {
+        container = new T();
+        bench_recordAlloc(sizeof(T));
+    }
+    catch(const std::bad_alloc&)
+    {
+        container = NULL;
+    }
+
+    return container;
+}
+
+template<typename T>
+void benchDestroy(void* container)
+{
+    bench_recordFree(sizeof(T));
+    delete static_cast<T*>(container);
+}
+
+
+/*std::vector*/
+/*---------------------------------------------------------------------------*/
+template<size_t ELEM_SIZE>
+struct benchVector {
+    typedef benchElem<ELEM_SIZE> elem_type;
+    typedef std::vector<elem_type, benchAllocator<elem_type> > container_type;
+
+    static elem_type makeElem(size_t key)
+    {
+        elem_type elem;
+        bench_makeElem(elem.bytes, ELEM_SIZE, key);
+        return elem;
+    }
+
+    static void* create(size_t)
+    {
+        return benchCreate<container_type>();
+    }
+
+    static void destroy(void* container)
+    {
+        benchDestroy<container_type>(container);
+    }
+
+    static void fill(void* container, size_t count)
+    {
+        container_type& vector = *static_cast<container_type*>(container);
+
+        for(size_t idx = 0; idx < count; ++idx)
+        {
+            vector.push_back(makeElem(2 * idx));
+        }
+    }
+
+    static int insert(void* container, size_t draw)
+    {
+        try
+        {
+            static_cast<container_type*>(container)->push_back(makeElem((2 * draw) + 1));
+        }
+        catch(const std::bad_alloc&)
+        {
+            return -1;
+        }
+
+        return 0;
+    }
+
+    static int find(void* container, size_t draw)
+    {
+        const container_type& vector = *static_cast<container_type*>(container);
+
+        return (std::find(vector.begin(), vector.end(), makeElem(2 * draw)) != vector.end()) ? 1 : 0;
+    }
+
+    static int erase(void* container, size_t draw)
+    {
+        container_type& vector = *static_cast<container_type*>(container);
+
+        if(vector.empty())
+        {
+            return -1;
+        }
+        vector.erase(vector.begin() + static_cast<ptrdiff_t>(draw % vector.size()));
+
+        return 0;
+    }
+
+    static size_t iterate(void* container)
+    {
+        const container_type& vector = *static_cast<container_type*>(container);
+        size_t sum = 0;
+
+        for(typename container_type::const_iterator it = vector.begin(); it != vector.end(); ++it)
+        {
+            sum += it->bytes[0];
+        }
+
+        return sum;
+    }
+
+    static size_t size(void* container)
+    {
+        return static_cast<container_type*>(container)->size();
+    }
+
+    static benchContainer container()
+    {
+        benchContainer result = {"std::vector", ELEM_SIZE, 0, 0, (BENCH_OP_FIND | BENCH_OP_ERASE),
+                                 create, destroy, fill, insert, find, erase, iterate, size};
+        return result;
+    }
+};
+/*---------------------------------------------------------------------------*/
+
+
+/*std::unordered_map*/
+/*---------------------------------------------------------------------------*/
+template<size_t ELEM_SIZE>
+struct benchUnorderedMap {
+    typedef benchElem<ELEM_SIZE> value_type;
+    typedef std::unordered_map<size_t, value_type, std::hash<size_t>, std::equal_to<size_t>,
+                               benchAllocator<std::pair<const size_t, value_type> > > container_type;
+
+    static void* create(size_t)
+    {
+        return benchCreate<container_type>();
+    }
+
+    static void destroy(void* container)
+    {
+        benchDestroy<container_type>(container);
+    }
+
+    static void fill(void* container, size_t count)
+    {
+        container_type& map = *static_cast<container_type*>(container);
+
+        for(size_t idx = 0; idx < count; ++idx)
+        {
+            bench_makeElem(map[2 * idx].bytes, ELEM_SIZE, 2 * idx);
+        }
+    }
+
+    static int insert(void* container, size_t draw)
+    {
+        const size_t key = (2 * draw) + 1;
+
+        try
+        {
+            bench_makeElem((*static_cast<container_type*>(container))[key].bytes, ELEM_SIZE, key);
+        }
+        catch(const std::bad_alloc&)
+        {
+            return -1;
+        }
+
+        return 0;
+    }
+
+    static int find(void* container, size_t draw)
+    {
+        const container_type& map = *static_cast<container_type*>(container);
+
+        return (map.find(2 * draw) != map.end()) ? 1 : 0;
+    }
+
+    static int erase(void* container, size_t draw)
+    {
+        return (0 != static_cast<container_type*>(container)->erase(2 * draw)) ? 0 : -1;
+    }
+
+    static size_t iterate(void* container)
+    {
+        const container_type& map = *static_cast<container_type*>(container);
+        size_t sum = 0;
+
+        for(typename container_type::const_iterator it = map.begin(); it != map.end(); ++it)
+        {
+            sum += it->first + it->second.bytes[0];
+        }
+
+        return sum;
+    }
+
+    static size_t size(void* container)
+    {
+        return static_cast<container_type*>(container)->size();
+    }
+
+    static benchContainer container()
+    {
+        benchContainer result = {"std::unordered_map", ELEM_SIZE, 0, 0, 0U,
+                                 create, destroy, fill, insert, find, erase, iterate, size};
+        return result;
+    }
+};
+/*---------------------------------------------------------------------------*/
+
+}
+
+int main(int argc, char** argv)
+{
+    const benchContainer containerList[] = {
+        benchVector<1>::container(), benchVector<2>::container(), benchVector<4>::container(),
+        benchVector<8>::container(), benchVector<16>::container(), benchVector<32>::container(),
+        benchVector<64>::container(), benchVector<128>::container(), benchVector<256>::container(),
+        benchUnorderedMap<1>::container(), benchUnorderedMap<2>::container(), benchUnorderedMap<4>::container(),
+        benchUnorderedMap<8>::container(), benchUnorderedMap<16>::container(), benchUnorderedMap<32>::container(),
+        benchUnorderedMap<64>::container(), benchUnorderedMap<128>::container(), benchUnorderedMap<256>::container()
+    };
+    benchOptions options;
+    int result = EXIT_FAILURE;
+
+    if(0 == benchOptions_parse(&options, argc, argv))
+    {
+        if(0 == bench_run("std", containerList, sizeof(containerList) / sizeof(containerList[0]), &options))
+        {
+            result = EXIT_SUCCESS;
+        }
+    }
+
+    return result;
+}
@@ -0,0 +1,487 @@
+/*Clocks and getrusage are hidden by the strict ANSI modes of the POSIX headers*/
+#if !defined(_XOPEN_SOURCE)
+#define _XOPEN_SOURCE 600
+#endif
+
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <time.h>
+#include <sys/time.h>
+#include <sys/resource.h>
+#include "benchcommon.h"
+
+/*Skew of the Zipfian distribution*/
+#define BENCH_ZIPF_THETA        0.99
+
+/*Odd multiplier scattering the Zipfian ranks over the key range*/
+#define BENCH_ZIPF_SCATTER      ((size_t)(2654435761UL))
+
+static const size_t benchElemSizeList[] = {1, 2, 4, 8, 16, 32, 64, 128, 256};
+static const size_t benchSizeList[] = {8, 64, 512, 4096, 32768, 262144, 1048576, 10000000};
+static const char* const benchDistNameList[BENCH_DIST_COUNT] = {"sequential", "random", "zipfian"};
+
+#define BENCH_LIST_COUNT(list)  (sizeof(list) / sizeof((list)[0]))
+
+/*Allocation statistics*/
+static size_t benchAllocCount = 0;
+static size_t benchLiveBytes  = 0;
+static size_t benchPeakBytes  = 0;
+
+/*Keeps the results of the operations alive*/
+static volatile size_t benchSink = 0;
+
+/*Cached normalization constant of the Zipfian distribution*/
+static size_t benchZetaRange = 0;
+static double benchZeta = 0.0;
+
+void bench_recordAlloc(size_t size)
+{
+    ++benchAllocCount;
+    benchLiveBytes += size;
+
+    if(benchLiveBytes > benchPeakBytes)
+    {
+        benchPeakBytes = benchLiveBytes;
+    }
+}
+
+void bench_recordFree(size_t size)
+{
+    benchLiveBytes -= size;
+}
+
+static void* bench_countingAlloc(void* context, size_t size)
+{
+    void* ptr = malloc(size);
+    (void)context;
+
+    if(NULL != ptr)
+    {
+        bench_recordAlloc(size);
+    }
+
+    return ptr;
+}
+
+static void* bench_countingRealloc(void* context, void* ptr, size_t oldSize, size_t newSize)
+{
+    void* newPtr = realloc(ptr, newSize);
+    (void)context;
+
+    if(NULL != newPtr)
+    {
+        bench_recordFree(oldSize);
+        bench_recordAlloc(newSize);
+    }
+
+    return newPtr;
+}
+
+static void bench_countingFree(void* context, void* ptr, size_t size)
+{
+    (void)context;
+
+    if(NULL != ptr)
+    {
+        bench_recordFree(size);
+        free(ptr);
+    }
+}
+
+static const cAllocator benchCountingAllocator = {bench_countingAlloc, bench_countingRealloc, bench_countingFree, NULL};
+
+const cAllocator* bench_countingAllocator(void)
+{
+    return &benchCountingAllocator;
+}
+
+void bench_makeElem(void* elem, size_t elemSize, size_t key)
+{
+    memset(elem, (int)(key & 0xFFU), elemSize);
+    memcpy(elem, &key, (elemSize < sizeof(key)) ? elemSize : sizeof(key));
+}
+
+static double bench_now(void)
+{
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (double)now.tv_sec + ((double)now.tv_nsec * 1e-9);
+}
+
+/*Peak resident set size of the process, in kilobytes on Linux and in bytes on macOS*/
+static long bench_peakRss(void)
+{
+    struct rusage usage;
+    return (0 == getrusage(RUSAGE_SELF, &usage)) ? usage.ru_maxrss : -1L;
+}
+
+/*Small xorshift generator*/
+static unsigned long bench_nextRandom(unsigned long* pState)
+{
+    unsigned long x = *pState;
+    x ^= (x << 13) & 0xFFFFFFFFUL;
+    x ^= (x >> 17);
+    x ^= (x << 5) & 0xFFFFFFFFUL;
+    *pState = x;
+    return x;
+}
+
+/*Uniform value in [0, 1)*/
+static double bench_nextUnit(unsigned long* pState)
+{
+    return (double)bench_nextRandom(pState) / 4294967296.0;
+}
+
+/*Fills "draws" with "count" values of the distribution over [0, range). The Zipfian
+  ranks are generated as in Gray et al., "Quickly generating billion-record synthetic
+  databases", and scattered over the range, so that the hot keys are not neighbours.*/
+static void bench_draw(size_t* draws, size_t count, size_t range, benchDist dist)
+{
+    unsigned long state = 2463534242UL;
+    size_t idx;
+
+    if(BENCH_DIST_SEQUENTIAL == dist)
+    {
+        for(idx = 0; idx < count; ++idx)
+        {
+            draws[idx] = idx % range;
+        }
+    }
+    else if(BENCH_DIST_RANDOM == dist)
+    {
+        for(idx = 0; idx < count; ++idx)
+        {
+            draws[idx] = (size_t)(bench_nextUnit(&state) * (double)range);
+        }
+    }
+    else
+    {
+        double alpha = 1.0 / (1.0 - BENCH_ZIPF_THETA);
+        double zeta2 = 1.0 + pow(0.5, BENCH_ZIPF_THETA);
+        double eta;
+
+        if(range != benchZetaRange)
+        {
+            benchZeta = 0.0;
+
+            for(idx = 1; idx <= range; ++idx)
+            {
+                benchZeta += 1.0 / pow((double)idx, BENCH_ZIPF_THETA);
+            }
+            benchZetaRange = range;
+        }
+
+        eta = (1.0 - pow(2.0 / (double)range, 1.0 - BENCH_ZIPF_THETA)) / (1.0 - zeta2 / benchZeta);
+
+        for(idx = 0; idx < count; ++idx)
+        {
+            double u = bench_nextUnit(&state);
+            double uz = u * benchZeta;
+            size_t rank;
+
+            if(uz < 1.0)
+            {
+                rank = 0;
+            }
+            else if(uz < zeta2)
+            {
+                rank = 1;
+            }
+            else
+            {
+                rank = (size_t)((double)range * pow(eta * u - eta + 1.0, alpha));
+            }
+
+            draws[idx] = ((rank % range) * BENCH_ZIPF_SCATTER) % range;
+        }
+    }
+}
+
+static void bench_writeRecord(FILE* file, int* pFirst, const char* container, const char* operation,
+                              size_t elemSize, size_t size, const char* dist, size_t opCount,
+                              double seconds, size_t allocCount)
+{
+    fprintf(file, "%s\n    {\"container\": \"%s\", \"operation\": \"%s\", \"element_size\": %lu, \"size\": %lu, "
+                  "\"distribution\": \"%s\", \"ops\": %lu, \"ns_per_op\": %.3f, \"allocs_per_op\": %.6f, "
+                  "\"peak_heap_bytes\": %lu, \"peak_rss_kb\": %ld}",
+            (0 != *pFirst) ? "" : ",", container, operation, (unsigned long)elemSize, (unsigned long)size,
+            dist, (unsigned long)opCount, (seconds * 1e9) / (double)opCount, (double)allocCount / (double)opCount,
+            (unsigned long)benchPeakBytes, bench_peakRss());
+    fflush(file);
+    *pFirst = 0;
+}
+
+/*Runs "opCount" operations of the given kind on containers prepared with "size" keys.*/
+static int bench_runOperation(FILE* file, int* pFirst, const benchContainer* pContainer, size_t elemSize,
+                              size_t size, benchDist dist, unsigned int op)
+{
+    int (*opFunc)(void*, size_t) = (BENCH_OP_INSERT == op) ? pContainer->insert :
+                                   ((BENCH_OP_FIND == op) ? pContainer->find : pContainer->erase);
+    size_t opCount = BENCH_OP_COUNT;
+    size_t chunkSize;
+    size_t containerCount;
+    size_t* draws;
+    void** containers;
+    int result = -1;
+
+    if((0U != (pContainer->linearOps & op)) && ((BENCH_LINEAR_BUDGET / size) < opCount))
+    {
+        opCount = (BENCH_LINEAR_BUDGET / size > 0) ? (BENCH_LINEAR_BUDGET / size) : (size_t)(1);
+    }
+
+    /*The mutating operations are spread over containers, so that a container stays
+      between 0 and 2n elements*/
+    chunkSize = ((BENCH_OP_FIND == op) || (opCount < size)) ? opCount : size;
+    containerCount = (opCount + chunkSize - 1) / chunkSize;
+
+    benchPeakBytes = benchLiveBytes;
+
+    draws = (size_t*)malloc(opCount * sizeof(size_t));
+    containers = (void**)calloc(containerCount, sizeof(void*));
+
+    if((NULL != draws) && (NULL != containers))
+    {
+        size_t containerIdx;
+        size_t allocCount;
+        double start;
+        size_t opIdx = 0;
+        size_t sink = 0;
+
+        bench_draw(draws, opCount, size, dist);
+
+        for(containerIdx = 0; containerIdx < containerCount; ++containerIdx)
+        {
+            containers[containerIdx] = pContainer->create(elemSize);
+
+            if(NULL == containers[containerIdx])
+            {
+                break;
+            }
+            pContainer->fill(containers[containerIdx], size);
+        }
+
+        if(containerIdx == containerCount)
+        {
+            allocCount = benchAllocCount;
+            start = bench_now();
+
+            for(containerIdx = 0; containerIdx < containerCount; ++containerIdx)
+            {
+                void* container = containers[containerIdx];
+                size_t chunkEnd = (opIdx + chunkSize < opCount) ? (opIdx + chunkSize) : opCount;
+
+                for(; opIdx < chunkEnd; ++opIdx)
+                {
+                    sink += (size_t)opFunc(container, draws[opIdx]);
+                }
+            }
+
+            bench_writeRecord(file, pFirst, pContainer->name,
+                              (BENCH_OP_INSERT == op) ? "insert" : ((BENCH_OP_FIND == op) ? "find" : "erase"),
+                              elemSize, size, benchDistNameList[dist], opCount, bench_now() - start,
+                              benchAllocCount - allocCount);
+            benchSink += sink;
+            result = 0;
+        }
+
+        for(containerIdx = 0; containerIdx < containerCount; ++containerIdx)
+        {
+            if(NULL != containers[containerIdx])
+            {
+                pContainer->destroy(containers[containerIdx]);
+            }
+        }
+    }
+
+    free((void*)containers);
+    free((void*)draws);
+
+    return result;
+}
+
+/*Visits the elements of a container prepared with "size" keys, in passes of at least
+  BENCH_OP_COUNT visits in total.*/
+static int bench_runIterate(FILE* file, int* pFirst, const benchContainer* pContainer, size_t elemSize, size_t size)
+{
+    int result = -1;
+    void* container;
+
+    benchPeakBytes = benchLiveBytes;
+    container = pContainer->create(elemSize);
+
+    if(NULL != container)
+    {
+        size_t passCount = (BENCH_OP_COUNT > size) ? (BENCH_OP_COUNT / size) : (size_t)(1);
+        size_t allocCount;
+        size_t passIdx;
+        size_t sink = 0;
+        double start;
+
+        pContainer->fill(container, size);
+
+        allocCount = benchAllocCount;
+        start = bench_now();
+
+        for(passIdx = 0; passIdx < passCount; ++passIdx)
+        {
+            sink += pContainer->iterate(container);
+        }
+
+        bench_writeRecord(file, pFirst, pContainer->name, "iterate", elemSize, size,
+                          benchDistNameList[BENCH_DIST_SEQUENTIAL], passCount * pContainer->size(container),
+                          bench_now() - start, benchAllocCount - allocCount);
+        benchSink += sink;
+
+        pContainer->destroy(container);
+        result = 0;
+    }
+
+    return result;
+}
+
+int benchOptions_parse(benchOptions* pOptions, int argc, char** argv)
+{
+    int result = 0;
+    int argIdx;
+
+    pOptions->maxSize       = (size_t)(1048576);
+    pOptions->maxBytes      = (size_t)(1) << 30;
+    pOptions->elemSize      = (size_t)(0);
+    pOptions->containerName = NULL;
+    pOptions->outputPath    = NULL;
+
+    for(argIdx = 1; argIdx < argc; argIdx += 2)
+    {
+        const char* value = (argIdx + 1 < argc) ? argv[argIdx + 1] : NULL;
+
+        if(NULL == value)
+        {
+            result = -1;
+        }
+        else if(0 == strcmp(argv[argIdx], "--max-size"))
+        {
+            pOptions->maxSize = (size_t)strtoul(value, NULL, 10);
+        }
+        else if(0 == strcmp(argv[argIdx], "--max-bytes"))
+        {
+            pOptions->maxBytes = (size_t)strtoul(value, NULL, 10);
+        }
+        else if(0 == strcmp(argv[argIdx], "--elem-size"))
+        {
+            pOptions->elemSize = (size_t)strtoul(value, NULL, 10);
+        }
+        else if(0 == strcmp(argv[argIdx], "--container"))
+        {
+            pOptions->containerName = value;
+        }
+        else if(0 == strcmp(argv[argIdx], "--output"))
+        {
+            pOptions->outputPath = value;
+        }
+        else
+        {
+            result = -1;
+        }
+
+        if(0 != result)
+        {
+            fprintf(stderr, "usage: %s [--max-size N] [--max-bytes N] [--elem-size N] [--container NAME] [--output PATH]\n", argv[0]);
+            break;
+        }
+    }
+
+    return result;
+}
+
+int bench_run(const char* suite, const benchContainer* containerList, size_t containerCount, const benchOptions* pOptions)
+{
+    int result = -1;
+    FILE* file = (NULL != pOptions->outputPath) ? fopen(pOptions->outputPath, "w") : stdout;
+
+    if(NULL != file)
+    {
+        int first = 1;
+        size_t containerIdx;
+
+        result = 0;
+        fprintf(file, "{\n  \"suite\": \"%s\",\n  \"results\": [", suite);
+
+        for(containerIdx = 0; containerIdx < containerCount; ++containerIdx)
+        {
+            const benchContainer* pContainer = &containerList[containerIdx];
+            size_t elemIdx;
+
+            if((NULL != pOptions->containerName) && (0 != strcmp(pOptions->containerName, pContainer->name)))
+            {
+                continue;
+            }
+
+            for(elemIdx = 0; elemIdx < BENCH_LIST_COUNT(benchElemSizeList); ++elemIdx)
+            {
+                const size_t elemSize = benchElemSizeList[elemIdx];
+                size_t sizeIdx;
+
+                if(((0 != pContainer->elemSize) && (elemSize != pContainer->elemSize)) ||
+                   ((0 != pOptions->elemSize) && (elemSize != pOptions->elemSize)))
+                {
+                    continue;
+                }
+
+                for(sizeIdx = 0; sizeIdx < BENCH_LIST_COUNT(benchSizeList); ++sizeIdx)
+                {
+                    const size_t size = benchSizeList[sizeIdx];
+                    int caseResult = 0;
+                    int dist;
+
+                    if(size < pContainer->minSize)
+                    {
+                        continue;
+                    }
+
+                    if((size > pOptions->maxSize) || ((0 != pContainer->maxSize) && (size > pContainer->maxSize)) ||
+                       ((size * (elemSize + sizeof(size_t))) > pOptions->maxBytes))
+                    {
+                        break;
+                    }
+
+                    fprintf(stderr, "%s: %s, %lu bytes, %lu elements\n", suite, pContainer->name,
+                            (unsigned long)elemSize, (unsigned long)size);
+
+                    for(dist = 0; (dist < (int)BENCH_DIST_COUNT) && (0 == caseResult); ++dist)
+                    {
+                        caseResult |= bench_runOperation(file, &first, pContainer, elemSize, size, (benchDist)dist, BENCH_OP_INSERT);
+                        caseResult |= bench_runOperation(file, &first, pContainer, elemSize, size, (benchDist)dist, BENCH_OP_FIND);
+                        caseResult |= bench_runOperation(file, &first, pContainer, elemSize, size, (benchDist)dist, BENCH_OP_ERASE);
+                    }
+
+                    if(0 == caseResult)
+                    {
+                        caseResult = bench_runIterate(file, &first, pContainer, elemSize, size);
+                    }
+
+                    /*The larger sizes of the container are skipped*/
+                    if(0 != caseResult)
+                    {
+                        fprintf(stderr, "%s: out of memory\n", pContainer->name);
+                        result = -1;
+                        break;
+                    }
+                }
+            }
+        }
+
+        fprintf(file, "\n  ]\n}\n");
+
+        if(stdout != file)
+        {
+            fclose(file);
+        }
+    }
+    else
+    {
+        fprintf(stderr, "cannot open %s\n", pOptions->outputPath);
+    }
+
+    return result;
+}
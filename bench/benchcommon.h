@@ -0,0 +1,131 @@
+/*
+ Common driver of the container benchmarks
+
+ A container under test is described by a benchContainer table of functions. The driver
+ prepares each container with n keys, and measures the operations on it over the element
+ sizes, container sizes and key distributions:
+
+ - insert   : q keys not in the container are added
+ - find     : q keys of the container are searched
+ - erase    : q keys are erased (arrays erase the positions drawn)
+ - iterate  : all of the elements are visited
+
+ The keys are drawn before the timing from the sequential, uniform random or Zipfian
+ (theta = 0.99) distributions over [0, n). The prepared container holds the even keys
+ (2 * i), so that the odd ones can be inserted. The mutating operations are repeated on
+ fresh containers for the small sizes, so that a container stays between 0 and 2n elements.
+
+ Each measurement is written to a JSON report with ns/op, allocations/op (the allocation and
+ reallocation calls made in the timed loop), the peak heap usage of the case and the peak
+ resident set size of the process.
+
+ NOTE: It relies on POSIX clocks and getrusage.
+ ------------------------------------------------------------------------------------------------*/
+
+
+#ifndef BENCHCOMMON_H
+#define BENCHCOMMON_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stddef.h>
+#include <stdio.h>
+#include "callocator.h"
+
+/*Operation bits of benchContainer.linearOps*/
+#define BENCH_OP_INSERT         0x01U
+#define BENCH_OP_FIND           0x02U
+#define BENCH_OP_ERASE          0x04U
+
+/*Number of the timed operations of a case*/
+#ifndef BENCH_OP_COUNT
+#define BENCH_OP_COUNT          ((size_t)(100000))
+#endif
+
+/*Number of the element visits a case of an O(n) operation may take, which limits its
+  operation count for the large containers*/
+#ifndef BENCH_LINEAR_BUDGET
+#define BENCH_LINEAR_BUDGET     ((size_t)(1) << 24)
+#endif
+
+/*Key distributions*/
+typedef enum {
+    BENCH_DIST_SEQUENTIAL = 0,
+    BENCH_DIST_RANDOM,
+    BENCH_DIST_ZIPFIAN,
+    BENCH_DIST_COUNT
+} benchDist;
+
+/*Container under test. "draw" is a value of the distribution over [0, n); maps use
+  the key 2 * draw for find and erase and 2 * draw + 1 for insert, arrays use the element
+  of the same key for find and insert and the position (draw % size) for erase.*/
+typedef struct {
+    /*name of the container in the report*/
+    const char* name;
+    /*the only element size supported, 0 for any*/
+    size_t elemSize;
+    /*minimum size of the prepared container*/
+    size_t minSize;
+    /*maximum size of the prepared container, 0 for unlimited*/
+    size_t maxSize;
+    /*BENCH_OP_XXX bits of the operations costing O(n)*/
+    unsigned int linearOps;
+    /*creates an empty container, NULL on failure*/
+    void*  (*create)(size_t elemSize);
+    /*releases the container*/
+    void   (*destroy)(void* container);
+    /*adds the keys 0, 2, ..., 2 * (count - 1) in order*/
+    void   (*fill)(void* container, size_t count);
+    int    (*insert)(void* container, size_t draw);
+    int    (*find)(void* container, size_t draw);
+    int    (*erase)(void* container, size_t draw);
+    /*visits all of the elements and returns a checksum of them*/
+    size_t (*iterate)(void* container);
+    /*number of the elements*/
+    size_t (*size)(void* container);
+} benchContainer;
+
+/*Command line options*/
+typedef struct {
+    /*maximum size of the prepared containers*/
+    size_t maxSize;
+    /*maximum size of the prepared containers in bytes*/
+    size_t maxBytes;
+    /*the only element size measured, 0 for all*/
+    size_t elemSize;
+    /*the only container measured, NULL for all*/
+    const char* containerName;
+    /*path of the report, NULL for stdout*/
+    const char* outputPath;
+} benchOptions;
+
+/* Parses the command line:
+   [--max-size N] [--max-bytes N] [--elem-size N] [--container NAME] [--output PATH]
+	\return : 0 = Success, -1 = Failure (usage is printed)*/
+int     benchOptions_parse(benchOptions* pOptions, int argc, char** argv);
+
+/* Fills an element of elemSize bytes from the given key.*/
+void    bench_makeElem(void* elem, size_t elemSize, size_t key);
+
+/* Records an allocation or a release of "size" bytes, for the allocation statistics.
+   Allocations done by the counting allocator are recorded by itself.*/
+void    bench_recordAlloc(size_t size);
+void    bench_recordFree(size_t size);
+
+/* Returns the allocator counting the allocations of the containers.*/
+const cAllocator* bench_countingAllocator(void);
+
+/* Runs all of the cases of the given containers and writes the report.
+	\param suite          : name of the suite in the report
+	\param containerList  : containers under test
+	\param containerCount : number of the containers
+	\return               : 0 = Success, -1 = Failure*/
+int     bench_run(const char* suite, const benchContainer* containerList, size_t containerCount, const benchOptions* pOptions);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
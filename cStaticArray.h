@@ -6,7 +6,7 @@
  All of the methods function same as cVector, differing in that they must be defined for
  every derived types, like a C++ template class.
  
- There are 3 macro definitions included in this header file:
+ There are 3 main macro definitions included in this header file:
  
  - #define cStaticArray(VALUE_TYPE, ARRAY_ALLOC)  :
    This is used to derive an array type with a 'typedef' statement.
@@ -19,6 +19,10 @@
    This is used to implement cStaticArray method definitions for derived map type. It should be
    stated in a source file.
    
+ If VALUE_TYPE is a plain integer type, cStaticArray_INTEGER_METHOD_DEFINITIONS can be used
+ instead of cStaticArray_METHOD_DEFINITIONS. Its find method compares the values with the
+ vectorized kernel of cfind.h, which should then be compiled with the project.
+   
  As an example, suppose we'd like to derive a class named 'IDArrayType'. For it, we'll create
  one header (IDArrayType.h) and one source (IDArrayType.c) file.
  
@@ -56,6 +60,7 @@
  
  Change Log:
  22.03.2019 first release
+ 16.10.2026 vectorized find for integer value types
  ------------------------------------------------------------------------------------------------*/
 
 
@@ -67,6 +72,7 @@ extern "C" {
 #endif
 
 #include <stddef.h>
+#include "cfind.h"
 
 /*This is the type definition macro of a template cStaticArray type*/
 #define cStaticArray(VALUE_TYPE, ARRAY_ALLOC)\
@@ -114,6 +120,7 @@ int TYPENAME_eraseAt(TYPENAME* me, const size_t idx) */
 int TYPENAME_erase(TYPENAME* me, const VALUE_TYPE* elem) */
 
 /* Adds new element to the start of the array.
+   NOTE: it shifts the whole array. Use cStaticDeque for queues.
 	\param me : cStaticArray instance pointer
 	\param newElem	: element to be added.
 	\retVal 		: result: 0 = Success, -1 = Failure
@@ -168,16 +175,6 @@ __VA_ARGS__ int TYPENAME##_popb(TYPENAME* const me);
 
 #define cStaticArray_METHOD_DEFINITIONS(TYPENAME, VALUE_TYPE, ...)\
 \
-__VA_ARGS__ size_t TYPENAME##_size(const TYPENAME* me)\
-{\
-    return me->arraySize;\
-}\
-\
-__VA_ARGS__ void TYPENAME##_clear(TYPENAME* const me)\
-{\
-    me->arraySize = 0;\
-}\
-\
 __VA_ARGS__ size_t TYPENAME##_find(const TYPENAME* const me, const VALUE_TYPE* const elem)\
 {\
     size_t retVal = 0;\
@@ -191,6 +188,40 @@ __VA_ARGS__ size_t TYPENAME##_find(const TYPENAME* const me, const VALUE_TYPE* c
     return retVal;\
 }\
 \
+cStaticArray_COMMON_METHOD_DEFINITIONS(TYPENAME, VALUE_TYPE, __VA_ARGS__)
+
+
+/*This macro is used to make function definitions 
+ *of a concrete cStaticArray type whose VALUE_TYPE is a plain integer type.
+ *The values are compared bytewise by the vectorized cFind_first kernel.
+ */
+
+#define cStaticArray_INTEGER_METHOD_DEFINITIONS(TYPENAME, VALUE_TYPE, ...)\
+\
+__VA_ARGS__ size_t TYPENAME##_find(const TYPENAME* const me, const VALUE_TYPE* const elem)\
+{\
+    return cFind_first((const void*)me->valueList, me->arraySize, sizeof(VALUE_TYPE), (const void*)elem, sizeof(VALUE_TYPE));\
+}\
+\
+cStaticArray_COMMON_METHOD_DEFINITIONS(TYPENAME, VALUE_TYPE, __VA_ARGS__)
+
+
+/*This macro is used to make the function definitions other than find,
+ *shared by the definition macros above.
+ */
+
+#define cStaticArray_COMMON_METHOD_DEFINITIONS(TYPENAME, VALUE_TYPE, ...)\
+\
+__VA_ARGS__ size_t TYPENAME##_size(const TYPENAME* me)\
+{\
+    return me->arraySize;\
+}\
+\
+__VA_ARGS__ void TYPENAME##_clear(TYPENAME* const me)\
+{\
+    me->arraySize = 0;\
+}\
+\
 __VA_ARGS__ int TYPENAME##_insert(TYPENAME* const me, const VALUE_TYPE* const newElem, const size_t idx)\
 {\
     int retVal = -1;\
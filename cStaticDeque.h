@@ -0,0 +1,239 @@
+ /*
+
+ ANSI C Static Deque implementation
+
+ This is a reinterpretation of cDeque as a statically allocated template deque class.
+ Elements are kept in a circular array with a head index, so that push and pop run in O(1)
+ time at both ends, unlike TYPENAME_pushf/TYPENAME_popf of cStaticArray which shift the
+ whole array. All of the methods must be defined for every derived types, like a C++
+ template class.
+
+ There are 3 macro definitions included in this header file:
+
+ - #define cStaticDeque(VALUE_TYPE, DEQUE_ALLOC)  :
+   This is used to derive a deque type with a 'typedef' statement.
+
+ - #define cStaticDeque_METHOD_DECLARATIONS(TYPENAME, VALUE_TYPE, ...)
+   This is used to declare cStaticDeque methods for derived deque type. It can be stated in
+   a header or source file.
+
+ - #define cStaticDeque_METHOD_DEFINITIONS(TYPENAME, VALUE_TYPE, ...)
+   This is used to implement cStaticDeque method definitions for derived deque type. It should be
+   stated in a source file.
+
+ As an example, suppose we'd like to derive a class named 'JobQueueType'. For it, we'll create
+ one header (JobQueueType.h) and one source (JobQueueType.c) file.
+
+ JobQueueType.h :
+ ------------------------------------------------------------------------------
+
+ #ifndef JOB_QUEUE_TYPE_H
+ #define JOB_QUEUE_TYPE_H
+
+ #include <stdint.h>
+ #include "cStaticDeque.h"
+
+ #define JOB_QUEUE_VALUE_TYPE uint32_t
+ #define JOB_QUEUE_ALLOC      64
+
+ typedef cStaticDeque(JOB_QUEUE_VALUE_TYPE, JOB_QUEUE_ALLOC) JobQueueType;
+
+ cStaticDeque_METHOD_DECLARATIONS(JobQueueType, JOB_QUEUE_VALUE_TYPE)
+
+ #endif
+
+ -------------------------------------------------------------------------------
+
+
+ JobQueueType.c :
+ ------------------------------------------------------------------------------
+
+ #include "JobQueueType.h"
+
+ cStaticDeque_METHOD_DEFINITIONS(JobQueueType, JOB_QUEUE_VALUE_TYPE)
+
+ -------------------------------------------------------------------------------
+
+ NOTE: DEQUE_ALLOC need not be a power of 2, the positions are wrapped by a comparison.
+ An instance should be emptied by TYPENAME_clear before the first use.
+
+ Authors: akozan
+
+ Change Log:
+ 16.10.2026 first release
+ ------------------------------------------------------------------------------------------------*/
+
+
+#ifndef C_STATIC_DEQUE_H
+#define C_STATIC_DEQUE_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stddef.h>
+
+/*This is the type definition macro of a template cStaticDeque type*/
+#define cStaticDeque(VALUE_TYPE, DEQUE_ALLOC)\
+    struct {\
+        size_t head;\
+        size_t dequeSize;\
+        VALUE_TYPE valueList[DEQUE_ALLOC];\
+    }
+
+/* Returns the number of elements in the deque.
+	\param me : cStaticDeque instance pointer
+	\return   : number of elements
+size_t TYPENAME_size(const TYPENAME* me) */
+
+
+/* Clears the deque.
+	\param me : cStaticDeque instance pointer
+	\return   : none.
+void TYPENAME_clear(TYPENAME* me) */
+
+
+/* Returns the pointer of the element at the index "idx", counted from the front.
+	\param me : cStaticDeque instance pointer
+	\param idx 		: index value.
+	\retVal 		: pointer of the element, NULL if "idx" is out of range
+VALUE_TYPE* TYPENAME_getAt(TYPENAME* me, const size_t idx) */
+
+/* Adds new element to the start of the deque.
+	\param me : cStaticDeque instance pointer
+	\param newElem	: element to be added.
+	\retVal 		: result: 0 = Success, -1 = Failure (the deque is full)
+int TYPENAME_pushf(TYPENAME* me, const VALUE_TYPE* newElem)*/
+
+/* Clears the element at the start of the deque.
+	\param me : cStaticDeque instance pointer
+	\retVal   : result: 0 = Success, -1 = Failure
+int TYPENAME_popf(TYPENAME* me) */
+
+/* Adds new element to the end of the deque.
+	\param me : cStaticDeque instance pointer
+	\param newElem	: element to be added.
+	\retVal 		: result: 0 = Success, -1 = Failure (the deque is full)
+int TYPENAME_pushb(TYPENAME* me, const VALUE_TYPE* newElem) */
+
+/* Clears the element at the end of the deque.
+	\param me : cStaticDeque instance pointer
+	\retVal   : result: 0 = Success, -1 = Failure
+int TYPENAME_popb(TYPENAME* me) */
+
+
+/*This macro is used to make function declarations
+ *of a concrete cStaticDeque type.
+ */
+#define cStaticDeque_METHOD_DECLARATIONS(TYPENAME, VALUE_TYPE, ...)\
+\
+__VA_ARGS__ size_t TYPENAME##_size(const TYPENAME* const me);\
+\
+__VA_ARGS__ void TYPENAME##_clear(TYPENAME* const me);\
+\
+__VA_ARGS__ VALUE_TYPE* TYPENAME##_getAt(TYPENAME* const me, const size_t idx);\
+\
+__VA_ARGS__ int TYPENAME##_pushf(TYPENAME* const me, const VALUE_TYPE* const newElem);\
+\
+__VA_ARGS__ int TYPENAME##_popf(TYPENAME* const me);\
+\
+__VA_ARGS__ int TYPENAME##_pushb(TYPENAME* const me, const VALUE_TYPE* const newElem);\
+\
+__VA_ARGS__ int TYPENAME##_popb(TYPENAME* const me);
+
+
+/*This macro is used to make function definitions
+ *of a concrete cStaticDeque type.
+ */
+
+#define cStaticDeque_METHOD_DEFINITIONS(TYPENAME, VALUE_TYPE, ...)\
+\
+__VA_ARGS__ size_t TYPENAME##_size(const TYPENAME* const me)\
+{\
+    return me->dequeSize;\
+}\
+\
+__VA_ARGS__ void TYPENAME##_clear(TYPENAME* const me)\
+{\
+    me->head = 0;\
+    me->dequeSize = 0;\
+}\
+\
+__VA_ARGS__ VALUE_TYPE* TYPENAME##_getAt(TYPENAME* const me, const size_t idx)\
+{\
+    VALUE_TYPE* retVal = NULL;\
+    if(idx < me->dequeSize)\
+    {\
+        const size_t capacity = (sizeof(me->valueList)) / (sizeof(me->valueList[0]));\
+        size_t pos = me->head + idx;\
+        if(pos >= capacity)\
+        {\
+            pos -= capacity;\
+        }\
+        retVal = &(me->valueList[pos]);\
+    }\
+    return retVal;\
+}\
+\
+__VA_ARGS__ int TYPENAME##_pushf(TYPENAME* const me, const VALUE_TYPE* const newElem)\
+{\
+    int retVal = -1;\
+    const size_t capacity = (sizeof(me->valueList)) / (sizeof(me->valueList[0]));\
+    if(me->dequeSize < capacity)\
+    {\
+        me->head = (0 == me->head) ? (capacity - 1) : (me->head - 1);\
+        me->valueList[me->head] = *newElem;\
+        ++(me->dequeSize);\
+        retVal = 0;\
+    }\
+    return retVal;\
+}\
+\
+__VA_ARGS__ int TYPENAME##_popf(TYPENAME* const me)\
+{\
+    int retVal = -1;\
+    if(me->dequeSize > 0)\
+    {\
+        const size_t capacity = (sizeof(me->valueList)) / (sizeof(me->valueList[0]));\
+        me->head = ((me->head + 1) == capacity) ? 0 : (me->head + 1);\
+        --(me->dequeSize);\
+        retVal = 0;\
+    }\
+    return retVal;\
+}\
+\
+__VA_ARGS__ int TYPENAME##_pushb(TYPENAME* const me, const VALUE_TYPE* const newElem)\
+{\
+    int retVal = -1;\
+    const size_t capacity = (sizeof(me->valueList)) / (sizeof(me->valueList[0]));\
+    if(me->dequeSize < capacity)\
+    {\
+        size_t pos = me->head + me->dequeSize;\
+        if(pos >= capacity)\
+        {\
+            pos -= capacity;\
+        }\
+        me->valueList[pos] = *newElem;\
+        ++(me->dequeSize);\
+        retVal = 0;\
+    }\
+    return retVal;\
+}\
+\
+__VA_ARGS__ int TYPENAME##_popb(TYPENAME* const me)\
+{\
+    int retVal = -1;\
+    if(me->dequeSize > 0)\
+    {\
+        --(me->dequeSize);\
+        retVal = 0;\
+    }\
+    return retVal;\
+}
+
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,292 @@
+/*
+
+ ANSI C Static Hash map implementation
+
+ This is a hashed reinterpretation of cStaticMap as a statically allocated template map class.
+ The pairs are kept in a fixed power of 2 number of slots with open addressing (linear
+ probing), so that find, insert and erase run in O(1) expected time instead of scanning the
+ whole keyList, still without any heap use. The occupied slots are marked in a bitmap, and
+ erase shifts the following pairs of the probe sequence backwards instead of leaving
+ tombstones, so that the lookups never slow down after many erasures.
+ All of the methods must be defined for every derived types, like a C++ template class.
+
+ There are 3 main macro definitions included in this header file:
+
+ - #define cStaticHashMap(KEY_TYPE, VALUE_TYPE, MAP_ALLOC)  :
+   This is used to derive a map type with a 'typedef' statement. MAP_ALLOC is the number of
+   the slots and must be a power of 2, which is checked at compile time.
+
+ - #define cStaticHashMap_METHOD_DECLARATIONS(TYPENAME, KEY_TYPE, VALUE_TYPE, ...)
+   This is used to declare cStaticHashMap methods for derived map type. It can be stated in
+   a header or source file.
+
+ - #define cStaticHashMap_METHOD_DEFINITIONS(TYPENAME, KEY_TYPE, VALUE_TYPE, ...)
+   This is used to implement cStaticHashMap method definitions for derived map type whose
+   KEY_TYPE is a plain integer type, mixing the bits of the keys into their hash. It should be
+   stated in a source file.
+
+ If KEY_TYPE is not a plain integer type, or its values are known well enough to hash them
+ better, cStaticHashMap_HASH_METHOD_DEFINITIONS(TYPENAME, KEY_TYPE, VALUE_TYPE, HASH, ...) can
+ be used instead. HASH is a function or a function-like macro taking a KEY_TYPE value and
+ returning a size_t. The keys are compared by "==" in both cases, like cStaticMap.
+
+ As an example, suppose we'd like to derive a class named 'IDMapType'. For it, we'll create
+ one header (IDMapType.h) and one source (IDMapType.c) file.
+
+ IDMapType.h :
+ ------------------------------------------------------------------------------
+
+ #ifndef ID_MAP_TYPE_H
+ #define ID_MAP_TYPE_H
+
+ #include <stdint.h>
+ #include "cStaticHashMap.h"
+
+ #define ID_MAP_KEY_TYPE   uint16_t
+ #define ID_MAP_VALUE_TYPE uint32_t
+ #define ID_MAP_ALLOC      4096
+
+ typedef cStaticHashMap(ID_MAP_KEY_TYPE, ID_MAP_VALUE_TYPE, ID_MAP_ALLOC) IDMapType;
+
+ cStaticHashMap_METHOD_DECLARATIONS(IDMapType, ID_MAP_KEY_TYPE, ID_MAP_VALUE_TYPE)
+
+ #endif
+
+ -------------------------------------------------------------------------------
+
+
+ IDMapType.c :
+ ------------------------------------------------------------------------------
+
+ #include "IDMapType.h"
+
+ cStaticHashMap_METHOD_DEFINITIONS(IDMapType, ID_MAP_KEY_TYPE, ID_MAP_VALUE_TYPE)
+
+ -------------------------------------------------------------------------------
+
+ NOTE: The map can be filled up to all of its slots, but the probe sequences grow long above
+ 3/4 load, so MAP_ALLOC should be at least 4/3 of the number of the pairs held. The index
+ given by find is a slot index, which is valid until the next insertion or erasure. The slots
+ are not ordered, the pairs are visited by TYPENAME_isUsed over all of the slots.
+ An instance should be emptied by TYPENAME_clear before the first use.
+
+ Authors: akozan
+
+ Change Log:
+ 16.10.2026 first release
+ ------------------------------------------------------------------------------------------------*/
+
+
+#ifndef C_STATIC_HASH_MAP_H
+#define C_STATIC_HASH_MAP_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stddef.h>
+#include <string.h>
+#include <limits.h>
+
+/*This is the type definition macro of a template cStaticHashMap type*/
+#define cStaticHashMap(KEY_TYPE, VALUE_TYPE, MAP_ALLOC) \
+    struct {\
+        size_t mapSize;\
+        unsigned char usedBits[((MAP_ALLOC) + CHAR_BIT - 1) / CHAR_BIT];\
+        KEY_TYPE keyList[MAP_ALLOC];\
+        VALUE_TYPE valueList[MAP_ALLOC];\
+        char allocIsPowerOf2[(0 != ((MAP_ALLOC) & ((MAP_ALLOC) - 1))) ? -1 : 1];\
+    }
+
+/*Number of the slots of a map*/
+#define cStaticHashMap_SLOT_COUNT(me)       ((sizeof((me)->keyList)) / (sizeof((me)->keyList[0])))
+
+/*Tells whether the slot is occupied, and marks it as occupied or empty*/
+#define cStaticHashMap_IS_USED(me, slot)    (0 != ((me)->usedBits[(slot) / CHAR_BIT] & (1U << ((slot) % CHAR_BIT))))
+#define cStaticHashMap_SET_USED(me, slot)   ((me)->usedBits[(slot) / CHAR_BIT] |= (unsigned char)(1U << ((slot) % CHAR_BIT)))
+#define cStaticHashMap_SET_FREE(me, slot)   ((me)->usedBits[(slot) / CHAR_BIT] &= (unsigned char)~(1U << ((slot) % CHAR_BIT)))
+
+/* Returns the number of elements in the map.
+	\param me : cStaticHashMap instance pointer
+	\return   : number of elements
+size_t TYPENAME##_size(const TYPENAME* const me) */
+
+/* Clears the map.
+	\param me : cStaticHashMap instance pointer
+	\return   : none.
+void   TYPENAME##_clear(TYPENAME* const me) */
+
+/* Returns the slot index containing given key.
+	\param me               : cStaticHashMap instance pointer
+	\param key              : key value
+    \param size_t valIdx    : index of the slot the value resides
+    \result         : return value of function.
+                  result: 0 = Success, -1 = Failure
+int    TYPENAME##_find(const TYPENAME* const me, const KEY_TYPE* const key, size_t* const valIdx) */
+
+/* Adds new pair to the map, or overwrites the value of an existing key.
+	\param me : cStaticHashMap instance pointer
+	\param key: key to be added.
+    \param value: value to be added.
+	\result 		: result: 0 = Success, -1 = Failure (all of the slots are occupied)
+int	   TYPENAME##_insert(TYPENAME* const me, const KEY_TYPE* const key, const VALUE_TYPE* const value) */
+
+/* Deletes the pair containing given key.
+	\param me : cStaticHashMap instance pointer
+	\param key : key value
+	\result 		: result: 0 = Success, -1 = Failure
+int   TYPENAME##_erase(TYPENAME* const me, const KEY_TYPE* const key) */
+
+/* Tells whether a slot holds a pair, to visit all of the pairs.
+	\param me   : cStaticHashMap instance pointer
+	\param slot : slot index, less than MAP_ALLOC
+	\result     : 1 if the slot holds a pair, 0 otherwise
+int   TYPENAME##_isUsed(const TYPENAME* const me, const size_t slot) */
+
+
+/*This macro is used to make function declarations
+ *of a concrete cStaticHashMap type.
+ */
+#define cStaticHashMap_METHOD_DECLARATIONS(TYPENAME, KEY_TYPE, VALUE_TYPE, ...)\
+\
+__VA_ARGS__ size_t TYPENAME##_size(const TYPENAME* const me);\
+\
+__VA_ARGS__ void   TYPENAME##_clear(TYPENAME* const me);\
+\
+__VA_ARGS__ int    TYPENAME##_find(const TYPENAME* const me, const KEY_TYPE* const key, size_t* const valIdx);\
+\
+__VA_ARGS__ int	   TYPENAME##_insert(TYPENAME* const me, const KEY_TYPE* const key, const VALUE_TYPE* const value);\
+\
+__VA_ARGS__ int    TYPENAME##_erase(TYPENAME* const me, const KEY_TYPE* const key);\
+\
+__VA_ARGS__ int    TYPENAME##_isUsed(const TYPENAME* const me, const size_t slot);
+
+
+/*This macro is used to make function definitions
+ *of a concrete cStaticHashMap type whose KEY_TYPE is a plain integer type.
+ */
+#define cStaticHashMap_METHOD_DEFINITIONS(TYPENAME, KEY_TYPE, VALUE_TYPE, ...)\
+\
+/*Default hash of the integer keys, a multiply-xorshift mix of the key value. The slot is\
+  taken from the low bits of the hash, so all of the key bits are mixed into them. The upper\
+  half of a 64 bit size_t is folded in by two shifts, which stay valid for 32 bits.*/\
+static size_t TYPENAME##_integerHash(const KEY_TYPE key)\
+{\
+    size_t value = (size_t)key;\
+    value ^= (value >> 16) >> 16;\
+    value ^= value >> 16;\
+    value *= (size_t)(0x45D9F3BUL);\
+    value ^= value >> 16;\
+    value *= (size_t)(0x45D9F3BUL);\
+    value ^= value >> 16;\
+    return value;\
+}\
+\
+cStaticHashMap_HASH_METHOD_DEFINITIONS(TYPENAME, KEY_TYPE, VALUE_TYPE, TYPENAME##_integerHash, __VA_ARGS__)
+
+
+/*This macro is used to make function definitions
+ *of a concrete cStaticHashMap type with the given hash function.
+ */
+#define cStaticHashMap_HASH_METHOD_DEFINITIONS(TYPENAME, KEY_TYPE, VALUE_TYPE, HASH, ...)\
+\
+__VA_ARGS__ size_t TYPENAME##_size(const TYPENAME* const me)\
+{\
+    return me->mapSize;\
+}\
+\
+__VA_ARGS__ void TYPENAME##_clear(TYPENAME* const me)\
+{\
+    me->mapSize = 0;\
+    memset((void*)me->usedBits, 0, sizeof(me->usedBits));\
+}\
+\
+__VA_ARGS__ int TYPENAME##_isUsed(const TYPENAME* const me, const size_t slot)\
+{\
+    return ((slot < cStaticHashMap_SLOT_COUNT(me)) && cStaticHashMap_IS_USED(me, slot)) ? 1 : 0;\
+}\
+\
+__VA_ARGS__ int  TYPENAME##_find(const TYPENAME* const me, const KEY_TYPE* const key, size_t* const valIdx)\
+{\
+    int result = -1;\
+    const size_t mask = cStaticHashMap_SLOT_COUNT(me) - 1;\
+    size_t slot = (size_t)(HASH(*key)) & mask;\
+    size_t probe;\
+    /*The probe sequence of a key ends at the first empty slot*/\
+    for(probe = 0; (probe <= mask) && cStaticHashMap_IS_USED(me, slot); ++probe)\
+    {\
+        if(me->keyList[slot] == *key)\
+        {\
+            result = 0;\
+            if(NULL != valIdx)\
+            {\
+                *valIdx = slot;\
+            }\
+            break;\
+        }\
+        slot = (slot + 1) & mask;\
+    }\
+    return result;\
+}\
+\
+__VA_ARGS__ int	   TYPENAME##_insert(TYPENAME* const me, const KEY_TYPE* const key, const VALUE_TYPE* const value)\
+{\
+    int result = -1;\
+    const size_t mask = cStaticHashMap_SLOT_COUNT(me) - 1;\
+    size_t slot = (size_t)(HASH(*key)) & mask;\
+    size_t probe;\
+    for(probe = 0; probe <= mask; ++probe)\
+    {\
+        if(!cStaticHashMap_IS_USED(me, slot))\
+        {\
+            cStaticHashMap_SET_USED(me, slot);\
+            me->keyList[slot] = *key;\
+            me->valueList[slot] = *value;\
+            ++(me->mapSize);\
+            result = 0;\
+            break;\
+        }\
+        if(me->keyList[slot] == *key)\
+        {\
+            me->valueList[slot] = *value;\
+            result = 0;\
+            break;\
+        }\
+        slot = (slot + 1) & mask;\
+    }\
+    return result;\
+}\
+\
+__VA_ARGS__ int   TYPENAME##_erase(TYPENAME* const me, const KEY_TYPE* const key)\
+{\
+    size_t gap;\
+    int retVal = TYPENAME##_find(me, key, &gap);\
+    if(0 == retVal)\
+    {\
+        const size_t mask = cStaticHashMap_SLOT_COUNT(me) - 1;\
+        size_t slot = (gap + 1) & mask;\
+        /*Each following pair of the sequence which may not be found past the gap is moved into\
+          it, the gap moves to its slot. A pair may not be found if its home slot is cyclically\
+          outside of (gap, slot].*/\
+        while(cStaticHashMap_IS_USED(me, slot) && (slot != gap))\
+        {\
+            const size_t home = (size_t)(HASH(me->keyList[slot])) & mask;\
+            if(((slot - home) & mask) >= ((slot - gap) & mask))\
+            {\
+                me->keyList[gap] = me->keyList[slot];\
+                me->valueList[gap] = me->valueList[slot];\
+                gap = slot;\
+            }\
+            slot = (slot + 1) & mask;\
+        }\
+        cStaticHashMap_SET_FREE(me, gap);\
+        --(me->mapSize);\
+    }\
+    return retVal;\
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
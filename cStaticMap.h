@@ -6,7 +6,7 @@
  All of the methods function same as cMap, differing in that they must be defined for
  every derived types, like a C++ template class.
  
- There are 3 macro definitions included in this header file:
+ There are 3 main macro definitions included in this header file:
  
  - #define cStaticMap(KEY_TYPE, VALUE_TYPE, MAP_ALLOC)  :
    This is used to derive a map type with a 'typedef' statement.
@@ -19,6 +19,10 @@
    This is used to implement cStaticMap method definitions for derived map type. It should be
    stated in a source file.
    
+ If KEY_TYPE is a plain integer type, cStaticMap_INTEGER_METHOD_DEFINITIONS can be used
+ instead of cStaticMap_METHOD_DEFINITIONS. Its find method compares the keys with the
+ vectorized kernel of cfind.h, which should then be compiled with the project.
+   
  As an example, suppose we'd like to derive a class named 'IDMapType'. For it, we'll create
  one header (IDMapType.h) and one source (IDMapType.c) file.
  
@@ -57,6 +61,7 @@
  
  Change Log:
  22.03.2019 first release
+ 16.10.2026 vectorized find for integer key types
  ------------------------------------------------------------------------------------------------*/
 
 
@@ -68,6 +73,7 @@ extern "C" {
 #endif
 
 #include <stddef.h>
+#include "cfind.h"
 
 /*This is the type definition macro of a template cStaticMap type*/
 #define cStaticMap(KEY_TYPE, VALUE_TYPE, MAP_ALLOC) \
@@ -133,16 +139,6 @@ __VA_ARGS__ int    TYPENAME##_erase(TYPENAME* const me, const KEY_TYPE* const ke
     
 #define cStaticMap_METHOD_DEFINITIONS(TYPENAME, KEY_TYPE, VALUE_TYPE, ...)\
 \
-__VA_ARGS__ size_t TYPENAME##_size(const TYPENAME* const me)\
-{\
-    return me->mapSize;\
-}\
-\
-__VA_ARGS__ void TYPENAME##_clear(TYPENAME* const me)\
-{\
-    me->mapSize = 0;\
-}\
-\
 __VA_ARGS__ int  TYPENAME##_find(const TYPENAME* const me, const KEY_TYPE* const key, size_t* const valIdx)\
 {\
     int result = -1;\
@@ -162,6 +158,50 @@ __VA_ARGS__ int  TYPENAME##_find(const TYPENAME* const me, const KEY_TYPE* const
     return result;\
 }\
 \
+cStaticMap_COMMON_METHOD_DEFINITIONS(TYPENAME, KEY_TYPE, VALUE_TYPE, __VA_ARGS__)
+
+
+/*This macro is used to make function definitions 
+ *of a concrete cStaticMap type whose KEY_TYPE is a plain integer type.
+ *The keys are compared bytewise by the vectorized cFind_first kernel.
+ */
+
+#define cStaticMap_INTEGER_METHOD_DEFINITIONS(TYPENAME, KEY_TYPE, VALUE_TYPE, ...)\
+\
+__VA_ARGS__ int  TYPENAME##_find(const TYPENAME* const me, const KEY_TYPE* const key, size_t* const valIdx)\
+{\
+    int result = -1;\
+    const size_t idx = cFind_first((const void*)me->keyList, me->mapSize, sizeof(KEY_TYPE), (const void*)key, sizeof(KEY_TYPE));\
+    if(idx < me->mapSize)\
+    {\
+        result = 0;\
+        if(NULL != valIdx)\
+        {\
+            *valIdx = idx;\
+        }\
+    }\
+    return result;\
+}\
+\
+cStaticMap_COMMON_METHOD_DEFINITIONS(TYPENAME, KEY_TYPE, VALUE_TYPE, __VA_ARGS__)
+
+
+/*This macro is used to make the function definitions other than find,
+ *shared by the definition macros above.
+ */
+
+#define cStaticMap_COMMON_METHOD_DEFINITIONS(TYPENAME, KEY_TYPE, VALUE_TYPE, ...)\
+\
+__VA_ARGS__ size_t TYPENAME##_size(const TYPENAME* const me)\
+{\
+    return me->mapSize;\
+}\
+\
+__VA_ARGS__ void TYPENAME##_clear(TYPENAME* const me)\
+{\
+    me->mapSize = 0;\
+}\
+\
 __VA_ARGS__ int	   TYPENAME##_insert(TYPENAME* const me, const KEY_TYPE* const key, const VALUE_TYPE* const value)\
 {\
     size_t valIdx;\
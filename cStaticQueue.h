@@ -0,0 +1,345 @@
+ /*
+
+ ANSI C Static Concurrent Queue implementation
+
+ These are statically allocated bounded FIFO queues to pass fixed-size messages between threads
+ without a lock, derived like cStaticArray for every value type, like a C++ template class.
+
+ - cStaticSPSCQueue : wait-free ring for a single producer and a single consumer thread. Each side
+   owns one index and only reads the other one.
+ - cStaticMPMCQueue : lock-free bounded ring for multiple producers and consumers (Dmitry Vyukov's
+   algorithm). Each cell keeps a sequence number telling whether it is ready to be written or read
+   at a given lap, so producers and consumers only compete on their own index by compare and swap.
+
+ The head and tail indices are padded to CSTATICQUEUE_CACHE_LINE_SIZE bytes, so that the producers
+ and the consumers do not invalidate each other's cache line (false sharing).
+
+ The indices are C11 atomics when <stdatomic.h> is available. Otherwise (ANSI C or C++) they are
+ plain size_t variables and the queues are NOT thread safe: the same methods can then be used in a
+ single thread, or under an external lock.
+
+ There are 3 macro definitions for each queue included in this header file:
+
+ - #define cStaticSPSCQueue(VALUE_TYPE, QUEUE_ALLOC) / cStaticMPMCQueue(VALUE_TYPE, QUEUE_ALLOC)  :
+   This is used to derive a queue type with a 'typedef' statement. QUEUE_ALLOC must be a power of 2.
+
+ - #define cStaticSPSCQueue_METHOD_DECLARATIONS(TYPENAME, VALUE_TYPE, ...) (or MPMC)
+   This is used to declare the queue methods for derived queue type. It can be stated in
+   a header or source file.
+
+ - #define cStaticSPSCQueue_METHOD_DEFINITIONS(TYPENAME, VALUE_TYPE, ...) (or MPMC)
+   This is used to implement the queue method definitions for derived queue type. It should be
+   stated in a source file.
+
+ As an example, suppose we'd like to derive a class named 'MessageQueueType'. For it, we'll create
+ one header (MessageQueueType.h) and one source (MessageQueueType.c) file.
+
+ MessageQueueType.h :
+ ------------------------------------------------------------------------------
+
+ #ifndef MESSAGE_QUEUE_TYPE_H
+ #define MESSAGE_QUEUE_TYPE_H
+
+ #include "cStaticQueue.h"
+ #include "Message.h"
+
+ #define MESSAGE_QUEUE_ALLOC      1024
+
+ typedef cStaticMPMCQueue(Message, MESSAGE_QUEUE_ALLOC) MessageQueueType;
+
+ cStaticMPMCQueue_METHOD_DECLARATIONS(MessageQueueType, Message)
+
+ #endif
+
+ -------------------------------------------------------------------------------
+
+
+ MessageQueueType.c :
+ ------------------------------------------------------------------------------
+
+ #include "MessageQueueType.h"
+
+ cStaticMPMCQueue_METHOD_DEFINITIONS(MessageQueueType, Message)
+
+ -------------------------------------------------------------------------------
+
+ NOTE: An instance must be initialized by TYPENAME_clear before it is shared by the threads.
+ TYPENAME_clear itself is not thread safe.
+
+ Authors: akozan
+
+ Change Log:
+ 16.10.2026 first release
+ ------------------------------------------------------------------------------------------------*/
+
+
+#ifndef C_STATIC_QUEUE_H
+#define C_STATIC_QUEUE_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stddef.h>
+
+/*Size of the cache line the queue indices are padded to*/
+#ifndef CSTATICQUEUE_CACHE_LINE_SIZE
+#define CSTATICQUEUE_CACHE_LINE_SIZE    64
+#endif
+
+#if !defined(__cplusplus) && defined(__STDC_VERSION__) && (__STDC_VERSION__ >= 201112L) && !defined(__STDC_NO_ATOMICS__)
+
+#include <stdatomic.h>
+
+#define CSTATICQUEUE_ATOMIC_SIZE                        atomic_size_t
+#define CSTATICQUEUE_ALIGNAS                            _Alignas(CSTATICQUEUE_CACHE_LINE_SIZE)
+#define CSTATICQUEUE_INIT(pIndex, value)                atomic_init((pIndex), (value))
+#define CSTATICQUEUE_LOAD_RELAXED(pIndex)               atomic_load_explicit((pIndex), memory_order_relaxed)
+#define CSTATICQUEUE_LOAD_ACQUIRE(pIndex)               atomic_load_explicit((pIndex), memory_order_acquire)
+#define CSTATICQUEUE_STORE_RELEASE(pIndex, value)       atomic_store_explicit((pIndex), (value), memory_order_release)
+#define CSTATICQUEUE_CAS_RELAXED(pIndex, pExpected, desired)\
+        atomic_compare_exchange_weak_explicit((pIndex), (pExpected), (desired), memory_order_relaxed, memory_order_relaxed)
+
+#else
+
+/*Non-atomic fallback, for a single thread or an external lock*/
+#define CSTATICQUEUE_ATOMIC_SIZE                        size_t
+#define CSTATICQUEUE_ALIGNAS
+#define CSTATICQUEUE_INIT(pIndex, value)                (*(pIndex) = (value))
+#define CSTATICQUEUE_LOAD_RELAXED(pIndex)               (*(pIndex))
+#define CSTATICQUEUE_LOAD_ACQUIRE(pIndex)               (*(pIndex))
+#define CSTATICQUEUE_STORE_RELEASE(pIndex, value)       (*(pIndex) = (value))
+#define CSTATICQUEUE_CAS_RELAXED(pIndex, pExpected, desired)\
+        ((*(pIndex) == *(pExpected)) ? ((*(pIndex) = (desired)), 1) : ((*(pExpected) = *(pIndex)), 0))
+
+#endif
+
+/*This is the type of a queue index, padded to a whole cache line*/
+#define CSTATICQUEUE_PADDED_INDEX\
+    CSTATICQUEUE_ALIGNAS union {\
+        CSTATICQUEUE_ATOMIC_SIZE value;\
+        char padding[CSTATICQUEUE_CACHE_LINE_SIZE];\
+    }
+
+/*Gives the capacity of a derived queue type, from its cell array*/
+#define CSTATICQUEUE_CAPACITY(TYPENAME, LIST)   ((sizeof(((TYPENAME*)0)->LIST)) / (sizeof(((TYPENAME*)0)->LIST[0])))
+
+
+/*This is the type definition macro of a template cStaticSPSCQueue type.
+  "head" is written by the consumer only and "tail" by the producer only. Both are
+  counters that are never wrapped, the cell is taken from their low bits.*/
+#define cStaticSPSCQueue(VALUE_TYPE, QUEUE_ALLOC)\
+    struct {\
+        CSTATICQUEUE_PADDED_INDEX head;\
+        CSTATICQUEUE_PADDED_INDEX tail;\
+        CSTATICQUEUE_ALIGNAS VALUE_TYPE valueList[QUEUE_ALLOC];\
+    }
+
+/*This is the type definition macro of a template cStaticMPMCQueue type.
+  The sequence of a cell is equal to the position a producer can write it at, and
+  one more than the position a consumer can read it at.*/
+#define cStaticMPMCQueue(VALUE_TYPE, QUEUE_ALLOC)\
+    struct {\
+        CSTATICQUEUE_PADDED_INDEX head;\
+        CSTATICQUEUE_PADDED_INDEX tail;\
+        CSTATICQUEUE_ALIGNAS struct {\
+            CSTATICQUEUE_ATOMIC_SIZE sequence;\
+            VALUE_TYPE value;\
+        } cellList[QUEUE_ALLOC];\
+    }
+
+/* Empties the queue. It must be called before the queue is used by the threads.
+	\param me : queue instance pointer
+	\return   : none.
+void TYPENAME_clear(TYPENAME* me) */
+
+/* Returns the number of elements in the queue. While the other threads are working,
+   it is only a snapshot.
+	\param me : queue instance pointer
+	\return   : number of elements
+size_t TYPENAME_size(const TYPENAME* me) */
+
+/* Adds new element to the end of the queue.
+	\param me : queue instance pointer
+	\param newElem	: element to be added.
+	\retVal 		: result: 0 = Success, -1 = Failure (the queue is full)
+int TYPENAME_push(TYPENAME* me, const VALUE_TYPE* newElem) */
+
+/* Takes the element at the start of the queue.
+	\param me : queue instance pointer
+	\param elem 	: the element taken from the queue.
+	\retVal 		: result: 0 = Success, -1 = Failure (the queue is empty)
+int TYPENAME_pop(TYPENAME* me, VALUE_TYPE* elem) */
+
+
+/*This macro is used to make function declarations
+ *of a concrete cStaticSPSCQueue type.
+ */
+#define cStaticSPSCQueue_METHOD_DECLARATIONS(TYPENAME, VALUE_TYPE, ...)\
+\
+__VA_ARGS__ void TYPENAME##_clear(TYPENAME* const me);\
+\
+__VA_ARGS__ size_t TYPENAME##_size(TYPENAME* const me);\
+\
+__VA_ARGS__ int TYPENAME##_push(TYPENAME* const me, const VALUE_TYPE* const newElem);\
+\
+__VA_ARGS__ int TYPENAME##_pop(TYPENAME* const me, VALUE_TYPE* const elem);
+
+
+/*This macro is used to make function definitions
+ *of a concrete cStaticSPSCQueue type.
+ */
+
+#define cStaticSPSCQueue_METHOD_DEFINITIONS(TYPENAME, VALUE_TYPE, ...)\
+\
+typedef char TYPENAME##_capacityIsPowerOf2[((CSTATICQUEUE_CAPACITY(TYPENAME, valueList) & (CSTATICQUEUE_CAPACITY(TYPENAME, valueList) - 1)) == 0) ? 1 : -1];\
+\
+__VA_ARGS__ void TYPENAME##_clear(TYPENAME* const me)\
+{\
+    CSTATICQUEUE_INIT(&(me->head.value), (size_t)0);\
+    CSTATICQUEUE_INIT(&(me->tail.value), (size_t)0);\
+}\
+\
+__VA_ARGS__ size_t TYPENAME##_size(TYPENAME* const me)\
+{\
+    const size_t head = CSTATICQUEUE_LOAD_ACQUIRE(&(me->head.value));\
+    return (size_t)(CSTATICQUEUE_LOAD_ACQUIRE(&(me->tail.value)) - head);\
+}\
+\
+__VA_ARGS__ int TYPENAME##_push(TYPENAME* const me, const VALUE_TYPE* const newElem)\
+{\
+    int retVal = -1;\
+    const size_t tail = CSTATICQUEUE_LOAD_RELAXED(&(me->tail.value));\
+    if((tail - CSTATICQUEUE_LOAD_ACQUIRE(&(me->head.value))) < CSTATICQUEUE_CAPACITY(TYPENAME, valueList))\
+    {\
+        me->valueList[tail & (CSTATICQUEUE_CAPACITY(TYPENAME, valueList) - 1)] = *newElem;\
+        CSTATICQUEUE_STORE_RELEASE(&(me->tail.value), tail + 1);\
+        retVal = 0;\
+    }\
+    return retVal;\
+}\
+\
+__VA_ARGS__ int TYPENAME##_pop(TYPENAME* const me, VALUE_TYPE* const elem)\
+{\
+    int retVal = -1;\
+    const size_t head = CSTATICQUEUE_LOAD_RELAXED(&(me->head.value));\
+    if(head != CSTATICQUEUE_LOAD_ACQUIRE(&(me->tail.value)))\
+    {\
+        *elem = me->valueList[head & (CSTATICQUEUE_CAPACITY(TYPENAME, valueList) - 1)];\
+        CSTATICQUEUE_STORE_RELEASE(&(me->head.value), head + 1);\
+        retVal = 0;\
+    }\
+    return retVal;\
+}
+
+
+/*This macro is used to make function declarations
+ *of a concrete cStaticMPMCQueue type.
+ */
+#define cStaticMPMCQueue_METHOD_DECLARATIONS(TYPENAME, VALUE_TYPE, ...)\
+\
+__VA_ARGS__ void TYPENAME##_clear(TYPENAME* const me);\
+\
+__VA_ARGS__ size_t TYPENAME##_size(TYPENAME* const me);\
+\
+__VA_ARGS__ int TYPENAME##_push(TYPENAME* const me, const VALUE_TYPE* const newElem);\
+\
+__VA_ARGS__ int TYPENAME##_pop(TYPENAME* const me, VALUE_TYPE* const elem);
+
+
+/*This macro is used to make function definitions
+ *of a concrete cStaticMPMCQueue type.
+ */
+
+#define cStaticMPMCQueue_METHOD_DEFINITIONS(TYPENAME, VALUE_TYPE, ...)\
+\
+typedef char TYPENAME##_capacityIsPowerOf2[((CSTATICQUEUE_CAPACITY(TYPENAME, cellList) & (CSTATICQUEUE_CAPACITY(TYPENAME, cellList) - 1)) == 0) ? 1 : -1];\
+\
+__VA_ARGS__ void TYPENAME##_clear(TYPENAME* const me)\
+{\
+    size_t idx = 0;\
+    for(; idx < CSTATICQUEUE_CAPACITY(TYPENAME, cellList); ++idx)\
+    {\
+        CSTATICQUEUE_INIT(&(me->cellList[idx].sequence), idx);\
+    }\
+    CSTATICQUEUE_INIT(&(me->head.value), (size_t)0);\
+    CSTATICQUEUE_INIT(&(me->tail.value), (size_t)0);\
+}\
+\
+__VA_ARGS__ size_t TYPENAME##_size(TYPENAME* const me)\
+{\
+    const size_t head = CSTATICQUEUE_LOAD_ACQUIRE(&(me->head.value));\
+    const size_t tail = CSTATICQUEUE_LOAD_ACQUIRE(&(me->tail.value));\
+    return ((ptrdiff_t)(tail - head) > 0) ? (size_t)(tail - head) : (size_t)0;\
+}\
+\
+__VA_ARGS__ int TYPENAME##_push(TYPENAME* const me, const VALUE_TYPE* const newElem)\
+{\
+    int retVal = -1;\
+    size_t pos = CSTATICQUEUE_LOAD_RELAXED(&(me->tail.value));\
+    for(;;)\
+    {\
+        const size_t cellIdx = pos & (CSTATICQUEUE_CAPACITY(TYPENAME, cellList) - 1);\
+        const ptrdiff_t diff = (ptrdiff_t)(CSTATICQUEUE_LOAD_ACQUIRE(&(me->cellList[cellIdx].sequence)) - pos);\
+        if(0 == diff)\
+        {\
+            /*The cell is free at this lap, claim the position*/\
+            if(CSTATICQUEUE_CAS_RELAXED(&(me->tail.value), &pos, pos + 1))\
+            {\
+                me->cellList[cellIdx].value = *newElem;\
+                CSTATICQUEUE_STORE_RELEASE(&(me->cellList[cellIdx].sequence), pos + 1);\
+                retVal = 0;\
+                break;\
+            }\
+        }\
+        else if(0 > diff)\
+        {\
+            /*The cell is not read yet at the previous lap, the queue is full*/\
+            break;\
+        }\
+        else\
+        {\
+            pos = CSTATICQUEUE_LOAD_RELAXED(&(me->tail.value));\
+        }\
+    }\
+    return retVal;\
+}\
+\
+__VA_ARGS__ int TYPENAME##_pop(TYPENAME* const me, VALUE_TYPE* const elem)\
+{\
+    int retVal = -1;\
+    size_t pos = CSTATICQUEUE_LOAD_RELAXED(&(me->head.value));\
+    for(;;)\
+    {\
+        const size_t cellIdx = pos & (CSTATICQUEUE_CAPACITY(TYPENAME, cellList) - 1);\
+        const ptrdiff_t diff = (ptrdiff_t)(CSTATICQUEUE_LOAD_ACQUIRE(&(me->cellList[cellIdx].sequence)) - (pos + 1));\
+        if(0 == diff)\
+        {\
+            /*The cell is written at this lap, claim the position*/\
+            if(CSTATICQUEUE_CAS_RELAXED(&(me->head.value), &pos, pos + 1))\
+            {\
+                *elem = me->cellList[cellIdx].value;\
+                CSTATICQUEUE_STORE_RELEASE(&(me->cellList[cellIdx].sequence), pos + CSTATICQUEUE_CAPACITY(TYPENAME, cellList));\
+                retVal = 0;\
+                break;\
+            }\
+        }\
+        else if(0 > diff)\
+        {\
+            /*The cell is not written yet at this lap, the queue is empty*/\
+            break;\
+        }\
+        else\
+        {\
+            pos = CSTATICQUEUE_LOAD_RELAXED(&(me->head.value));\
+        }\
+    }\
+    return retVal;\
+}
+
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,390 @@
+ /*
+
+ ANSI C Static Sorted Array implementation
+
+ This is a sorted reinterpretation of cStaticArray as a statically allocated template array
+ class. The values are kept in ascending order, so that find runs a binary search in
+ O(log n) time instead of scanning the whole valueList. All of the methods must be defined
+ for every derived types, like a C++ template class.
+
+ There are 3 main macro definitions included in this header file:
+
+ - #define cStaticSortedArray(VALUE_TYPE, ARRAY_ALLOC)  :
+   This is used to derive an array type with a 'typedef' statement.
+
+ - #define cStaticSortedArray_METHOD_DECLARATIONS(TYPENAME, VALUE_TYPE, ...)
+   This is used to declare cStaticSortedArray methods for derived array type. It can be stated
+   in a header or source file.
+
+ - #define cStaticSortedArray_METHOD_DEFINITIONS(TYPENAME, VALUE_TYPE, ...)
+   This is used to implement cStaticSortedArray method definitions for derived array type. It
+   should be stated in a source file.
+
+ The values are ordered by "<" and matched by "==", so VALUE_TYPE should be an arithmetic type.
+ Duplicate values are allowed, insert puts a value before its equals.
+
+ A lookup table known at compile time needs no insertion at all: a const instance can be
+ initialized with its values already in order, e.g. placed in flash, and searched by find.
+
+ static const IDArrayType idTable = { 4, { 3, 17, 42, 1000 } };
+
+ TYPENAME_isSorted can check such a table, e.g. in a unit test.
+
+ Eytzinger layout:
+ ------------------------------------------------------------------------------
+ For read-mostly tables, cStaticSortedArray_EYTZINGER_METHOD_DECLARATIONS/DEFINITIONS define
+ a variant keeping valueList in the Eytzinger (breadth first) order of the binary search tree:
+ the children of the value at the position k (counted from 1) are at 2k and 2k+1. The search
+ descends without a branch on the comparisons, and the first levels of the tree share a few
+ cache lines, whose following nodes are prefetched ahead. The table is laid out by
+ TYPENAME_build from values in ascending order in O(n) time, e.g. from a const sorted table
+ at the startup. It has no insert or erase, the table is built again instead.
+ ------------------------------------------------------------------------------
+
+ As an example, suppose we'd like to derive a class named 'IDArrayType'. For it, we'll create
+ one header (IDArrayType.h) and one source (IDArrayType.c) file.
+
+ IDArrayType.h :
+ ------------------------------------------------------------------------------
+
+ #ifndef ID_ARRAY_TYPE_H
+ #define ID_ARRAY_TYPE_H
+
+ #include <stdint.h>
+ #include "cStaticSortedArray.h"
+
+ #define ID_ARRAY_VALUE_TYPE uint32_t
+ #define ID_ARRAY_ALLOC      256
+
+ typedef cStaticSortedArray(ID_ARRAY_VALUE_TYPE, ID_ARRAY_ALLOC) IDArrayType;
+
+ cStaticSortedArray_METHOD_DECLARATIONS(IDArrayType, ID_ARRAY_VALUE_TYPE)
+
+ #endif
+
+ -------------------------------------------------------------------------------
+
+
+ IDArrayType.c :
+ ------------------------------------------------------------------------------
+
+ #include "IDArrayType.h"
+
+ cStaticSortedArray_METHOD_DEFINITIONS(IDArrayType, ID_ARRAY_VALUE_TYPE)
+
+ -------------------------------------------------------------------------------
+
+ Authors: akozan
+
+ Change Log:
+ 16.10.2026 first release
+ ------------------------------------------------------------------------------------------------*/
+
+
+#ifndef C_STATIC_SORTED_ARRAY_H
+#define C_STATIC_SORTED_ARRAY_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stddef.h>
+
+/*This is the type definition macro of a template cStaticSortedArray type*/
+#define cStaticSortedArray(VALUE_TYPE, ARRAY_ALLOC)\
+    struct {\
+        size_t arraySize;\
+        VALUE_TYPE valueList[ARRAY_ALLOC];\
+    }
+
+/*Prefetches the cache line of the given address for a read, used by the Eytzinger searches*/
+#ifndef C_STATIC_SORTED_PREFETCH
+#if defined(__GNUC__)
+#define C_STATIC_SORTED_PREFETCH(ptr)   __builtin_prefetch((const void*)(ptr), 0, 3)
+#else
+#define C_STATIC_SORTED_PREFETCH(ptr)   ((void)(ptr))
+#endif
+#endif
+
+/*Number of the tree levels the Eytzinger searches prefetch ahead, 2^4 nodes of a level span
+  one cache line or more*/
+#ifndef C_STATIC_SORTED_PREFETCH_LEVELS
+#define C_STATIC_SORTED_PREFETCH_LEVELS 4
+#endif
+
+/* Returns the number of elements in the array.
+	\param me : cStaticSortedArray instance pointer
+	\return   : number of elements
+size_t TYPENAME_size(const TYPENAME* me) */
+
+
+/* Clears the array.
+	\param me : cStaticSortedArray instance pointer
+	\return   : none.
+void TYPENAME_clear(TYPENAME* me) */
+
+
+/* Returns the idx of given element.
+	\param me : cStaticSortedArray instance pointer
+	\param elem 	: value of element.
+	\retVal 		: the index of the first equal element. if not found, returns the size of array
+size_t TYPENAME_find(const TYPENAME* me, const VALUE_TYPE* elem) */
+
+/* Returns the index of the first element not less than the given one.
+	\param me : cStaticSortedArray instance pointer
+	\param elem 	: value of element.
+	\retVal 		: the index, the size of array if all of the elements are less
+size_t TYPENAME_lowerBound(const TYPENAME* me, const VALUE_TYPE* elem) */
+
+/* Adds new element at its ordered position.
+	\param me : cStaticSortedArray instance pointer
+	\param newElem	: element to be added.
+	\retVal		: result: 0 = Success, -1 = Failure (the array is full)
+int TYPENAME_insert(TYPENAME* me, const VALUE_TYPE* newElem) */
+
+/* Deletes the element at the index "idx".
+	\param me : cStaticSortedArray instance pointer
+	\param idx 		: index value.
+	\retVal 		: result: 0 = Success, -1 = Failure
+int TYPENAME_eraseAt(TYPENAME* me, const size_t idx) */
+
+/* Deletes the first element equal to the given one.
+	\param me : cStaticSortedArray instance pointer
+	\param elem 	: element value.
+	\retVal 		: result: 0 = Success, -1 = Failure
+int TYPENAME_erase(TYPENAME* me, const VALUE_TYPE* elem) */
+
+/* Tells whether the elements are in ascending order, e.g. to check a const table.
+	\param me : cStaticSortedArray instance pointer
+	\retVal   : 1 if they are in order, 0 otherwise
+int TYPENAME_isSorted(const TYPENAME* me) */
+
+/* Lays out the given elements in the Eytzinger order (Eytzinger variant only).
+	\param me : cStaticSortedArray instance pointer
+	\param sortedList : elements in ascending order
+	\param count      : number of the elements
+	\retVal 		  : result: 0 = Success, -1 = Failure (too many elements)
+int TYPENAME_build(TYPENAME* me, const VALUE_TYPE* sortedList, const size_t count) */
+
+
+/*This macro is used to make function declarations
+ *of a concrete cStaticSortedArray type.
+ */
+#define cStaticSortedArray_METHOD_DECLARATIONS(TYPENAME, VALUE_TYPE, ...)\
+\
+__VA_ARGS__ size_t TYPENAME##_size(const TYPENAME* const me);\
+\
+__VA_ARGS__ void TYPENAME##_clear(TYPENAME* const me);\
+\
+__VA_ARGS__ size_t TYPENAME##_find(const TYPENAME* const me, const VALUE_TYPE* const elem);\
+\
+__VA_ARGS__ size_t TYPENAME##_lowerBound(const TYPENAME* const me, const VALUE_TYPE* const elem);\
+\
+__VA_ARGS__ int TYPENAME##_insert(TYPENAME* const me, const VALUE_TYPE* const newElem);\
+\
+__VA_ARGS__ int TYPENAME##_eraseAt(TYPENAME* const me, const size_t idx);\
+\
+__VA_ARGS__ int TYPENAME##_erase(TYPENAME* const me, const VALUE_TYPE* const elem);\
+\
+__VA_ARGS__ int TYPENAME##_isSorted(const TYPENAME* const me);
+
+
+/*This macro is used to make function definitions
+ *of a concrete cStaticSortedArray type.
+ */
+
+#define cStaticSortedArray_METHOD_DEFINITIONS(TYPENAME, VALUE_TYPE, ...)\
+\
+__VA_ARGS__ size_t TYPENAME##_size(const TYPENAME* const me)\
+{\
+    return me->arraySize;\
+}\
+\
+__VA_ARGS__ void TYPENAME##_clear(TYPENAME* const me)\
+{\
+    me->arraySize = 0;\
+}\
+\
+__VA_ARGS__ size_t TYPENAME##_lowerBound(const TYPENAME* const me, const VALUE_TYPE* const elem)\
+{\
+    size_t first = 0;\
+    size_t count = me->arraySize;\
+    while(count > 0)\
+    {\
+        const size_t half = count / 2;\
+        if(me->valueList[first + half] < *elem)\
+        {\
+            first += half + 1;\
+            count -= half + 1;\
+        }\
+        else\
+        {\
+            count = half;\
+        }\
+    }\
+    return first;\
+}\
+\
+__VA_ARGS__ size_t TYPENAME##_find(const TYPENAME* const me, const VALUE_TYPE* const elem)\
+{\
+    size_t retVal = TYPENAME##_lowerBound(me, elem);\
+    if((retVal < me->arraySize) && !(me->valueList[retVal] == *elem))\
+    {\
+        retVal = me->arraySize;\
+    }\
+    return retVal;\
+}\
+\
+__VA_ARGS__ int TYPENAME##_insert(TYPENAME* const me, const VALUE_TYPE* const newElem)\
+{\
+    int retVal = -1;\
+    if(me->arraySize < ((sizeof(me->valueList)) / (sizeof(me->valueList[0]))))\
+    {\
+        const size_t idx = TYPENAME##_lowerBound(me, newElem);\
+        size_t revIdx = me->arraySize;\
+        for(;revIdx > idx; --revIdx)\
+        {\
+            me->valueList[revIdx] = me->valueList[revIdx - 1];\
+        }\
+        me->valueList[idx] = *newElem;\
+        ++(me->arraySize);\
+        retVal = 0;\
+    }\
+    return retVal;\
+}\
+\
+__VA_ARGS__ int TYPENAME##_eraseAt(TYPENAME* const me, const size_t idx)\
+{\
+    int retVal = -1;\
+    if(idx < me->arraySize)\
+    {\
+        size_t valIdx = idx + 1;\
+        for(; valIdx < me->arraySize; ++valIdx)\
+        {\
+           me->valueList[valIdx - 1] = me->valueList[valIdx];\
+        }\
+        --(me->arraySize);\
+        retVal = 0;\
+    }\
+    return retVal;\
+}\
+\
+__VA_ARGS__ int TYPENAME##_erase(TYPENAME* const me, const VALUE_TYPE* const elem)\
+{\
+    return TYPENAME##_eraseAt(me, TYPENAME##_find(me, elem));\
+}\
+\
+__VA_ARGS__ int TYPENAME##_isSorted(const TYPENAME* const me)\
+{\
+    size_t idx = 1;\
+    for(; idx < me->arraySize; ++idx)\
+    {\
+        if(me->valueList[idx] < me->valueList[idx - 1])\
+        {\
+            break;\
+        }\
+    }\
+    return (idx >= me->arraySize) ? 1 : 0;\
+}
+
+
+/*This macro is used to make function declarations
+ *of a concrete cStaticSortedArray type in the Eytzinger layout.
+ */
+#define cStaticSortedArray_EYTZINGER_METHOD_DECLARATIONS(TYPENAME, VALUE_TYPE, ...)\
+\
+__VA_ARGS__ size_t TYPENAME##_size(const TYPENAME* const me);\
+\
+__VA_ARGS__ void TYPENAME##_clear(TYPENAME* const me);\
+\
+__VA_ARGS__ size_t TYPENAME##_find(const TYPENAME* const me, const VALUE_TYPE* const elem);\
+\
+__VA_ARGS__ int TYPENAME##_build(TYPENAME* const me, const VALUE_TYPE* const sortedList, const size_t count);
+
+
+/*This macro is used to make function definitions
+ *of a concrete cStaticSortedArray type in the Eytzinger layout.
+ *find returns the position of an equal element in valueList.
+ */
+
+#define cStaticSortedArray_EYTZINGER_METHOD_DEFINITIONS(TYPENAME, VALUE_TYPE, ...)\
+\
+__VA_ARGS__ size_t TYPENAME##_size(const TYPENAME* const me)\
+{\
+    return me->arraySize;\
+}\
+\
+__VA_ARGS__ void TYPENAME##_clear(TYPENAME* const me)\
+{\
+    me->arraySize = 0;\
+}\
+\
+__VA_ARGS__ size_t TYPENAME##_find(const TYPENAME* const me, const VALUE_TYPE* const elem)\
+{\
+    size_t retVal = me->arraySize;\
+    size_t node = 1;\
+    while(node <= me->arraySize)\
+    {\
+        if((node << C_STATIC_SORTED_PREFETCH_LEVELS) <= me->arraySize)\
+        {\
+            C_STATIC_SORTED_PREFETCH(&(me->valueList[(node << C_STATIC_SORTED_PREFETCH_LEVELS) - 1]));\
+        }\
+        node = (2 * node) + ((me->valueList[node - 1] < *elem) ? 1 : 0);\
+    }\
+    /*The lower bound is where the descent last went left: drop the right turns after it*/\
+    while(0 != (node & 1))\
+    {\
+        node >>= 1;\
+    }\
+    node >>= 1;\
+    if((0 != node) && (me->valueList[node - 1] == *elem))\
+    {\
+        retVal = node - 1;\
+    }\
+    return retVal;\
+}\
+\
+__VA_ARGS__ int TYPENAME##_build(TYPENAME* const me, const VALUE_TYPE* const sortedList, const size_t count)\
+{\
+    int retVal = -1;\
+    if(count <= ((sizeof(me->valueList)) / (sizeof(me->valueList[0]))))\
+    {\
+        size_t node = 1;\
+        size_t idx;\
+        /*The tree is filled in order, from its leftmost node to the successor of each*/\
+        while((2 * node) <= count)\
+        {\
+            node *= 2;\
+        }\
+        for(idx = 0; idx < count; ++idx)\
+        {\
+            me->valueList[node - 1] = sortedList[idx];\
+            if(((2 * node) + 1) <= count)\
+            {\
+                node = (2 * node) + 1;\
+                while((2 * node) <= count)\
+                {\
+                    node *= 2;\
+                }\
+            }\
+            else\
+            {\
+                while(0 != (node & 1))\
+                {\
+                    node >>= 1;\
+                }\
+                node >>= 1;\
+            }\
+        }\
+        me->arraySize = count;\
+        retVal = 0;\
+    }\
+    return retVal;\
+}
+
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
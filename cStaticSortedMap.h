@@ -0,0 +1,395 @@
+/*
+
+ ANSI C Static Sorted map implementation
+
+ This is a sorted reinterpretation of cStaticMap as a statically allocated template map class.
+ The pairs are kept in ascending key order, so that find runs a binary search in O(log n)
+ time instead of scanning the whole keyList. All of the methods must be defined for every
+ derived types, like a C++ template class.
+
+ There are 3 main macro definitions included in this header file:
+
+ - #define cStaticSortedMap(KEY_TYPE, VALUE_TYPE, MAP_ALLOC)  :
+   This is used to derive a map type with a 'typedef' statement.
+
+ - #define cStaticSortedMap_METHOD_DECLARATIONS(TYPENAME, KEY_TYPE, VALUE_TYPE, ...)
+   This is used to declare cStaticSortedMap methods for derived map type. It can be stated in
+   a header or source file.
+
+ - #define cStaticSortedMap_METHOD_DEFINITIONS(TYPENAME, KEY_TYPE, VALUE_TYPE, ...)
+   This is used to implement cStaticSortedMap method definitions for derived map type. It
+   should be stated in a source file.
+
+ The keys are ordered by "<" and matched by "==", so KEY_TYPE should be an arithmetic type.
+
+ A lookup table known at compile time needs no insertion at all: a const instance can be
+ initialized with its keys already in order, e.g. placed in flash, and searched by find.
+
+ static const OpcodeMapType opcodeTable = { 3, { 0x01, 0x10, 0x7F }, { 2, 8, 1 } };
+
+ TYPENAME_isSorted can check such a table, e.g. in a unit test.
+
+ Eytzinger layout:
+ ------------------------------------------------------------------------------
+ For read-mostly tables, cStaticSortedMap_EYTZINGER_METHOD_DECLARATIONS/DEFINITIONS define a
+ variant keeping keyList (and valueList beside it) in the Eytzinger order of the binary search
+ tree, like cStaticSortedArray. The table is laid out by TYPENAME_build from pairs in ascending
+ key order in O(n) time, e.g. from a const sorted table at the startup, and has no insert or
+ erase. See cStaticSortedArray.h.
+ ------------------------------------------------------------------------------
+
+ As an example, suppose we'd like to derive a class named 'OpcodeMapType'. For it, we'll create
+ one header (OpcodeMapType.h) and one source (OpcodeMapType.c) file.
+
+ OpcodeMapType.h :
+ ------------------------------------------------------------------------------
+
+ #ifndef OPCODE_MAP_TYPE_H
+ #define OPCODE_MAP_TYPE_H
+
+ #include <stdint.h>
+ #include "cStaticSortedMap.h"
+
+ #define OPCODE_MAP_KEY_TYPE   uint8_t
+ #define OPCODE_MAP_VALUE_TYPE uint16_t
+ #define OPCODE_MAP_ALLOC      200
+
+ typedef cStaticSortedMap(OPCODE_MAP_KEY_TYPE, OPCODE_MAP_VALUE_TYPE, OPCODE_MAP_ALLOC) OpcodeMapType;
+
+ cStaticSortedMap_METHOD_DECLARATIONS(OpcodeMapType, OPCODE_MAP_KEY_TYPE, OPCODE_MAP_VALUE_TYPE)
+
+ #endif
+
+ -------------------------------------------------------------------------------
+
+
+ OpcodeMapType.c :
+ ------------------------------------------------------------------------------
+
+ #include "OpcodeMapType.h"
+
+ cStaticSortedMap_METHOD_DEFINITIONS(OpcodeMapType, OPCODE_MAP_KEY_TYPE, OPCODE_MAP_VALUE_TYPE)
+
+ -------------------------------------------------------------------------------
+
+ Authors: akozan
+
+ Change Log:
+ 16.10.2026 first release
+ ------------------------------------------------------------------------------------------------*/
+
+
+#ifndef C_STATIC_SORTED_MAP_H
+#define C_STATIC_SORTED_MAP_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stddef.h>
+
+/*This is the type definition macro of a template cStaticSortedMap type*/
+#define cStaticSortedMap(KEY_TYPE, VALUE_TYPE, MAP_ALLOC) \
+    struct {\
+        size_t mapSize;\
+        KEY_TYPE keyList[MAP_ALLOC];\
+        VALUE_TYPE valueList[MAP_ALLOC];\
+    }
+
+/*Prefetches the cache line of the given address for a read, used by the Eytzinger searches*/
+#ifndef C_STATIC_SORTED_PREFETCH
+#if defined(__GNUC__)
+#define C_STATIC_SORTED_PREFETCH(ptr)   __builtin_prefetch((const void*)(ptr), 0, 3)
+#else
+#define C_STATIC_SORTED_PREFETCH(ptr)   ((void)(ptr))
+#endif
+#endif
+
+/*Number of the tree levels the Eytzinger searches prefetch ahead, 2^4 nodes of a level span
+  one cache line or more*/
+#ifndef C_STATIC_SORTED_PREFETCH_LEVELS
+#define C_STATIC_SORTED_PREFETCH_LEVELS 4
+#endif
+
+
+/* Returns the number of elements in the map.
+	\param me : cStaticSortedMap instance pointer
+	\return   : number of elements
+size_t TYPENAME##_size(const TYPENAME* const me) */
+
+/* Clears the map.
+	\param me : cStaticSortedMap instance pointer
+	\return   : none.
+void   TYPENAME##_clear(TYPENAME* const me) */
+
+/* Returns the value index containing given key.
+	\param me               : cStaticSortedMap instance pointer
+	\param key              : key value
+    \param size_t valIdx    : index the value resides
+    \result         : return value of function.
+                  result: 0 = Success, -1 = Failure
+int    TYPENAME##_find(const TYPENAME* const me, const KEY_TYPE* const key, size_t* const valIdx) */
+
+/* Returns the index of the first key not less than the given one.
+	\param me  : cStaticSortedMap instance pointer
+	\param key : key value
+    \result    : the index, the size of map if all of the keys are less
+size_t TYPENAME##_lowerBound(const TYPENAME* const me, const KEY_TYPE* const key) */
+
+/* Adds new pair at its ordered position, or overwrites the value of an existing key.
+	\param me : cStaticSortedMap instance pointer
+	\param key: key to be added.
+    \param value: value to be added.
+	\result 		: result: 0 = Success, -1 = Failure (the map is full)
+int	   TYPENAME##_insert(TYPENAME* const me, const KEY_TYPE* const key, const VALUE_TYPE* const value) */
+
+/* Deletes the pair containing given key.
+	\param me : cStaticSortedMap instance pointer
+	\param key : key value
+	\result 		: result: 0 = Success, -1 = Failure
+int   TYPENAME##_erase(TYPENAME* const me, const KEY_TYPE* const key) */
+
+/* Tells whether the keys are in strictly ascending order, e.g. to check a const table.
+	\param me : cStaticSortedMap instance pointer
+	\result   : 1 if they are in order, 0 otherwise
+int   TYPENAME##_isSorted(const TYPENAME* const me) */
+
+/* Lays out the given pairs in the Eytzinger order (Eytzinger variant only).
+	\param me         : cStaticSortedMap instance pointer
+	\param sortedKeys : keys in strictly ascending order
+	\param values     : values of the keys
+	\param count      : number of the pairs
+	\result           : result: 0 = Success, -1 = Failure (too many pairs)
+int   TYPENAME##_build(TYPENAME* const me, const KEY_TYPE* const sortedKeys, const VALUE_TYPE* const values, const size_t count) */
+
+
+/*This macro is used to make function declarations
+ *of a concrete cStaticSortedMap type.
+ */
+#define cStaticSortedMap_METHOD_DECLARATIONS(TYPENAME, KEY_TYPE, VALUE_TYPE, ...)\
+\
+__VA_ARGS__ size_t TYPENAME##_size(const TYPENAME* const me);\
+\
+__VA_ARGS__ void   TYPENAME##_clear(TYPENAME* const me);\
+\
+__VA_ARGS__ int    TYPENAME##_find(const TYPENAME* const me, const KEY_TYPE* const key, size_t* const valIdx);\
+\
+__VA_ARGS__ size_t TYPENAME##_lowerBound(const TYPENAME* const me, const KEY_TYPE* const key);\
+\
+__VA_ARGS__ int	   TYPENAME##_insert(TYPENAME* const me, const KEY_TYPE* const key, const VALUE_TYPE* const value);\
+\
+__VA_ARGS__ int    TYPENAME##_erase(TYPENAME* const me, const KEY_TYPE* const key);\
+\
+__VA_ARGS__ int    TYPENAME##_isSorted(const TYPENAME* const me);
+
+
+/*This macro is used to make function definitions
+ *of a concrete cStaticSortedMap type.
+ */
+
+#define cStaticSortedMap_METHOD_DEFINITIONS(TYPENAME, KEY_TYPE, VALUE_TYPE, ...)\
+\
+__VA_ARGS__ size_t TYPENAME##_size(const TYPENAME* const me)\
+{\
+    return me->mapSize;\
+}\
+\
+__VA_ARGS__ void TYPENAME##_clear(TYPENAME* const me)\
+{\
+    me->mapSize = 0;\
+}\
+\
+__VA_ARGS__ size_t TYPENAME##_lowerBound(const TYPENAME* const me, const KEY_TYPE* const key)\
+{\
+    size_t first = 0;\
+    size_t count = me->mapSize;\
+    while(count > 0)\
+    {\
+        const size_t half = count / 2;\
+        if(me->keyList[first + half] < *key)\
+        {\
+            first += half + 1;\
+            count -= half + 1;\
+        }\
+        else\
+        {\
+            count = half;\
+        }\
+    }\
+    return first;\
+}\
+\
+__VA_ARGS__ int  TYPENAME##_find(const TYPENAME* const me, const KEY_TYPE* const key, size_t* const valIdx)\
+{\
+    int result = -1;\
+    const size_t idx = TYPENAME##_lowerBound(me, key);\
+    if((idx < me->mapSize) && (me->keyList[idx] == *key))\
+    {\
+        result = 0;\
+        if(NULL != valIdx)\
+        {\
+            *valIdx = idx;\
+        }\
+    }\
+    return result;\
+}\
+\
+__VA_ARGS__ int	   TYPENAME##_insert(TYPENAME* const me, const KEY_TYPE* const key, const VALUE_TYPE* const value)\
+{\
+    int result = -1;\
+    const size_t idx = TYPENAME##_lowerBound(me, key);\
+    if((idx < me->mapSize) && (me->keyList[idx] == *key))\
+    {\
+        me->valueList[idx] = *value;\
+        result = 0;\
+    }\
+    else if(me->mapSize < ((sizeof(me->keyList)) / (sizeof(me->keyList[0]))))\
+    {\
+        size_t revIdx = me->mapSize;\
+        for(;revIdx > idx; --revIdx)\
+        {\
+            me->keyList[revIdx]   = me->keyList[revIdx - 1];\
+            me->valueList[revIdx] = me->valueList[revIdx - 1];\
+        }\
+        me->keyList[idx]   = *key;\
+        me->valueList[idx] = *value;\
+        ++(me->mapSize);\
+        result = 0;\
+    }\
+    return result;\
+}\
+\
+__VA_ARGS__ int   TYPENAME##_erase(TYPENAME* const me, const KEY_TYPE* const key)\
+{\
+    size_t valIdx;\
+    int retVal = TYPENAME##_find(me, key, &valIdx);\
+    if(0 == retVal)\
+    {\
+        for(++valIdx; valIdx < me->mapSize; ++valIdx)\
+        {\
+            me->keyList[valIdx - 1]   = me->keyList[valIdx];\
+            me->valueList[valIdx - 1] = me->valueList[valIdx];\
+        }\
+        --(me->mapSize);\
+    }\
+    return retVal;\
+}\
+\
+__VA_ARGS__ int   TYPENAME##_isSorted(const TYPENAME* const me)\
+{\
+    size_t idx = 1;\
+    for(; idx < me->mapSize; ++idx)\
+    {\
+        if(!(me->keyList[idx - 1] < me->keyList[idx]))\
+        {\
+            break;\
+        }\
+    }\
+    return (idx >= me->mapSize) ? 1 : 0;\
+}
+
+
+/*This macro is used to make function declarations
+ *of a concrete cStaticSortedMap type in the Eytzinger layout.
+ */
+#define cStaticSortedMap_EYTZINGER_METHOD_DECLARATIONS(TYPENAME, KEY_TYPE, VALUE_TYPE, ...)\
+\
+__VA_ARGS__ size_t TYPENAME##_size(const TYPENAME* const me);\
+\
+__VA_ARGS__ void   TYPENAME##_clear(TYPENAME* const me);\
+\
+__VA_ARGS__ int    TYPENAME##_find(const TYPENAME* const me, const KEY_TYPE* const key, size_t* const valIdx);\
+\
+__VA_ARGS__ int    TYPENAME##_build(TYPENAME* const me, const KEY_TYPE* const sortedKeys, const VALUE_TYPE* const values, const size_t count);
+
+
+/*This macro is used to make function definitions
+ *of a concrete cStaticSortedMap type in the Eytzinger layout.
+ */
+
+#define cStaticSortedMap_EYTZINGER_METHOD_DEFINITIONS(TYPENAME, KEY_TYPE, VALUE_TYPE, ...)\
+\
+__VA_ARGS__ size_t TYPENAME##_size(const TYPENAME* const me)\
+{\
+    return me->mapSize;\
+}\
+\
+__VA_ARGS__ void TYPENAME##_clear(TYPENAME* const me)\
+{\
+    me->mapSize = 0;\
+}\
+\
+__VA_ARGS__ int  TYPENAME##_find(const TYPENAME* const me, const KEY_TYPE* const key, size_t* const valIdx)\
+{\
+    int result = -1;\
+    size_t node = 1;\
+    while(node <= me->mapSize)\
+    {\
+        if((node << C_STATIC_SORTED_PREFETCH_LEVELS) <= me->mapSize)\
+        {\
+            C_STATIC_SORTED_PREFETCH(&(me->keyList[(node << C_STATIC_SORTED_PREFETCH_LEVELS) - 1]));\
+        }\
+        node = (2 * node) + ((me->keyList[node - 1] < *key) ? 1 : 0);\
+    }\
+    /*The lower bound is where the descent last went left: drop the right turns after it*/\
+    while(0 != (node & 1))\
+    {\
+        node >>= 1;\
+    }\
+    node >>= 1;\
+    if((0 != node) && (me->keyList[node - 1] == *key))\
+    {\
+        result = 0;\
+        if(NULL != valIdx)\
+        {\
+            *valIdx = node - 1;\
+        }\
+    }\
+    return result;\
+}\
+\
+__VA_ARGS__ int   TYPENAME##_build(TYPENAME* const me, const KEY_TYPE* const sortedKeys, const VALUE_TYPE* const values, const size_t count)\
+{\
+    int retVal = -1;\
+    if(count <= ((sizeof(me->keyList)) / (sizeof(me->keyList[0]))))\
+    {\
+        size_t node = 1;\
+        size_t idx;\
+        /*The tree is filled in order, from its leftmost node to the successor of each*/\
+        while((2 * node) <= count)\
+        {\
+            node *= 2;\
+        }\
+        for(idx = 0; idx < count; ++idx)\
+        {\
+            me->keyList[node - 1]   = sortedKeys[idx];\
+            me->valueList[node - 1] = values[idx];\
+            if(((2 * node) + 1) <= count)\
+            {\
+                node = (2 * node) + 1;\
+                while((2 * node) <= count)\
+                {\
+                    node *= 2;\
+                }\
+            }\
+            else\
+            {\
+                while(0 != (node & 1))\
+                {\
+                    node >>= 1;\
+                }\
+                node >>= 1;\
+            }\
+        }\
+        me->mapSize = count;\
+        retVal = 0;\
+    }\
+    return retVal;\
+}
+
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
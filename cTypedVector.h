@@ -0,0 +1,606 @@
+ /*
+
+ ANSI C Typed Vector implementation
+
+ This is a reinterpretation of cVector as a template vector class, growing in heap like cVector
+ while keeping the elements in a typed array like cStaticArray. Elements are copied by direct
+ assignment instead of memcpy with a runtime size, so that the compiler can specialize and
+ inline the methods for each derived type.
+
+ There are 3 main macro definitions included in this header file:
+
+ - #define cTypedVector(VALUE_TYPE)  :
+   This is used to derive a vector type with a 'typedef' statement.
+
+ - #define cTypedVector_METHOD_DECLARATIONS(TYPENAME, VALUE_TYPE, ...)
+   This is used to declare cTypedVector methods for derived vector type. It can be stated in
+   a header or source file.
+
+ - #define cTypedVector_METHOD_DEFINITIONS(TYPENAME, VALUE_TYPE, ...)
+   This is used to implement cTypedVector method definitions for derived vector type. It should be
+   stated in a source file, or in a header with "static" (or "static inline") qualifiers.
+
+ If VALUE_TYPE is a plain integer type, cTypedVector_INTEGER_METHOD_DEFINITIONS can be used
+ instead of cTypedVector_METHOD_DEFINITIONS. Its find method compares the values with the
+ vectorized kernel of cfind.h, which should then be compiled with the project.
+
+ cTypedVector_DECLARE(TYPENAME, VALUE_TYPE, ...) derives the type and defines all of its methods
+ in one statement (cTypedVector_INTEGER_DECLARE for integer types). It is meant for headers, so
+ that the methods are inlined in the hot loops:
+
+ IDVectorType.h :
+ ------------------------------------------------------------------------------
+
+ #ifndef ID_VECTOR_TYPE_H
+ #define ID_VECTOR_TYPE_H
+
+ #include <stdint.h>
+ #include "cTypedVector.h"
+
+ cTypedVector_DECLARE(IDVectorType, uint32_t, static inline)
+
+ #endif
+
+ -------------------------------------------------------------------------------
+
+ Otherwise the type is derived like cStaticArray, with one header and one source file:
+
+ IDVectorType.h :
+ ------------------------------------------------------------------------------
+
+ typedef cTypedVector(uint32_t) IDVectorType;
+
+ cTypedVector_METHOD_DECLARATIONS(IDVectorType, uint32_t)
+
+ -------------------------------------------------------------------------------
+
+ IDVectorType.c :
+ ------------------------------------------------------------------------------
+
+ cTypedVector_METHOD_DEFINITIONS(IDVectorType, uint32_t)
+
+ -------------------------------------------------------------------------------
+
+ cTypedVector_SORT_DECLARATIONS and cTypedVector_SORT_DEFINITIONS add TYPENAME_sort to a derived
+ type. The comparison is given as a macro LESS(a, b), so that it is inlined in the sorting loops
+ instead of being called through a pointer like the comparison of qsort or cVector_sort:
+
+ #define ID_LESS(a, b) ((a) < (b))
+
+ cTypedVector_SORT_DEFINITIONS(IDVectorType, uint32_t, ID_LESS, static inline)
+
+ NOTE: Since cTypedVector allocates elements in heap, it should be constructed by TYPENAME_construct
+ and deallocated by TYPENAME_clear at the end of the scope, like cVector.
+
+ Authors: akozan
+
+ Change Log:
+ 16.10.2026 first release
+ 16.10.2026 introsort with an inlined comparison, cTypedVector_SORT_DEFINITIONS
+ ------------------------------------------------------------------------------------------------*/
+
+
+#ifndef C_TYPED_VECTOR_H
+#define C_TYPED_VECTOR_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stddef.h>
+#include <stdlib.h>
+#include "cfind.h"
+
+/*This macro defines the power value used in calculation of vector allocation size, in terms of
+element count. It works in the same way as CVECTOR_ALLOC_POWER_SIZE of cVector.
+NOTE: Do not define it as 0!
+*/
+#ifndef CTYPED_VECTOR_ALLOC_POWER_SIZE
+#define CTYPED_VECTOR_ALLOC_POWER_SIZE ((size_t)(2))
+#endif
+
+/*Ranges of at most this many elements are sorted by insertion sort in TYPENAME_sort*/
+#ifndef CTYPED_VECTOR_INSERTION_SORT_SIZE
+#define CTYPED_VECTOR_INSERTION_SORT_SIZE ((size_t)(16))
+#endif
+
+/*This is the type definition macro of a template cTypedVector type*/
+#define cTypedVector(VALUE_TYPE)\
+    struct {\
+        size_t vectSize;\
+        size_t allocSize;\
+        VALUE_TYPE* array;\
+    }
+
+/* Constructs the vector. Need to call after the creation of object.
+	\param me : cTypedVector instance pointer
+	\return   : none
+void TYPENAME_construct(TYPENAME* me) */
+
+/* Returns the number of elements in the vector.
+	\param me : cTypedVector instance pointer
+	\return   : number of elements
+size_t TYPENAME_size(const TYPENAME* me) */
+
+/* Clears the vector and releases its array.
+	\param me : cTypedVector instance pointer
+	\return   : none.
+void TYPENAME_clear(TYPENAME* me) */
+
+/* Makes the vector able to hold "count" elements without any reallocation.
+	\param me : cTypedVector instance pointer
+	\param count : number of the elements.
+	\retVal   : result: 0 = Success, -1 = Failure
+int TYPENAME_reserve(TYPENAME* me, const size_t count) */
+
+/* Reallocates the vector with the number of elements it holds. An empty vector is released.
+	\param me : cTypedVector instance pointer
+	\retVal   : result: 0 = Success, -1 = Failure
+int TYPENAME_shrinkToFit(TYPENAME* me) */
+
+/* Returns the pointer of the element at the index "idx".
+	\param me : cTypedVector instance pointer
+	\param idx 		: index value.
+	\retVal 		: pointer of the element, NULL if "idx" is out of range
+VALUE_TYPE* TYPENAME_at(TYPENAME* me, const size_t idx) */
+
+/* Returns the idx of given element.
+	\param me : cTypedVector instance pointer
+	\param elem 	: value of element.
+	\retVal 		: the index of the element. if not found, returns the size of vector
+size_t TYPENAME_find(const TYPENAME* me, const VALUE_TYPE* elem) */
+
+/* Adds new element to the index "idx".
+	\param me : cTypedVector instance pointer
+	\param newElem	: element to be added.
+    \param idx  : the insertion index
+	\retVal		: result: 0 = Success, -1 = Failure
+int TYPENAME_insert(TYPENAME* me, const VALUE_TYPE* newElem, const size_t idx) */
+
+/* Deletes the element at the index "idx".
+	\param me : cTypedVector instance pointer
+	\param idx 		: index value.
+	\retVal 		: result: 0 = Success, -1 = Failure
+int TYPENAME_eraseAt(TYPENAME* me, const size_t idx) */
+
+/* Deletes the element given.
+	\param me : cTypedVector instance pointer
+	\param elem 	: element value.
+	\retVal 		: result: 0 = Success, -1 = Failure
+int TYPENAME_erase(TYPENAME* me, const VALUE_TYPE* elem) */
+
+/* Adds new element to the start of the vector.
+	\param me : cTypedVector instance pointer
+	\param newElem	: element to be added.
+	\retVal 		: result: 0 = Success, -1 = Failure
+int TYPENAME_pushf(TYPENAME* me, const VALUE_TYPE* newElem)*/
+
+/* Clears the element at the start of the vector.
+	\param me : cTypedVector instance pointer
+	\retVal   : result: 0 = Success, -1 = Failure
+int TYPENAME_popf(TYPENAME* me) */
+
+/* Adds new element to the end of the vector.
+	\param me : cTypedVector instance pointer
+	\param newElem	: element to be added.
+	\retVal 		: result: 0 = Success, -1 = Failure
+int TYPENAME_pushb(TYPENAME* me, const VALUE_TYPE* newElem) */
+
+/* Clears the element at the end of the vector.
+	\param me : cTypedVector instance pointer
+	\retVal   : result: 0 = Success, -1 = Failure
+int TYPENAME_popb(TYPENAME* me) */
+
+/* Sorts the vector in O(n log n) time by introsort, ordering the elements by LESS. The sort is
+   not stable. It is defined by cTypedVector_SORT_DEFINITIONS.
+	\param me : cTypedVector instance pointer
+	\retVal   : none
+void TYPENAME_sort(TYPENAME* me) */
+
+/* NOTE: erase methods keep the allocation, like C++ std::vector. The array is released by
+   TYPENAME_clear or TYPENAME_shrinkToFit.*/
+
+
+/*This macro is used to make function declarations
+ *of a concrete cTypedVector type, including its TYPENAME_grow helper.
+ */
+#define cTypedVector_METHOD_DECLARATIONS(TYPENAME, VALUE_TYPE, ...)\
+\
+__VA_ARGS__ void TYPENAME##_construct(TYPENAME* const me);\
+\
+__VA_ARGS__ size_t TYPENAME##_size(const TYPENAME* const me);\
+\
+__VA_ARGS__ void TYPENAME##_clear(TYPENAME* const me);\
+\
+__VA_ARGS__ int TYPENAME##_reserve(TYPENAME* const me, const size_t count);\
+\
+__VA_ARGS__ int TYPENAME##_shrinkToFit(TYPENAME* const me);\
+\
+__VA_ARGS__ VALUE_TYPE* TYPENAME##_at(TYPENAME* const me, const size_t idx);\
+\
+__VA_ARGS__ size_t TYPENAME##_find(const TYPENAME* const me, const VALUE_TYPE* const elem);\
+\
+__VA_ARGS__ int TYPENAME##_insert(TYPENAME* const me, const VALUE_TYPE* const newElem, const size_t idx);\
+\
+__VA_ARGS__ int TYPENAME##_eraseAt(TYPENAME* const me, const size_t idx);\
+\
+__VA_ARGS__ int TYPENAME##_erase(TYPENAME* const me, const VALUE_TYPE* const elem);\
+\
+__VA_ARGS__ int TYPENAME##_pushf(TYPENAME* const me, const VALUE_TYPE* const newElem);\
+\
+__VA_ARGS__ int TYPENAME##_popf(TYPENAME* const me);\
+\
+__VA_ARGS__ int TYPENAME##_pushb(TYPENAME* const me, const VALUE_TYPE* const newElem);\
+\
+__VA_ARGS__ int TYPENAME##_popb(TYPENAME* const me);\
+\
+__VA_ARGS__ int TYPENAME##_grow(TYPENAME* const me);
+
+
+/*This macro is used to declare TYPENAME_sort of a concrete cTypedVector type,
+ *and the helpers defined along with it.
+ */
+#define cTypedVector_SORT_DECLARATIONS(TYPENAME, VALUE_TYPE, ...)\
+\
+__VA_ARGS__ void TYPENAME##_insertionSort(VALUE_TYPE* const array, const size_t count);\
+\
+__VA_ARGS__ void TYPENAME##_siftDown(VALUE_TYPE* const array, size_t root, const size_t count);\
+\
+__VA_ARGS__ void TYPENAME##_heapSort(VALUE_TYPE* const array, const size_t count);\
+\
+__VA_ARGS__ void TYPENAME##_introSort(VALUE_TYPE* array, size_t count, size_t depthLimit);\
+\
+__VA_ARGS__ void TYPENAME##_sort(TYPENAME* const me);
+
+
+/*This macro derives the vector type and defines all of its methods with the
+ *given qualifiers, e.g. "static inline" in a header.
+ */
+#define cTypedVector_DECLARE(TYPENAME, VALUE_TYPE, ...)\
+\
+typedef cTypedVector(VALUE_TYPE) TYPENAME;\
+\
+cTypedVector_METHOD_DEFINITIONS(TYPENAME, VALUE_TYPE, __VA_ARGS__)
+
+/*This macro is the same as cTypedVector_DECLARE for a plain integer VALUE_TYPE,
+ *defining the methods by cTypedVector_INTEGER_METHOD_DEFINITIONS.
+ */
+#define cTypedVector_INTEGER_DECLARE(TYPENAME, VALUE_TYPE, ...)\
+\
+typedef cTypedVector(VALUE_TYPE) TYPENAME;\
+\
+cTypedVector_INTEGER_METHOD_DEFINITIONS(TYPENAME, VALUE_TYPE, __VA_ARGS__)
+
+
+/*This macro is used to make function definitions
+ *of a concrete cTypedVector type.
+ */
+
+#define cTypedVector_METHOD_DEFINITIONS(TYPENAME, VALUE_TYPE, ...)\
+\
+__VA_ARGS__ size_t TYPENAME##_find(const TYPENAME* const me, const VALUE_TYPE* const elem)\
+{\
+    size_t retVal = 0;\
+    for(; retVal < me->vectSize; ++retVal)\
+    {\
+        if(me->array[retVal] == *elem)\
+        {\
+            break;\
+        }\
+    }\
+    return retVal;\
+}\
+\
+cTypedVector_COMMON_METHOD_DEFINITIONS(TYPENAME, VALUE_TYPE, __VA_ARGS__)
+
+
+/*This macro is used to make function definitions
+ *of a concrete cTypedVector type whose VALUE_TYPE is a plain integer type.
+ *The values are compared bytewise by the vectorized cFind_first kernel.
+ */
+
+#define cTypedVector_INTEGER_METHOD_DEFINITIONS(TYPENAME, VALUE_TYPE, ...)\
+\
+__VA_ARGS__ size_t TYPENAME##_find(const TYPENAME* const me, const VALUE_TYPE* const elem)\
+{\
+    return cFind_first((const void*)me->array, me->vectSize, sizeof(VALUE_TYPE), (const void*)elem, sizeof(VALUE_TYPE));\
+}\
+\
+cTypedVector_COMMON_METHOD_DEFINITIONS(TYPENAME, VALUE_TYPE, __VA_ARGS__)
+
+
+/*This macro is used to make the function definitions other than find,
+ *shared by the definition macros above. TYPENAME_grow is kept out of the
+ *push methods, so that their common path is only a compare and an assignment.
+ */
+
+#define cTypedVector_COMMON_METHOD_DEFINITIONS(TYPENAME, VALUE_TYPE, ...)\
+\
+__VA_ARGS__ void TYPENAME##_construct(TYPENAME* const me)\
+{\
+    me->vectSize = 0;\
+    me->allocSize = 0;\
+    me->array = NULL;\
+}\
+\
+__VA_ARGS__ size_t TYPENAME##_size(const TYPENAME* const me)\
+{\
+    return me->vectSize;\
+}\
+\
+__VA_ARGS__ void TYPENAME##_clear(TYPENAME* const me)\
+{\
+    free((void*)me->array);\
+    me->array = NULL;\
+    me->vectSize = 0;\
+    me->allocSize = 0;\
+}\
+\
+__VA_ARGS__ int TYPENAME##_reserve(TYPENAME* const me, const size_t count)\
+{\
+    int retVal = 0;\
+    if(count > me->allocSize)\
+    {\
+        VALUE_TYPE* newArray = (VALUE_TYPE*)realloc((void*)me->array, count * sizeof(VALUE_TYPE));\
+        if(NULL != newArray)\
+        {\
+            me->array = newArray;\
+            me->allocSize = count;\
+        }\
+        else\
+        {\
+            retVal = -1;\
+        }\
+    }\
+    return retVal;\
+}\
+\
+__VA_ARGS__ int TYPENAME##_shrinkToFit(TYPENAME* const me)\
+{\
+    int retVal = 0;\
+    if(0 == me->vectSize)\
+    {\
+        TYPENAME##_clear(me);\
+    }\
+    else if(me->vectSize < me->allocSize)\
+    {\
+        VALUE_TYPE* newArray = (VALUE_TYPE*)realloc((void*)me->array, me->vectSize * sizeof(VALUE_TYPE));\
+        if(NULL != newArray)\
+        {\
+            me->array = newArray;\
+            me->allocSize = me->vectSize;\
+        }\
+        else\
+        {\
+            retVal = -1;\
+        }\
+    }\
+    return retVal;\
+}\
+\
+__VA_ARGS__ int TYPENAME##_grow(TYPENAME* const me)\
+{\
+    size_t newAllocSize = (0 == me->allocSize) ? CTYPED_VECTOR_ALLOC_POWER_SIZE : (me->allocSize * CTYPED_VECTOR_ALLOC_POWER_SIZE);\
+    if(newAllocSize <= me->allocSize)\
+    {\
+        newAllocSize = me->allocSize + 1;\
+    }\
+    return TYPENAME##_reserve(me, newAllocSize);\
+}\
+\
+__VA_ARGS__ VALUE_TYPE* TYPENAME##_at(TYPENAME* const me, const size_t idx)\
+{\
+    return (idx < me->vectSize) ? &(me->array[idx]) : NULL;\
+}\
+\
+__VA_ARGS__ int TYPENAME##_insert(TYPENAME* const me, const VALUE_TYPE* const newElem, const size_t idx)\
+{\
+    int retVal = -1;\
+    if(idx <= me->vectSize)\
+    {\
+        if((me->vectSize < me->allocSize) || (0 == TYPENAME##_grow(me)))\
+        {\
+            size_t revIdx = me->vectSize;\
+            for(;revIdx > idx; --revIdx)\
+            {\
+               me->array[revIdx] = me->array[revIdx - 1];\
+            }\
+            me->array[idx] = *newElem;\
+            ++(me->vectSize);\
+            retVal = 0;\
+        }\
+    }\
+    return retVal;\
+}\
+\
+__VA_ARGS__ int TYPENAME##_eraseAt(TYPENAME* const me, const size_t idx)\
+{\
+    int retVal = -1;\
+    if(idx < me->vectSize)\
+    {\
+        size_t valIdx = idx + 1;\
+        for(; valIdx < me->vectSize; ++valIdx)\
+        {\
+           me->array[valIdx - 1] = me->array[valIdx];\
+        }\
+        --(me->vectSize);\
+        retVal = 0;\
+    }\
+    return retVal;\
+}\
+\
+__VA_ARGS__ int TYPENAME##_erase(TYPENAME* const me, const VALUE_TYPE* const elem)\
+{\
+    size_t index = TYPENAME##_find(me, elem);\
+    return TYPENAME##_eraseAt(me, index);\
+}\
+\
+__VA_ARGS__ int TYPENAME##_pushf(TYPENAME* const me, const VALUE_TYPE* const newElem)\
+{\
+    return TYPENAME##_insert(me, newElem, (size_t)0);\
+}\
+\
+__VA_ARGS__ int TYPENAME##_popf(TYPENAME* const me)\
+{\
+    return TYPENAME##_eraseAt(me, (size_t)0);\
+}\
+\
+__VA_ARGS__ int TYPENAME##_pushb(TYPENAME* const me, const VALUE_TYPE* const newElem)\
+{\
+    int retVal = 0;\
+    if((me->vectSize < me->allocSize) || (0 == TYPENAME##_grow(me)))\
+    {\
+        me->array[me->vectSize] = *newElem;\
+        ++(me->vectSize);\
+    }\
+    else\
+    {\
+        retVal = -1;\
+    }\
+    return retVal;\
+}\
+\
+__VA_ARGS__ int TYPENAME##_popb(TYPENAME* const me)\
+{\
+    int retVal = -1;\
+    if(0 < me->vectSize)\
+    {\
+        --(me->vectSize);\
+        retVal = 0;\
+    }\
+    return retVal;\
+}
+
+
+
+/*This macro is used to define TYPENAME_sort of a concrete cTypedVector type.
+ *LESS(a, b) is an expression macro evaluating nonzero if the value "a" is
+ *ordered before the value "b". The helpers sort the range of "count"
+ *elements at "array": quicksort with a median of three pivot, switching to
+ *heapsort after 2 * log2(n) levels and to insertion sort for small ranges.
+ */
+
+#define cTypedVector_SORT_DEFINITIONS(TYPENAME, VALUE_TYPE, LESS, ...)\
+\
+__VA_ARGS__ void TYPENAME##_insertionSort(VALUE_TYPE* const array, const size_t count)\
+{\
+    size_t idx = 1;\
+    for(; idx < count; ++idx)\
+    {\
+        const VALUE_TYPE value = array[idx];\
+        size_t position = idx;\
+        for(; (0 < position) && LESS(value, array[position - 1]); --position)\
+        {\
+            array[position] = array[position - 1];\
+        }\
+        array[position] = value;\
+    }\
+}\
+\
+__VA_ARGS__ void TYPENAME##_siftDown(VALUE_TYPE* const array, size_t root, const size_t count)\
+{\
+    const VALUE_TYPE value = array[root];\
+    size_t child;\
+    while((child = (2 * root) + 1) < count)\
+    {\
+        if(((child + 1) < count) && LESS(array[child], array[child + 1]))\
+        {\
+            ++child;\
+        }\
+        if(!LESS(value, array[child]))\
+        {\
+            break;\
+        }\
+        array[root] = array[child];\
+        root = child;\
+    }\
+    array[root] = value;\
+}\
+\
+__VA_ARGS__ void TYPENAME##_heapSort(VALUE_TYPE* const array, const size_t count)\
+{\
+    size_t idx = count / 2;\
+    for(; 0 < idx; --idx)\
+    {\
+        TYPENAME##_siftDown(array, idx - 1, count);\
+    }\
+    for(idx = count - 1; 0 < idx; --idx)\
+    {\
+        const VALUE_TYPE value = array[idx];\
+        array[idx] = array[0];\
+        array[0] = value;\
+        TYPENAME##_siftDown(array, 0, idx);\
+    }\
+}\
+\
+__VA_ARGS__ void TYPENAME##_introSort(VALUE_TYPE* array, size_t count, size_t depthLimit)\
+{\
+    while(CTYPED_VECTOR_INSERTION_SORT_SIZE < count)\
+    {\
+        VALUE_TYPE pivot;\
+        VALUE_TYPE swap;\
+        size_t left = 0;\
+        size_t right = count - 1;\
+        if(0 == depthLimit)\
+        {\
+            TYPENAME##_heapSort(array, count);\
+            return;\
+        }\
+        --depthLimit;\
+        if(LESS(array[count / 2], array[0]))\
+        {\
+            swap = array[count / 2]; array[count / 2] = array[0]; array[0] = swap;\
+        }\
+        if(LESS(array[count - 1], array[count / 2]))\
+        {\
+            swap = array[count - 1]; array[count - 1] = array[count / 2]; array[count / 2] = swap;\
+            if(LESS(array[count / 2], array[0]))\
+            {\
+                swap = array[count / 2]; array[count / 2] = array[0]; array[0] = swap;\
+            }\
+        }\
+        pivot = array[count / 2];\
+        for(;;)\
+        {\
+            do { ++left; } while(LESS(array[left], pivot));\
+            do { --right; } while(LESS(pivot, array[right]));\
+            if(left >= right)\
+            {\
+                break;\
+            }\
+            swap = array[left]; array[left] = array[right]; array[right] = swap;\
+        }\
+        if((right + 1) < (count - right - 1))\
+        {\
+            TYPENAME##_introSort(array, right + 1, depthLimit);\
+            array += right + 1;\
+            count -= right + 1;\
+        }\
+        else\
+        {\
+            TYPENAME##_introSort(array + right + 1, count - right - 1, depthLimit);\
+            count = right + 1;\
+        }\
+    }\
+    TYPENAME##_insertionSort(array, count);\
+}\
+\
+__VA_ARGS__ void TYPENAME##_sort(TYPENAME* const me)\
+{\
+    size_t depthLimit = 0;\
+    size_t count = me->vectSize;\
+    for(; 1 < count; count /= 2)\
+    {\
+        depthLimit += 2;\
+    }\
+    if(1 < me->vectSize)\
+    {\
+        TYPENAME##_introSort(me->array, me->vectSize, depthLimit);\
+    }\
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,478 @@
+#include <stdlib.h>
+#include <string.h>
+#include "calgorithm.h"
+
+/*Gives the pointer integer value of the array element at the specified index, like
+  CVECTOR_CALC_IDX_PTR_VAL of cvector.c*/
+#define CALGORITHM_IDX_PTR_VAL(array, idx, elemSize)  ((size_t)(array) + (idx)*(elemSize))
+
+/*Ranges of at most this many elements are sorted by insertion sort*/
+#define CALGORITHM_INSERTION_SORT_SIZE  ((size_t)(16))
+
+/*Size of the buffer swapping two elements in chunks, in bytes*/
+#define CALGORITHM_SWAP_CHUNK_SIZE      ((size_t)(64))
+
+/*Number of the buckets of a radix sort pass*/
+#define CALGORITHM_RADIX                ((size_t)(256))
+
+/*Compares two elements, either by the compare function or bytewise*/
+#define CALGORITHM_COMPARE(compareFunc, elem1, elem2, elemSize)  ((NULL != (compareFunc)) ?\
+        (compareFunc)((elem1), (elem2), (elemSize)) : memcmp((elem1), (elem2), (elemSize)))
+
+/*Sorting state of cVector_sort*/
+typedef struct {
+    void* array;
+    size_t elemSize;
+    size_t compareSize;
+    cVectorCompareFunc compareFunc;
+    /*element buffers of the pivot and of the insertion sort*/
+    void* pivot;
+    void* hole;
+} cAlgorithmSort;
+
+/*Swaps two elements of "size" bytes in chunks, without a temporary element*/
+static void cAlgorithm_swap(void* elem1, void* elem2, size_t size)
+{
+    unsigned char buffer[CALGORITHM_SWAP_CHUNK_SIZE];
+    unsigned char* pByte1 = (unsigned char*)elem1;
+    unsigned char* pByte2 = (unsigned char*)elem2;
+
+    while((size_t)(0) < size)
+    {
+        const size_t chunkSize = (size < CALGORITHM_SWAP_CHUNK_SIZE) ? size : CALGORITHM_SWAP_CHUNK_SIZE;
+
+        memcpy((void*)buffer, (const void*)pByte1, chunkSize);
+        memcpy((void*)pByte1, (const void*)pByte2, chunkSize);
+        memcpy((void*)pByte2, (const void*)buffer, chunkSize);
+
+        pByte1 += chunkSize;
+        pByte2 += chunkSize;
+        size -= chunkSize;
+    }
+}
+
+/*Tells whether the integers are stored least significant byte first*/
+static int cAlgorithm_isLittleEndian(void)
+{
+    const unsigned int one = 1U;
+
+    return (1U == *(const unsigned char*)&one) ? 1 : 0;
+}
+
+int     cVector_radixSort(cVector* pInstance, size_t keyOffset, size_t keySize, unsigned int flags)
+{
+    int result = -1;
+
+    if((NULL != pInstance) && ((size_t)(0) < keySize) && (keyOffset <= pInstance->elemSize) && (keySize <= (pInstance->elemSize - keyOffset)))
+    {
+        const size_t count = pInstance->vectSize;
+        const size_t elemSize = pInstance->elemSizeAligned;
+
+        if((size_t)(2) > count)
+        {
+            result = 0;
+        }
+        else
+        {
+            /*Histograms of all of the key bytes, counted in a single pass*/
+            size_t* histogram = (size_t*)cAllocator_alloc(pInstance->allocator, (keySize * CALGORITHM_RADIX * sizeof(size_t)));
+            void* buffer = cAllocator_alloc(pInstance->allocator, (count * elemSize));
+
+            if((NULL != histogram) && (NULL != buffer))
+            {
+                /*Significance of the bytes from the least: the last byte of a byte string or a
+                  big-endian integer is the least significant one*/
+                const int isReversed = ((0U != (flags & CVECTOR_SORT_BYTES)) || (0 == cAlgorithm_isLittleEndian())) ? 1 : 0;
+                const unsigned char signFlip = (0U != (flags & CVECTOR_SORT_SIGNED)) ? 0x80U : 0x00U;
+                void* source = pInstance->array;
+                void* target = buffer;
+                size_t byteIdx;
+                size_t idx;
+
+                memset((void*)histogram, 0, (keySize * CALGORITHM_RADIX * sizeof(size_t)));
+
+                for(idx = 0; idx < count; ++idx)
+                {
+                    const unsigned char* key = (const unsigned char*)CALGORITHM_IDX_PTR_VAL(source, idx, elemSize) + keyOffset;
+
+                    for(byteIdx = 0; byteIdx < keySize; ++byteIdx)
+                    {
+                        ++histogram[(byteIdx * CALGORITHM_RADIX) + key[byteIdx]];
+                    }
+                }
+
+                for(byteIdx = 0; byteIdx < keySize; ++byteIdx)
+                {
+                    /*Position of the byte sorted in this pass, from the least significant one*/
+                    const size_t keyByte = (0 != isReversed) ? (keySize - 1 - byteIdx) : byteIdx;
+                    const unsigned char flip = ((keySize - 1) == byteIdx) ? signFlip : 0x00U;
+                    size_t* bucket = &histogram[keyByte * CALGORITHM_RADIX];
+                    size_t offset = 0;
+                    size_t value;
+
+                    /*A byte equal in all of the elements does not reorder them*/
+                    if(count == bucket[*((const unsigned char*)source + keyOffset + keyByte)])
+                    {
+                        continue;
+                    }
+
+                    /*The buckets are visited in the order of the (sign flipped) byte values*/
+                    for(value = 0; value < CALGORITHM_RADIX; ++value)
+                    {
+                        const size_t bucketIdx = value ^ (size_t)flip;
+                        const size_t bucketSize = bucket[bucketIdx];
+
+                        bucket[bucketIdx] = offset;
+                        offset += bucketSize;
+                    }
+
+                    for(idx = 0; idx < count; ++idx)
+                    {
+                        const void* elem = (const void*)CALGORITHM_IDX_PTR_VAL(source, idx, elemSize);
+                        const unsigned char byte = *((const unsigned char*)elem + keyOffset + keyByte);
+
+                        memcpy((void*)CALGORITHM_IDX_PTR_VAL(target, bucket[byte], elemSize), elem, elemSize);
+                        ++bucket[byte];
+                    }
+
+                    CSTATS_ADD(pInstance, bytesMoved, count * elemSize);
+
+                    {
+                        void* swap = source;
+                        source = target;
+                        target = swap;
+                    }
+                }
+
+                if(source != pInstance->array)
+                {
+                    memcpy(pInstance->array, source, (count * elemSize));
+                }
+
+                result = 0;
+            }
+
+            if(NULL != histogram)
+            {
+                cAllocator_free(pInstance->allocator, (void*)histogram, (keySize * CALGORITHM_RADIX * sizeof(size_t)));
+            }
+
+            if(NULL != buffer)
+            {
+                cAllocator_free(pInstance->allocator, buffer, (count * elemSize));
+            }
+        }
+    }
+
+    return result;
+}
+
+/*Sorts the range of "count" elements from "first" by insertion sort*/
+static void cAlgorithm_insertionSort(const cAlgorithmSort* pSort, size_t first, size_t count)
+{
+    size_t idx;
+
+    for(idx = 1; idx < count; ++idx)
+    {
+        const void* elem = (const void*)CALGORITHM_IDX_PTR_VAL(pSort->array, first + idx, pSort->elemSize);
+        size_t position = idx;
+
+        /*The position is found first, then the greater elements are moved in one block*/
+        while(((size_t)(0) < position) &&
+              (0 > CALGORITHM_COMPARE(pSort->compareFunc, elem, (const void*)CALGORITHM_IDX_PTR_VAL(pSort->array, first + position - 1, pSort->elemSize), pSort->compareSize)))
+        {
+            --position;
+        }
+
+        if(position != idx)
+        {
+            memcpy(pSort->hole, elem, pSort->elemSize);
+            memmove((void*)CALGORITHM_IDX_PTR_VAL(pSort->array, first + position + 1, pSort->elemSize),
+                    (const void*)CALGORITHM_IDX_PTR_VAL(pSort->array, first + position, pSort->elemSize),
+                    ((idx - position) * pSort->elemSize));
+            memcpy((void*)CALGORITHM_IDX_PTR_VAL(pSort->array, first + position, pSort->elemSize), (const void*)pSort->hole, pSort->elemSize);
+        }
+    }
+}
+
+/*Moves the element at "root" down the max-heap of "count" elements from "first"*/
+static void cAlgorithm_siftDown(const cAlgorithmSort* pSort, size_t first, size_t root, size_t count)
+{
+    size_t child;
+
+    while((child = (2 * root) + 1) < count)
+    {
+        void* rootElem = (void*)CALGORITHM_IDX_PTR_VAL(pSort->array, first + root, pSort->elemSize);
+        void* childElem = (void*)CALGORITHM_IDX_PTR_VAL(pSort->array, first + child, pSort->elemSize);
+
+        if(((child + 1) < count) &&
+           (0 > CALGORITHM_COMPARE(pSort->compareFunc, (const void*)childElem, (const void*)CALGORITHM_IDX_PTR_VAL(pSort->array, first + child + 1, pSort->elemSize), pSort->compareSize)))
+        {
+            ++child;
+            childElem = (void*)CALGORITHM_IDX_PTR_VAL(pSort->array, first + child, pSort->elemSize);
+        }
+
+        if(0 <= CALGORITHM_COMPARE(pSort->compareFunc, (const void*)rootElem, (const void*)childElem, pSort->compareSize))
+        {
+            break;
+        }
+
+        cAlgorithm_swap(rootElem, childElem, pSort->elemSize);
+        root = child;
+    }
+}
+
+/*Sorts the range of "count" elements from "first" by heapsort, the fallback of introsort*/
+static void cAlgorithm_heapSort(const cAlgorithmSort* pSort, size_t first, size_t count)
+{
+    size_t idx;
+
+    for(idx = count / 2; (size_t)(0) < idx; --idx)
+    {
+        cAlgorithm_siftDown(pSort, first, idx - 1, count);
+    }
+
+    for(idx = count - 1; (size_t)(0) < idx; --idx)
+    {
+        cAlgorithm_swap((void*)CALGORITHM_IDX_PTR_VAL(pSort->array, first, pSort->elemSize), (void*)CALGORITHM_IDX_PTR_VAL(pSort->array, first + idx, pSort->elemSize), pSort->elemSize);
+        cAlgorithm_siftDown(pSort, first, 0, idx);
+    }
+}
+
+/*Sorts the range of "count" elements from "first" by quicksort, until the depth limit is
+  reached. The smaller partition is sorted by recursion and the larger one by the loop, so
+  that the stack depth stays logarithmic.*/
+static void cAlgorithm_introSort(const cAlgorithmSort* pSort, size_t first, size_t count, size_t depthLimit)
+{
+    while(CALGORITHM_INSERTION_SORT_SIZE < count)
+    {
+        size_t left = 0;
+        size_t right = count - 1;
+
+        if((size_t)(0) == depthLimit)
+        {
+            cAlgorithm_heapSort(pSort, first, count);
+            return;
+        }
+        --depthLimit;
+
+        /*Median of three: the first and the last elements bound the scans of the partition*/
+        {
+            void* low = (void*)CALGORITHM_IDX_PTR_VAL(pSort->array, first, pSort->elemSize);
+            void* mid = (void*)CALGORITHM_IDX_PTR_VAL(pSort->array, first + (count / 2), pSort->elemSize);
+            void* high = (void*)CALGORITHM_IDX_PTR_VAL(pSort->array, first + count - 1, pSort->elemSize);
+
+            if(0 > CALGORITHM_COMPARE(pSort->compareFunc, (const void*)mid, (const void*)low, pSort->compareSize))
+            {
+                cAlgorithm_swap(mid, low, pSort->elemSize);
+            }
+            if(0 > CALGORITHM_COMPARE(pSort->compareFunc, (const void*)high, (const void*)mid, pSort->compareSize))
+            {
+                cAlgorithm_swap(high, mid, pSort->elemSize);
+
+                if(0 > CALGORITHM_COMPARE(pSort->compareFunc, (const void*)mid, (const void*)low, pSort->compareSize))
+                {
+                    cAlgorithm_swap(mid, low, pSort->elemSize);
+                }
+            }
+
+            memcpy(pSort->pivot, (const void*)mid, pSort->elemSize);
+        }
+
+        /*Hoare partition: [0, right] <= pivot <= [right + 1, count)*/
+        for(;;)
+        {
+            do
+            {
+                ++left;
+            } while(0 > CALGORITHM_COMPARE(pSort->compareFunc, (const void*)CALGORITHM_IDX_PTR_VAL(pSort->array, first + left, pSort->elemSize), (const void*)pSort->pivot, pSort->compareSize));
+
+            do
+            {
+                --right;
+            } while(0 > CALGORITHM_COMPARE(pSort->compareFunc, (const void*)pSort->pivot, (const void*)CALGORITHM_IDX_PTR_VAL(pSort->array, first + right, pSort->elemSize), pSort->compareSize));
+
+            if(left >= right)
+            {
+                break;
+            }
+
+            cAlgorithm_swap((void*)CALGORITHM_IDX_PTR_VAL(pSort->array, first + left, pSort->elemSize), (void*)CALGORITHM_IDX_PTR_VAL(pSort->array, first + right, pSort->elemSize), pSort->elemSize);
+        }
+
+        if((right + 1) < (count - right - 1))
+        {
+            cAlgorithm_introSort(pSort, first, right + 1, depthLimit);
+            first += right + 1;
+            count -= right + 1;
+        }
+        else
+        {
+            cAlgorithm_introSort(pSort, first + right + 1, count - right - 1, depthLimit);
+            count = right + 1;
+        }
+    }
+
+    cAlgorithm_insertionSort(pSort, first, count);
+}
+
+int     cVector_sort(cVector* pInstance, cVectorCompareFunc compareFunc)
+{
+    int result = -1;
+
+    if(NULL != pInstance)
+    {
+        if((size_t)(2) > pInstance->vectSize)
+        {
+            result = 0;
+        }
+        else
+        {
+            cAlgorithmSort sort;
+            void* buffer = cAllocator_alloc(pInstance->allocator, (2 * pInstance->elemSizeAligned));
+
+            if(NULL != buffer)
+            {
+                size_t depthLimit = 0;
+                size_t count;
+
+                /*2 * log2(n) levels of quicksort before heapsort*/
+                for(count = pInstance->vectSize; (size_t)(1) < count; count /= 2)
+                {
+                    depthLimit += 2;
+                }
+
+                sort.array       = pInstance->array;
+                sort.elemSize    = pInstance->elemSizeAligned;
+                sort.compareSize = pInstance->elemSize;
+                sort.compareFunc = compareFunc;
+                sort.pivot       = buffer;
+                sort.hole        = (void*)((size_t)buffer + pInstance->elemSizeAligned);
+
+                cAlgorithm_introSort(&sort, 0, pInstance->vectSize, depthLimit);
+
+                cAllocator_free(pInstance->allocator, buffer, (2 * pInstance->elemSizeAligned));
+                result = 0;
+            }
+        }
+    }
+
+    return result;
+}
+
+size_t  cVector_unique(cVector* pInstance, cVectorCompareFunc compareFunc)
+{
+    size_t removed = 0;
+
+    if((NULL != pInstance) && ((size_t)(1) < pInstance->vectSize))
+    {
+        const size_t elemSize = pInstance->elemSizeAligned;
+        size_t last = 0;
+        size_t idx;
+
+        for(idx = 1; idx < pInstance->vectSize; ++idx)
+        {
+            const void* elem = (const void*)CALGORITHM_IDX_PTR_VAL(pInstance->array, idx, elemSize);
+
+            if(0 != CALGORITHM_COMPARE(compareFunc, (const void*)CALGORITHM_IDX_PTR_VAL(pInstance->array, last, elemSize), elem, pInstance->elemSize))
+            {
+                ++last;
+
+                if(last != idx)
+                {
+                    memcpy((void*)CALGORITHM_IDX_PTR_VAL(pInstance->array, last, elemSize), elem, elemSize);
+                }
+            }
+        }
+
+        removed = pInstance->vectSize - (last + 1);
+        pInstance->vectSize = last + 1;
+
+        CSTATS_ADD(pInstance, eraseCount, removed);
+    }
+
+    return removed;
+}
+
+size_t  cVector_removeIf(cVector* pInstance, cVectorPredicateFunc predicate, void* context)
+{
+    size_t removed = 0;
+
+    if((NULL != pInstance) && (NULL != predicate))
+    {
+        const size_t elemSize = pInstance->elemSizeAligned;
+        size_t kept = 0;
+        size_t idx;
+
+        for(idx = 0; idx < pInstance->vectSize; ++idx)
+        {
+            const void* elem = (const void*)CALGORITHM_IDX_PTR_VAL(pInstance->array, idx, elemSize);
+
+            if(0 == predicate(elem, context))
+            {
+                if(kept != idx)
+                {
+                    memcpy((void*)CALGORITHM_IDX_PTR_VAL(pInstance->array, kept, elemSize), elem, elemSize);
+                }
+                ++kept;
+            }
+        }
+
+        removed = pInstance->vectSize - kept;
+        pInstance->vectSize = kept;
+
+        CSTATS_ADD(pInstance, eraseCount, removed);
+    }
+
+    return removed;
+}
+
+size_t  cVector_partition(cVector* pInstance, cVectorPredicateFunc predicate, void* context)
+{
+    size_t first = 0;
+
+    if((NULL != pInstance) && (NULL != predicate))
+    {
+        const size_t elemSize = pInstance->elemSizeAligned;
+        size_t last = pInstance->vectSize;
+
+        /*The first unsatisfying element is swapped with the last satisfying one, so that each
+          predicate is evaluated once*/
+        for(;;)
+        {
+            while((first < last) && (0 != predicate((const void*)CALGORITHM_IDX_PTR_VAL(pInstance->array, first, elemSize), context)))
+            {
+                ++first;
+            }
+
+            while((first < last) && (0 == predicate((const void*)CALGORITHM_IDX_PTR_VAL(pInstance->array, last - 1, elemSize), context)))
+            {
+                --last;
+            }
+
+            if(first >= last)
+            {
+                break;
+            }
+
+            cAlgorithm_swap((void*)CALGORITHM_IDX_PTR_VAL(pInstance->array, first, elemSize), (void*)CALGORITHM_IDX_PTR_VAL(pInstance->array, last - 1, elemSize), elemSize);
+            ++first;
+            --last;
+        }
+    }
+
+    return first;
+}
+
+void    cVector_transform(cVector* pInstance, cVectorTransformFunc transform, void* context)
+{
+    if((NULL != pInstance) && (NULL != transform))
+    {
+        size_t idx;
+
+        for(idx = 0; idx < pInstance->vectSize; ++idx)
+        {
+            transform((void*)CALGORITHM_IDX_PTR_VAL(pInstance->array, idx, pInstance->elemSizeAligned), context);
+        }
+    }
+}
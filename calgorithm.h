@@ -0,0 +1,115 @@
+/*
+ ANSI C bulk algorithms of cVector
+
+ These functions work on the array of a vector in place, so that it need not be reached through
+ its private members (e.g. to call qsort) or modified element by element:
+
+ - cVector_radixSort : LSD radix sort of the elements by an unsigned, signed or bytewise key of
+                       fixed width. It runs a counting pass and one scatter pass per key byte,
+                       skipping the bytes equal in all of the elements, without any comparison.
+ - cVector_sort      : introsort (quicksort falling back to heapsort, insertion sort for the
+                       small ranges) with a comparison function.
+ - cVector_unique, cVector_removeIf : remove the elements in a single compaction pass, instead
+                       of a cVector_eraseAt per element moving the whole tail each time.
+ - cVector_partition : moves the elements satisfying a predicate to the front in a single pass.
+ - cVector_transform : calls a function on each element in place.
+
+ The typed vectors of cTypedVector.h sort with an inlined comparison instead, see
+ cTypedVector_SORT_DEFINITIONS.
+
+ NOTE: The removing functions keep the allocation of the vector, like C++ std::remove_if with
+ erase. It is released by cVector_shrinkToFit.
+
+ Authors: akozan
+
+ Change Log:
+ 16.10.2026 first release
+ ------------------------------------------------------------------------------------------------*/
+
+
+#ifndef CALGORITHM_H
+#define CALGORITHM_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stddef.h>
+#include "cvector.h"
+
+/*cVector_radixSort flags*/
+/*The key is a two's complement signed integer*/
+#define CVECTOR_SORT_SIGNED         (0x01U)
+/*The key is a byte string ordered like memcmp, e.g. a fixed-width name or a big-endian number,
+instead of an integer in the native byte order*/
+#define CVECTOR_SORT_BYTES          (0x02U)
+
+/*Element comparison function type. It follows the memcmp convention, like cMapCompareFunc.
+  \param elem1    : pointer of the first element
+  \param elem2    : pointer of the second element
+  \param elemSize : size of the element type in bytes
+  \return         : 0 if the elements are equal, <0 if elem1 is ordered before elem2, >0 otherwise*/
+typedef int (*cVectorCompareFunc)(const void* elem1, const void* elem2, size_t elemSize);
+
+/*Element predicate function type.
+  \param elem    : pointer of the element
+  \param context : user data given to the algorithm
+  \return        : nonzero if the element satisfies the predicate, 0 otherwise*/
+typedef int (*cVectorPredicateFunc)(const void* elem, void* context);
+
+/*Element transformation function type.
+  \param elem    : pointer of the element, to be modified in place
+  \param context : user data given to the algorithm
+  \return        : none*/
+typedef void (*cVectorTransformFunc)(void* elem, void* context);
+
+/* Sorts the vector by the key of "keySize" bytes at "keyOffset" of each element in O(n * keySize)
+   time. The sort is stable. It needs a temporary copy of the array.
+	\param instance  : cVector instance pointer
+	\param keyOffset : offset of the key in the element, in bytes
+	\param keySize   : size of the key in bytes, e.g. sizeof(uint32_t) for an integer key
+	\param flags     : CVECTOR_SORT_XXX bits, 0 for an unsigned integer
+	\return 		 : result: 0 = Success, -1 = Failure (invalid key or no memory)*/
+int     cVector_radixSort(cVector* pInstance, size_t keyOffset, size_t keySize, unsigned int flags);
+
+/* Sorts the vector in O(n log n) time. The sort is not stable.
+	\param instance    : cVector instance pointer
+	\param compareFunc : comparison function of the elements, NULL for bytewise comparison
+	\return 		   : result: 0 = Success, -1 = Failure (no memory)*/
+int     cVector_sort(cVector* pInstance, cVectorCompareFunc compareFunc);
+
+/* Removes the consecutive equal elements but the first of each run, e.g. the duplicates of
+   a sorted vector.
+	\param instance    : cVector instance pointer
+	\param compareFunc : comparison function of the elements, NULL for bytewise comparison
+	\return 		   : number of the removed elements*/
+size_t  cVector_unique(cVector* pInstance, cVectorCompareFunc compareFunc);
+
+/* Removes the elements satisfying the predicate, keeping the order of the others.
+	\param instance  : cVector instance pointer
+	\param predicate : predicate function
+	\param context   : user data passed to the predicate
+	\return 		 : number of the removed elements*/
+size_t  cVector_removeIf(cVector* pInstance, cVectorPredicateFunc predicate, void* context);
+
+/* Reorders the vector so that the elements satisfying the predicate precede the others. The
+   order within the groups is not kept.
+	\param instance  : cVector instance pointer
+	\param predicate : predicate function
+	\param context   : user data passed to the predicate
+	\return 		 : number of the elements satisfying the predicate, the index of the first
+                       element of the other group*/
+size_t  cVector_partition(cVector* pInstance, cVectorPredicateFunc predicate, void* context);
+
+/* Calls the function for each element, in the index order.
+	\param instance  : cVector instance pointer
+	\param transform : transformation function
+	\param context   : user data passed to the function
+	\return 		 : none*/
+void    cVector_transform(cVector* pInstance, cVectorTransformFunc transform, void* context);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
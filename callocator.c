@@ -0,0 +1,409 @@
+#include <stdlib.h>
+#include <string.h>
+#include "callocator.h"
+
+/*This type gives the strictest alignment needed by the fundamental types*/
+typedef union {
+    long   longValue;
+    double doubleValue;
+    void*  pointerValue;
+    void (*functionValue)(void);
+} cAllocatorMaxAlign;
+
+#define CALLOCATOR_MAX_ALIGN                    (sizeof(cAllocatorMaxAlign))
+
+/* This macro gets "size" and returns "align"ed size */
+#define CALLOCATOR_ALIGN_SIZE(size, align)      (((size) % (align)) ? ((size) + ((align) - ((size) % (align)))) : (size))
+
+/*Header of the arena blocks, the allocations follow it.*/
+typedef struct cArenaBlockType {
+    struct cArenaBlockType* next;
+    size_t capacity;
+    size_t used;
+} cArenaBlock;
+
+#define CARENA_HEADER_SIZE                      CALLOCATOR_ALIGN_SIZE(sizeof(cArenaBlock), CALLOCATOR_MAX_ALIGN)
+#define CARENA_BLOCK_DATA(pBlock)               ((unsigned char*)(pBlock) + CARENA_HEADER_SIZE)
+
+/*Header of the pool allocations larger than the block size, the allocation follows it.*/
+typedef struct cPoolLargeType {
+    struct cPoolLargeType* next;
+    struct cPoolLargeType* prev;
+} cPoolLarge;
+
+#define CPOOL_LARGE_HEADER_SIZE                 CALLOCATOR_ALIGN_SIZE(sizeof(cPoolLarge), CALLOCATOR_MAX_ALIGN)
+
+/*Tells whether the alignment needs more than the allocator gives*/
+#define CALLOCATOR_IS_OVER_ALIGNED(align)       ((align) > CALLOCATOR_MAX_ALIGN)
+
+/*Extra size of an aligned allocation: the address of the underlying allocation is kept in
+  front of the aligned one, which is up to "align" - 1 bytes further*/
+#define CALLOCATOR_ALIGNED_EXTRA(align)         ((align) + sizeof(void*))
+
+/*Gives the aligned address in the underlying allocation "rawPtr"*/
+#define CALLOCATOR_ALIGN_PTR(rawPtr, align)     ((((size_t)(rawPtr) + sizeof(void*)) + ((align) - 1)) & ~((size_t)(align) - 1))
+
+/*Gives the address of the underlying allocation of the aligned one "ptr"*/
+#define CALLOCATOR_RAW_PTR(ptr)                 (((void**)(ptr))[-1])
+
+
+void*   cAllocator_alloc(const cAllocator* pAllocator, size_t size)
+{
+    return (NULL == pAllocator) ? malloc(size) : pAllocator->allocFunc(pAllocator->context, size);
+}
+
+void*   cAllocator_realloc(const cAllocator* pAllocator, void* ptr, size_t oldSize, size_t newSize)
+{
+    return (NULL == pAllocator) ? realloc(ptr, newSize) : pAllocator->reallocFunc(pAllocator->context, ptr, oldSize, newSize);
+}
+
+void    cAllocator_free(const cAllocator* pAllocator, void* ptr, size_t size)
+{
+    if(NULL != ptr)
+    {
+        if(NULL == pAllocator)
+        {
+            free(ptr);
+        }
+        else
+        {
+            pAllocator->freeFunc(pAllocator->context, ptr, size);
+        }
+    }
+}
+
+void*   cAllocator_allocAligned(const cAllocator* pAllocator, size_t size, size_t align)
+{
+    void* ptr = NULL;
+
+    if(!CALLOCATOR_IS_OVER_ALIGNED(align))
+    {
+        ptr = cAllocator_alloc(pAllocator, size);
+    }
+    else if(size <= ((size_t)(-1) - CALLOCATOR_ALIGNED_EXTRA(align)))
+    {
+        void* rawPtr = cAllocator_alloc(pAllocator, size + CALLOCATOR_ALIGNED_EXTRA(align));
+
+        if(NULL != rawPtr)
+        {
+            ptr = (void*)CALLOCATOR_ALIGN_PTR(rawPtr, align);
+            CALLOCATOR_RAW_PTR(ptr) = rawPtr;
+        }
+    }
+
+    return ptr;
+}
+
+void*   cAllocator_reallocAligned(const cAllocator* pAllocator, void* ptr, size_t oldSize, size_t newSize, size_t align)
+{
+    void* newPtr = NULL;
+
+    if(!CALLOCATOR_IS_OVER_ALIGNED(align))
+    {
+        newPtr = cAllocator_realloc(pAllocator, ptr, oldSize, newSize);
+    }
+    else if(newSize <= ((size_t)(-1) - CALLOCATOR_ALIGNED_EXTRA(align)))
+    {
+        void* rawPtr = CALLOCATOR_RAW_PTR(ptr);
+        const size_t offset = (size_t)ptr - (size_t)rawPtr;
+        void* newRawPtr = cAllocator_realloc(pAllocator, rawPtr, oldSize + CALLOCATOR_ALIGNED_EXTRA(align), newSize + CALLOCATOR_ALIGNED_EXTRA(align));
+
+        if(NULL != newRawPtr)
+        {
+            newPtr = (void*)CALLOCATOR_ALIGN_PTR(newRawPtr, align);
+
+            /*The reallocation keeps the offset of the content, not its alignment*/
+            if(((size_t)newPtr - (size_t)newRawPtr) != offset)
+            {
+                memmove(newPtr, (const void*)((size_t)newRawPtr + offset), (oldSize < newSize) ? oldSize : newSize);
+            }
+
+            CALLOCATOR_RAW_PTR(newPtr) = newRawPtr;
+        }
+    }
+
+    return newPtr;
+}
+
+void    cAllocator_freeAligned(const cAllocator* pAllocator, void* ptr, size_t size, size_t align)
+{
+    if(!CALLOCATOR_IS_OVER_ALIGNED(align))
+    {
+        cAllocator_free(pAllocator, ptr, size);
+    }
+    else if(NULL != ptr)
+    {
+        cAllocator_free(pAllocator, CALLOCATOR_RAW_PTR(ptr), size + CALLOCATOR_ALIGNED_EXTRA(align));
+    }
+}
+
+
+static void* cArena_allocFunc(void* context, size_t size)
+{
+    cArena* pArena = (cArena*)context;
+    cArenaBlock* pBlock = (cArenaBlock*)pArena->blockList;
+    void* ptr = NULL;
+
+    size = CALLOCATOR_ALIGN_SIZE(size, CALLOCATOR_MAX_ALIGN);
+
+    if((NULL == pBlock) || ((pBlock->capacity - pBlock->used) < size))
+    {
+        const size_t capacity = (size > pArena->blockSize) ? size : pArena->blockSize;
+
+        pBlock = (cArenaBlock*)malloc(CARENA_HEADER_SIZE + capacity);
+
+        if(NULL != pBlock)
+        {
+            pBlock->next = (cArenaBlock*)pArena->blockList;
+            pBlock->capacity = capacity;
+            pBlock->used = 0;
+            pArena->blockList = (void*)pBlock;
+        }
+    }
+
+    if(NULL != pBlock)
+    {
+        ptr = (void*)(CARENA_BLOCK_DATA(pBlock) + pBlock->used);
+        pBlock->used += size;
+        pArena->lastAlloc = ptr;
+    }
+
+    return ptr;
+}
+
+static void* cArena_reallocFunc(void* context, void* ptr, size_t oldSize, size_t newSize)
+{
+    cArena* pArena = (cArena*)context;
+    cArenaBlock* pBlock = (cArenaBlock*)pArena->blockList;
+    void* newPtr = NULL;
+
+    oldSize = CALLOCATOR_ALIGN_SIZE(oldSize, CALLOCATOR_MAX_ALIGN);
+    newSize = CALLOCATOR_ALIGN_SIZE(newSize, CALLOCATOR_MAX_ALIGN);
+
+    if(newSize <= oldSize)
+    {
+        if(ptr == pArena->lastAlloc)
+        {
+            pBlock->used -= (oldSize - newSize);
+        }
+        newPtr = ptr;
+    }
+    else if((ptr == pArena->lastAlloc) && ((pBlock->capacity - pBlock->used) >= (newSize - oldSize)))
+    {
+        /*The last allocation is extended in place*/
+        pBlock->used += (newSize - oldSize);
+        newPtr = ptr;
+    }
+    else
+    {
+        newPtr = cArena_allocFunc(context, newSize);
+
+        if(NULL != newPtr)
+        {
+            memcpy(newPtr, ptr, oldSize);
+        }
+    }
+
+    return newPtr;
+}
+
+static void cArena_freeFunc(void* context, void* ptr, size_t size)
+{
+    cArena* pArena = (cArena*)context;
+
+    /*Only the last allocation can be given back, the rest is released with the arena*/
+    if(ptr == pArena->lastAlloc)
+    {
+        ((cArenaBlock*)pArena->blockList)->used -= CALLOCATOR_ALIGN_SIZE(size, CALLOCATOR_MAX_ALIGN);
+        pArena->lastAlloc = NULL;
+    }
+}
+
+void    cArena_init(cArena* pArena, size_t blockSize)
+{
+    if(NULL != pArena)
+    {
+        pArena->allocator.allocFunc   = cArena_allocFunc;
+        pArena->allocator.reallocFunc = cArena_reallocFunc;
+        pArena->allocator.freeFunc    = cArena_freeFunc;
+        pArena->allocator.context     = (void*)pArena;
+
+        pArena->blockSize = CALLOCATOR_ALIGN_SIZE(blockSize, CALLOCATOR_MAX_ALIGN);
+        pArena->blockList = NULL;
+        pArena->lastAlloc = NULL;
+    }
+}
+
+const cAllocator* cArena_allocator(cArena* pArena)
+{
+    return &(pArena->allocator);
+}
+
+void    cArena_release(cArena* pArena)
+{
+    cArenaBlock* pBlock = (cArenaBlock*)pArena->blockList;
+
+    while(NULL != pBlock)
+    {
+        cArenaBlock* pNext = pBlock->next;
+        free(pBlock);
+        pBlock = pNext;
+    }
+
+    pArena->blockList = NULL;
+    pArena->lastAlloc = NULL;
+}
+
+
+static void* cPool_allocFunc(void* context, size_t size)
+{
+    cPool* pPool = (cPool*)context;
+    void* ptr = NULL;
+
+    if(size <= pPool->blockSize)
+    {
+        if(NULL == pPool->freeList)
+        {
+            /*Each chunk starts with the link of the chunk list, followed by the blocks*/
+            unsigned char* pChunk = (unsigned char*)malloc(CALLOCATOR_MAX_ALIGN + (pPool->blockSize * pPool->blocksPerChunk));
+
+            if(NULL != pChunk)
+            {
+                size_t blockIdx;
+
+                *(void**)pChunk = pPool->chunkList;
+                pPool->chunkList = (void*)pChunk;
+
+                for(blockIdx = pPool->blocksPerChunk; blockIdx > 0; --blockIdx)
+                {
+                    void** pBlock = (void**)(pChunk + CALLOCATOR_MAX_ALIGN + ((blockIdx - 1) * pPool->blockSize));
+                    *pBlock = pPool->freeList;
+                    pPool->freeList = (void*)pBlock;
+                }
+            }
+        }
+
+        if(NULL != pPool->freeList)
+        {
+            ptr = pPool->freeList;
+            pPool->freeList = *(void**)ptr;
+        }
+    }
+    else
+    {
+        cPoolLarge* pLarge = (cPoolLarge*)malloc(CPOOL_LARGE_HEADER_SIZE + size);
+
+        if(NULL != pLarge)
+        {
+            pLarge->prev = NULL;
+            pLarge->next = (cPoolLarge*)pPool->largeList;
+            if(NULL != pLarge->next)
+            {
+                pLarge->next->prev = pLarge;
+            }
+            pPool->largeList = (void*)pLarge;
+
+            ptr = (void*)((unsigned char*)pLarge + CPOOL_LARGE_HEADER_SIZE);
+        }
+    }
+
+    return ptr;
+}
+
+static void cPool_freeFunc(void* context, void* ptr, size_t size)
+{
+    cPool* pPool = (cPool*)context;
+
+    if(size <= pPool->blockSize)
+    {
+        *(void**)ptr = pPool->freeList;
+        pPool->freeList = ptr;
+    }
+    else
+    {
+        cPoolLarge* pLarge = (cPoolLarge*)((unsigned char*)ptr - CPOOL_LARGE_HEADER_SIZE);
+
+        if(NULL != pLarge->prev)
+        {
+            pLarge->prev->next = pLarge->next;
+        }
+        else
+        {
+            pPool->largeList = (void*)pLarge->next;
+        }
+
+        if(NULL != pLarge->next)
+        {
+            pLarge->next->prev = pLarge->prev;
+        }
+
+        free(pLarge);
+    }
+}
+
+static void* cPool_reallocFunc(void* context, void* ptr, size_t oldSize, size_t newSize)
+{
+    cPool* pPool = (cPool*)context;
+    void* newPtr = ptr;
+
+    /*A block already holds any size up to the block size*/
+    if((oldSize > pPool->blockSize) || (newSize > pPool->blockSize))
+    {
+        newPtr = cPool_allocFunc(context, newSize);
+
+        if(NULL != newPtr)
+        {
+            memcpy(newPtr, ptr, (oldSize < newSize) ? oldSize : newSize);
+            cPool_freeFunc(context, ptr, oldSize);
+        }
+    }
+
+    return newPtr;
+}
+
+void    cPool_init(cPool* pPool, size_t blockSize, size_t blocksPerChunk)
+{
+    if(NULL != pPool)
+    {
+        pPool->allocator.allocFunc   = cPool_allocFunc;
+        pPool->allocator.reallocFunc = cPool_reallocFunc;
+        pPool->allocator.freeFunc    = cPool_freeFunc;
+        pPool->allocator.context     = (void*)pPool;
+
+        /*A free block keeps the link of the free list*/
+        pPool->blockSize      = CALLOCATOR_ALIGN_SIZE(((blockSize < sizeof(void*)) ? sizeof(void*) : blockSize), CALLOCATOR_MAX_ALIGN);
+        pPool->blocksPerChunk = ((size_t)(0) < blocksPerChunk) ? blocksPerChunk : (size_t)(1);
+        pPool->freeList  = NULL;
+        pPool->chunkList = NULL;
+        pPool->largeList = NULL;
+    }
+}
+
+const cAllocator* cPool_allocator(cPool* pPool)
+{
+    return &(pPool->allocator);
+}
+
+void    cPool_release(cPool* pPool)
+{
+    void* pChunk = pPool->chunkList;
+    cPoolLarge* pLarge = (cPoolLarge*)pPool->largeList;
+
+    while(NULL != pChunk)
+    {
+        void* pNext = *(void**)pChunk;
+        free(pChunk);
+        pChunk = pNext;
+    }
+
+    while(NULL != pLarge)
+    {
+        cPoolLarge* pNext = pLarge->next;
+        free(pLarge);
+        pLarge = pNext;
+    }
+
+    pPool->freeList  = NULL;
+    pPool->chunkList = NULL;
+    pPool->largeList = NULL;
+}
@@ -0,0 +1,176 @@
+/*
+ ANSI C allocator interface of the dynamic containers
+ 
+ cVector and cMap allocate their arrays through a cAllocator, so that they can be placed in
+ user managed memory instead of the heap. A NULL allocator stands for the C standard library
+ (malloc, realloc and free), which is also the default of the containers.
+ 
+ Two allocators are provided in this module:
+ 
+ - cArena : bump pointer allocator. Allocations are carved out of large blocks and the
+   whole arena is released at once by cArena_release, so that the containers built in it
+   don't need to be cleared one by one.
+   
+ - cPool  : fixed size block allocator. Requests up to the block size are served from a
+   free list of equally sized blocks, larger ones are passed to the standard library.
+   All of them are released at once by cPool_release.
+   
+ The aligned functions place an allocation at a larger alignment than the allocator gives, e.g.
+ a cache line or a page, on top of any allocator. They are used by the containers constructed with
+ an explicit alignment.
+
+ NOTE: The allocator must outlive the containers using it. After cArena_release or
+ cPool_release, the containers built in it must not be used until they are constructed
+ again.
+
+ Authors: akozan
+ 
+ Change Log:
+ 16.10.2026 first release
+ 16.10.2026 aligned allocation
+ ------------------------------------------------------------------------------------------------*/
+
+
+#ifndef CALLOCATOR_H
+#define CALLOCATOR_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stddef.h>
+
+/*cAllocator type. The sizes of the previous allocations are passed back to the
+  allocator, so that it doesn't need to record them.*/
+typedef struct {
+    /*allocates "size" bytes, returns NULL on failure*/
+    void* (*allocFunc)(void* context, size_t size);
+    /*resizes the allocation "ptr" of "oldSize" bytes to "newSize" bytes, keeping its content.
+      returns NULL on failure, the old allocation is kept in that case*/
+    void* (*reallocFunc)(void* context, void* ptr, size_t oldSize, size_t newSize);
+    /*releases the allocation "ptr" of "size" bytes*/
+    void  (*freeFunc)(void* context, void* ptr, size_t size);
+    /*user data passed to the functions*/
+    void* context;
+} cAllocator;
+
+/* Allocates memory with the given allocator.
+	\param pAllocator : allocator pointer, NULL for the standard library
+	\param size       : size in bytes
+	\return           : pointer of the allocation, NULL on failure*/
+void*   cAllocator_alloc(const cAllocator* pAllocator, size_t size);
+
+/* Resizes memory allocated with the given allocator.
+	\param pAllocator : allocator pointer, NULL for the standard library
+	\param ptr        : pointer of the allocation
+	\param oldSize    : current size in bytes
+	\param newSize    : requested size in bytes
+	\return           : pointer of the allocation, NULL on failure*/
+void*   cAllocator_realloc(const cAllocator* pAllocator, void* ptr, size_t oldSize, size_t newSize);
+
+/* Releases memory allocated with the given allocator.
+	\param pAllocator : allocator pointer, NULL for the standard library
+	\param ptr        : pointer of the allocation, may be NULL
+	\param size       : size in bytes
+	\return           : none*/
+void    cAllocator_free(const cAllocator* pAllocator, void* ptr, size_t size);
+
+/* Allocates memory at the given alignment with the given allocator. The allocator is asked for
+   "align" bytes more than the size, and the address of its allocation is kept just before the
+   aligned one.
+	\param pAllocator : allocator pointer, NULL for the standard library
+	\param size       : size in bytes
+	\param align      : alignment in bytes, a power of 2. 0 or an alignment the allocator already
+                        gives (that of the fundamental types) is the same as cAllocator_alloc
+	\return           : pointer of the allocation, NULL on failure*/
+void*   cAllocator_allocAligned(const cAllocator* pAllocator, size_t size, size_t align);
+
+/* Resizes memory allocated by cAllocator_allocAligned, keeping its alignment.
+	\param pAllocator : allocator pointer, NULL for the standard library
+	\param ptr        : pointer of the allocation
+	\param oldSize    : current size in bytes
+	\param newSize    : requested size in bytes
+	\param align      : alignment the memory was allocated with
+	\return           : pointer of the allocation, NULL on failure*/
+void*   cAllocator_reallocAligned(const cAllocator* pAllocator, void* ptr, size_t oldSize, size_t newSize, size_t align);
+
+/* Releases memory allocated by cAllocator_allocAligned.
+	\param pAllocator : allocator pointer, NULL for the standard library
+	\param ptr        : pointer of the allocation, may be NULL
+	\param size       : size in bytes
+	\param align      : alignment the memory was allocated with
+	\return           : none*/
+void    cAllocator_freeAligned(const cAllocator* pAllocator, void* ptr, size_t size, size_t align);
+
+
+/*cArena type.
+ These members are intended to be private.
+ DO NOT MODIFY THE VALUES DIRECTLY!*/
+typedef struct {
+    /*allocator interface of the arena*/
+    cAllocator allocator;
+    /*minimum size of the blocks in bytes*/
+    size_t blockSize;
+    /*list of the allocated blocks, the current one first*/
+    void* blockList;
+    /*the last allocation, which can be resized or released in place*/
+    void* lastAlloc;
+} cArena;
+
+/* Initializes an arena. No memory is allocated until the first request.
+	\param pArena    : cArena instance pointer
+	\param blockSize : minimum size of the blocks taken from the standard library
+	\return          : none*/
+void    cArena_init(cArena* pArena, size_t blockSize);
+
+/* Returns the allocator interface of the arena, to be given to the containers.
+	\param pArena : cArena instance pointer
+	\return       : allocator pointer*/
+const cAllocator* cArena_allocator(cArena* pArena);
+
+/* Releases all of the allocations of the arena at once.
+	\param pArena : cArena instance pointer
+	\return       : none*/
+void    cArena_release(cArena* pArena);
+
+
+/*cPool type.
+ These members are intended to be private.
+ DO NOT MODIFY THE VALUES DIRECTLY!*/
+typedef struct {
+    /*allocator interface of the pool*/
+    cAllocator allocator;
+    /*size of the blocks in bytes*/
+    size_t blockSize;
+    /*number of the blocks allocated at once*/
+    size_t blocksPerChunk;
+    /*list of the free blocks*/
+    void* freeList;
+    /*list of the allocated chunks*/
+    void* chunkList;
+    /*list of the allocations larger than the block size*/
+    void* largeList;
+} cPool;
+
+/* Initializes a pool. No memory is allocated until the first request.
+	\param pPool          : cPool instance pointer
+	\param blockSize      : size of the blocks in bytes
+	\param blocksPerChunk : number of the blocks taken from the standard library at once
+	\return               : none*/
+void    cPool_init(cPool* pPool, size_t blockSize, size_t blocksPerChunk);
+
+/* Returns the allocator interface of the pool, to be given to the containers.
+	\param pPool : cPool instance pointer
+	\return      : allocator pointer*/
+const cAllocator* cPool_allocator(cPool* pPool);
+
+/* Releases all of the allocations of the pool at once.
+	\param pPool : cPool instance pointer
+	\return      : none*/
+void    cPool_release(cPool* pPool);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
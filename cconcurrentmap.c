@@ -0,0 +1,227 @@
+/*Reader-writer locks are hidden by the strict ANSI modes of the POSIX headers*/
+#if !defined(_WIN32) && !defined(_POSIX_C_SOURCE) && !defined(_XOPEN_SOURCE)
+#define _POSIX_C_SOURCE 200112L
+#endif
+
+#include <stdlib.h>
+#include <string.h>
+#include <limits.h>
+#include <stdint.h>
+#include "cconcurrentmap.h"
+
+/*Platform reader-writer lock operations*/
+#if defined(_WIN32)
+#define CCONCURRENTMAP_LOCK_INIT(pLock)         (InitializeSRWLock(pLock), 0)
+#define CCONCURRENTMAP_LOCK_DESTROY(pLock)      ((void)(pLock))
+#define CCONCURRENTMAP_READ_LOCK(pLock)         AcquireSRWLockShared(pLock)
+#define CCONCURRENTMAP_READ_UNLOCK(pLock)       ReleaseSRWLockShared(pLock)
+#define CCONCURRENTMAP_WRITE_LOCK(pLock)        AcquireSRWLockExclusive(pLock)
+#define CCONCURRENTMAP_WRITE_UNLOCK(pLock)      ReleaseSRWLockExclusive(pLock)
+#else
+#define CCONCURRENTMAP_LOCK_INIT(pLock)         pthread_rwlock_init((pLock), NULL)
+#define CCONCURRENTMAP_LOCK_DESTROY(pLock)      ((void)pthread_rwlock_destroy(pLock))
+#define CCONCURRENTMAP_READ_LOCK(pLock)         ((void)pthread_rwlock_rdlock(pLock))
+#define CCONCURRENTMAP_READ_UNLOCK(pLock)       ((void)pthread_rwlock_unlock(pLock))
+#define CCONCURRENTMAP_WRITE_LOCK(pLock)        ((void)pthread_rwlock_wrlock(pLock))
+#define CCONCURRENTMAP_WRITE_UNLOCK(pLock)      ((void)pthread_rwlock_unlock(pLock))
+#endif
+
+/*Number of the bits of a hash value*/
+#define CCONCURRENTMAP_HASH_BITS                (sizeof(size_t) * CHAR_BIT)
+
+/*Multiplier of the Fibonacci hashing mixing the hash before the shard is taken, 2^N / golden ratio*/
+#if SIZE_MAX > 0xFFFFFFFFUL
+#define CCONCURRENTMAP_HASH_MIX                 ((size_t)(0x9E3779B97F4A7C15ULL))
+#else
+#define CCONCURRENTMAP_HASH_MIX                 ((size_t)(0x9E3779B9UL))
+#endif
+
+/*Returns the shard of the given key. The shard is taken from the high bits of the hash,
+  since the slot of the shard's hash index is taken from its low bits. The hash is multiplied
+  by CCONCURRENTMAP_HASH_MIX first, so that its low bits reach the high ones and the hash
+  functions varying only in their low bits (e.g. the identity) still spread over the shards.*/
+static cConcurrentMapShard* cConcurrentMap_shardOf(const cConcurrentMap* pInstance, const void* key)
+{
+    size_t shardIdx = (size_t)(0);
+
+    if((size_t)(1) < pInstance->shardCount)
+    {
+        shardIdx = (pInstance->hashFunc(key, pInstance->shardArray[0].map.keySize) * CCONCURRENTMAP_HASH_MIX) >> pInstance->shardShift;
+    }
+
+    return &(pInstance->shardArray[shardIdx]);
+}
+
+int 	cConcurrentMap_find(cConcurrentMap* pInstance, const void* key, void* value)
+{
+    int result = -1;
+
+    if(NULL != key)
+    {
+        cConcurrentMapShard* pShard = cConcurrentMap_shardOf(pInstance, key);
+        cPair pair;
+
+        CCONCURRENTMAP_READ_LOCK(&(pShard->lock));
+
+        if(0 == cMap_find(&(pShard->map), key, &pair))
+        {
+            if(NULL != value)
+            {
+                memcpy(value, pair.second, pShard->map.valueSize);
+            }
+            result = 0;
+        }
+
+        CCONCURRENTMAP_READ_UNLOCK(&(pShard->lock));
+    }
+
+    return result;
+}
+
+int 	cConcurrentMap_insert(cConcurrentMap* pInstance, const void* key, const void* value)
+{
+    int result = -1;
+
+    if((NULL != key) && (NULL != value))
+    {
+        cConcurrentMapShard* pShard = cConcurrentMap_shardOf(pInstance, key);
+        cPair pair;
+
+        pair.first  = (void*)key;
+        pair.second = (void*)value;
+
+        CCONCURRENTMAP_WRITE_LOCK(&(pShard->lock));
+        result = cMap_insert(&(pShard->map), &pair);
+        CCONCURRENTMAP_WRITE_UNLOCK(&(pShard->lock));
+    }
+
+    return result;
+}
+
+int 	cConcurrentMap_erase(cConcurrentMap* pInstance, const void* key)
+{
+    int result = -1;
+
+    if(NULL != key)
+    {
+        cConcurrentMapShard* pShard = cConcurrentMap_shardOf(pInstance, key);
+
+        CCONCURRENTMAP_WRITE_LOCK(&(pShard->lock));
+        result = cMap_erase(&(pShard->map), key);
+        CCONCURRENTMAP_WRITE_UNLOCK(&(pShard->lock));
+    }
+
+    return result;
+}
+
+size_t 	cConcurrentMap_size(cConcurrentMap* pInstance)
+{
+    size_t totalSize = (size_t)(0);
+    size_t shardIdx;
+
+    for(shardIdx = 0; shardIdx < pInstance->shardCount; ++shardIdx)
+    {
+        cConcurrentMapShard* pShard = &(pInstance->shardArray[shardIdx]);
+
+        CCONCURRENTMAP_READ_LOCK(&(pShard->lock));
+        totalSize += cMap_size(&(pShard->map));
+        CCONCURRENTMAP_READ_UNLOCK(&(pShard->lock));
+    }
+
+    return totalSize;
+}
+
+void 	cConcurrentMap_clear(cConcurrentMap* pInstance)
+{
+    size_t shardIdx;
+
+    for(shardIdx = 0; shardIdx < pInstance->shardCount; ++shardIdx)
+    {
+        cConcurrentMapShard* pShard = &(pInstance->shardArray[shardIdx]);
+
+        CCONCURRENTMAP_WRITE_LOCK(&(pShard->lock));
+        cMap_clear(&(pShard->map));
+        CCONCURRENTMAP_WRITE_UNLOCK(&(pShard->lock));
+    }
+}
+
+void 	cConcurrentMap_destroy(cConcurrentMap* pInstance)
+{
+    if(NULL != pInstance->shardArray)
+    {
+        size_t shardIdx;
+
+        for(shardIdx = 0; shardIdx < pInstance->shardCount; ++shardIdx)
+        {
+            cMap_clear(&(pInstance->shardArray[shardIdx].map));
+            CCONCURRENTMAP_LOCK_DESTROY(&(pInstance->shardArray[shardIdx].lock));
+        }
+
+        free((void*)pInstance->shardArray);
+        pInstance->shardArray = NULL;
+    }
+
+    pInstance->shardCount = (size_t)(0);
+}
+
+int concreteConstructCConcurrentMap(cConcurrentMap* instance, size_t keySize, size_t valueSize, size_t shardCount,
+                                    cMapHashFunc hashFunc, cMapCompareFunc compareFunc)
+{
+    int result = -1;
+
+    if(NULL != instance)
+    {
+        size_t shardBits = (size_t)(0);
+
+        if((size_t)(0) == shardCount)
+        {
+            shardCount = CCONCURRENTMAP_DEFAULT_SHARD_COUNT;
+        }
+
+        /*Round up to a power of 2*/
+        while(((size_t)(1) << shardBits) < shardCount)
+        {
+            ++shardBits;
+        }
+
+        instance->shardCount = (size_t)(1) << shardBits;
+        instance->shardShift = CCONCURRENTMAP_HASH_BITS - shardBits;
+        instance->hashFunc   = (NULL != hashFunc) ? hashFunc : cMap_defaultHash;
+        instance->shardArray = (cConcurrentMapShard*)malloc(instance->shardCount * sizeof(cConcurrentMapShard));
+
+        if(NULL != instance->shardArray)
+        {
+            size_t shardIdx;
+
+            result = 0;
+
+            for(shardIdx = 0; shardIdx < instance->shardCount; ++shardIdx)
+            {
+                concreteConstructCHashMap(&(instance->shardArray[shardIdx].map), keySize, valueSize, instance->hashFunc, compareFunc);
+                cMap_setSharedReads(&(instance->shardArray[shardIdx].map));
+
+                if(0 != CCONCURRENTMAP_LOCK_INIT(&(instance->shardArray[shardIdx].lock)))
+                {
+                    /*Release the locks initialized so far*/
+                    while((size_t)(0) < shardIdx)
+                    {
+                        --shardIdx;
+                        CCONCURRENTMAP_LOCK_DESTROY(&(instance->shardArray[shardIdx].lock));
+                    }
+
+                    free((void*)instance->shardArray);
+                    instance->shardArray = NULL;
+                    instance->shardCount = (size_t)(0);
+                    result = -1;
+                    break;
+                }
+            }
+        }
+        else
+        {
+            instance->shardCount = (size_t)(0);
+        }
+    }
+
+    return result;
+}
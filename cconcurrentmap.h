@@ -0,0 +1,141 @@
+ /*
+ Sharded concurrent map implementation
+
+ It is a thread safe map built on hashed cMap instances. The keys are distributed to a power of 2
+ number of shards by the high bits of their hash values, and each shard is guarded by its own
+ reader-writer lock. Readers never block each other, and writers block only the threads working
+ on the same shard, instead of the whole map.
+
+ Since the pairs of a shard may be moved by a concurrent insert or erase, the methods copy the
+ values in and out under the lock instead of returning pointers into the map.
+
+ NOTE: Unlike the other containers, it relies on the platform threads (POSIX threads, or SRW locks
+ on Windows) and should be deallocated by using "destroy" method at the end of its use. In the
+ strict ANSI modes of the compilers, the sources including this header should define
+ _POSIX_C_SOURCE as 200112L or later, to make pthread_rwlock_t visible.
+
+ Authors: akozan
+
+ Change Log:
+ 16.10.2026 first release
+ ------------------------------------------------------------------------------------------------*/
+
+
+#ifndef CCONCURRENTMAP_H
+#define CCONCURRENTMAP_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stddef.h>
+#include "cmap.h"
+
+#if defined(_WIN32)
+#include <windows.h>
+/*reader-writer lock of a shard*/
+typedef SRWLOCK cConcurrentMapLock;
+#else
+#include <pthread.h>
+/*reader-writer lock of a shard*/
+typedef pthread_rwlock_t cConcurrentMapLock;
+#endif
+
+/*Size of the cache line the shards are padded to*/
+#ifndef CCONCURRENTMAP_CACHE_LINE_SIZE
+#define CCONCURRENTMAP_CACHE_LINE_SIZE      64
+#endif
+
+/*Number of the shards used when 0 is given to the constructor*/
+#define CCONCURRENTMAP_DEFAULT_SHARD_COUNT  ((size_t)(16))
+
+/*Shard of a cConcurrentMap, a hashed cMap with its lock. The padding keeps the locks of
+  the neighbour shards in different cache lines.*/
+typedef struct {
+     cConcurrentMapLock lock;
+     cMap map;
+     char padding[CCONCURRENTMAP_CACHE_LINE_SIZE];
+} cConcurrentMapShard;
+
+typedef struct cConcurrentMapType cConcurrentMap;
+
+/*cConcurrentMap type.
+ These members are intended to be private.
+ DO NOT MODIFY THE VALUES DIRECTLY!*/
+struct cConcurrentMapType{
+     /*array of the shards*/
+     cConcurrentMapShard* shardArray;
+     /*number of the shards, always a power of 2*/
+     size_t shardCount;
+     /*right shift of a hash value giving its shard*/
+     size_t shardShift;
+     /*hash function of the keys*/
+     cMapHashFunc hashFunc;
+};
+
+/* Copies the value of the given key.
+	\param instance : cConcurrentMap instance pointer
+	\param key 		: pointer of the key.
+	\param value 	: buffer of valueSize bytes receiving the value, may be NULL to test the key only
+	\return 		: result: 0 = Success, -1 = Failure (the key is not found)*/
+int 	cConcurrentMap_find(cConcurrentMap* pInstance, const void* key, void* value);
+
+/* Adds the given pair, or overwrites the value if the key exists.
+	\param instance : cConcurrentMap instance pointer
+	\param key 		: pointer of the key.
+	\param value 	: pointer of the value.
+	\return 		: result: 0 = Success, -1 = Failure*/
+int 	cConcurrentMap_insert(cConcurrentMap* pInstance, const void* key, const void* value);
+
+/* Deletes the pair containing given key.
+	\param instance : cConcurrentMap instance pointer
+	\param key 		: pointer of the key.
+	\return 		: result: 0 = Success, -1 = Failure*/
+int 	cConcurrentMap_erase(cConcurrentMap* pInstance, const void* key);
+
+/* Returns the number of pairs in the map. While the other threads are working, it
+   is only a snapshot, since the shards are counted one by one.
+	\param instance : cConcurrentMap instance pointer
+	\return 		: number of pairs*/
+size_t 	cConcurrentMap_size(cConcurrentMap* pInstance);
+
+/* Clears all of the shards.
+	\param instance : cConcurrentMap instance pointer
+	\return 		: none.*/
+void 	cConcurrentMap_clear(cConcurrentMap* pInstance);
+
+/* Clears the map and releases its shards and locks. The map must not be in use by
+   any other thread.
+	\param instance : cConcurrentMap instance pointer
+	\return 		: none.*/
+void 	cConcurrentMap_destroy(cConcurrentMap* pInstance);
+
+
+/*---------------------------------------------------------------------------*/
+/*This function constructs an allocated cConcurrentMap object. Need to call after
+  the creation of object. Unlike the other constructors it allocates the shards,
+  so it may fail.
+  \param instance 	 : allocated cConcurrentMap pointer to be constructed
+  \param keySize 	 : size of the key type
+  \param valueSize 	 : size of the value type
+  \param shardCount  : number of the shards, rounded up to a power of 2. 0 for
+                       CCONCURRENTMAP_DEFAULT_SHARD_COUNT
+  \param hashFunc 	 : hash function of the keys, NULL for cMap_defaultHash. The shard is taken
+                       from the high bits of the mixed hash and the slot in the shard from its
+                       low bits, so the low bits must vary between the keys
+  \param compareFunc : comparison function of the keys, NULL for bytewise comparison
+  \return		  	 : result: 0 = Success, -1 = Failure*/
+int concreteConstructCConcurrentMap(cConcurrentMap* instance, size_t keySize, size_t valueSize, size_t shardCount,
+                                    cMapHashFunc hashFunc, cMapCompareFunc compareFunc);
+
+/*This is a macro wrapper for "concreteConstructCConcurrentMap" function, provides creation using
+typenames. (C++ template logic)*/
+#define constructCConcurrentMap(instance, TYPE1, TYPE2, shardCount, hashFunc, compareFunc)\
+        concreteConstructCConcurrentMap(instance, sizeof(TYPE1), sizeof(TYPE2), shardCount, hashFunc, compareFunc)
+/*---------------------------------------------------------------------------*/
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,199 @@
+#include <stdlib.h>
+#include <string.h>
+#include "cdeque.h"
+
+/*This macro defines the initial allocation size of the deques, in terms of element count.
+  The array is doubled whenever it is full, so it must be a power of 2.*/
+#define CDEQUE_MIN_ALLOC_SIZE                   ((size_t)(8))
+
+/*Gives the position of the element at the index "idx" in the circular array*/
+#define CDEQUE_CALC_POS(pInstance, idx)         (((pInstance)->head + (idx)) & ((pInstance)->allocSize - 1))
+
+/*Gives the pointer integer value of the array element at the specified position
+  Why not to return directly the void pointer? That's because we need the
+  pointer address value in integer to perform pointer arithmetics on void
+  pointers.*/
+#define CDEQUE_CALC_POS_PTR_VAL(pInstance, pos) ((size_t)((pInstance)->array) + (pos)*((pInstance)->elemSizeAligned))
+
+/* This macro gets "size" and returns "align"ed size */
+#define CDEQUE_ALIGN_SIZE(size, align)  ((size) % (align)) ? ((size) + ((align) - ((size) % (align)))) : (size)
+
+
+/*Moves the elements into a new array of "newAllocSize" elements, unwrapping them so that
+  the first element is placed at the start of the new array.
+  \return : result: 0 = Success, -1 = Failure*/
+static int cDeque_resize(cDeque* pInstance, const size_t newAllocSize)
+{
+    int result = -1;
+    void* newArrayPtr = cAllocator_alloc(pInstance->allocator, (newAllocSize * pInstance->elemSizeAligned));
+
+    if(NULL != newArrayPtr)
+    {
+        if((size_t)(0) < pInstance->dequeSize)
+        {
+            const size_t headCount = ((pInstance->allocSize - pInstance->head) < pInstance->dequeSize) ?
+                                     (pInstance->allocSize - pInstance->head) : pInstance->dequeSize;
+
+            memcpy(newArrayPtr, (const void*)CDEQUE_CALC_POS_PTR_VAL(pInstance, pInstance->head), (headCount * pInstance->elemSizeAligned));
+
+            if(headCount < pInstance->dequeSize)
+            {
+                /*The elements wrapped to the start of the old array follow them*/
+                memcpy((void*)((size_t)newArrayPtr + (headCount * pInstance->elemSizeAligned)), pInstance->array,
+                       ((pInstance->dequeSize - headCount) * pInstance->elemSizeAligned));
+            }
+        }
+
+        if(NULL != pInstance->array)
+        {
+            cAllocator_free(pInstance->allocator, pInstance->array, (pInstance->allocSize * pInstance->elemSizeAligned));
+        }
+
+        pInstance->array = newArrayPtr;
+        pInstance->allocSize = newAllocSize;
+        pInstance->head = (size_t)(0);
+        result = 0;
+    }
+
+    return result;
+}
+
+/*Makes the array able to hold "count" elements, doubling it as required.
+  \return : result: 0 = Success, -1 = Failure*/
+static int cDeque_reserveFor(cDeque* pInstance, const size_t count)
+{
+    int result = 0;
+
+    if(count > pInstance->allocSize)
+    {
+        size_t newAllocSize = ((size_t)(0) == pInstance->allocSize) ? CDEQUE_MIN_ALLOC_SIZE : pInstance->allocSize;
+
+        while(newAllocSize < count)
+        {
+            newAllocSize *= (size_t)(2);
+        }
+
+        result = cDeque_resize(pInstance, newAllocSize);
+    }
+
+    return result;
+}
+
+void* 	cDeque_getAt(cDeque* pInstance, const size_t idx)
+{
+    return (idx < pInstance->dequeSize) ? (void*)CDEQUE_CALC_POS_PTR_VAL(pInstance, CDEQUE_CALC_POS(pInstance, idx)) : NULL;
+}
+
+size_t 	cDeque_size(const cDeque* pInstance)
+{
+    return pInstance->dequeSize;
+}
+
+void 	cDeque_clear(cDeque* pInstance)
+{
+    if(NULL != pInstance->array)
+    {
+        cAllocator_free(pInstance->allocator, pInstance->array, (pInstance->allocSize * pInstance->elemSizeAligned));
+        pInstance->array = NULL;
+    }
+
+    pInstance->dequeSize = (size_t)(0);
+    pInstance->allocSize = (size_t)(0);
+    pInstance->head = (size_t)(0);
+}
+
+int 	cDeque_pushf(cDeque* pInstance, const void* newElem)
+{
+    int result = -1;
+
+    if(NULL != newElem)
+    {
+        if(0 == cDeque_reserveFor(pInstance, pInstance->dequeSize + 1))
+        {
+            pInstance->head = (pInstance->head - 1) & (pInstance->allocSize - 1);
+            memcpy((void*)CDEQUE_CALC_POS_PTR_VAL(pInstance, pInstance->head), newElem, pInstance->elemSize);
+            ++(pInstance->dequeSize);
+            result = 0;
+        }
+    }
+
+    return result;
+}
+
+int 	cDeque_pushb(cDeque* pInstance, const void* newElem)
+{
+    int result = -1;
+
+    if(NULL != newElem)
+    {
+        if(0 == cDeque_reserveFor(pInstance, pInstance->dequeSize + 1))
+        {
+            memcpy((void*)CDEQUE_CALC_POS_PTR_VAL(pInstance, CDEQUE_CALC_POS(pInstance, pInstance->dequeSize)), newElem, pInstance->elemSize);
+            ++(pInstance->dequeSize);
+            result = 0;
+        }
+    }
+
+    return result;
+}
+
+int 	cDeque_popf(cDeque* pInstance)
+{
+    int result = -1;
+
+    if((size_t)(0) < pInstance->dequeSize)
+    {
+        pInstance->head = CDEQUE_CALC_POS(pInstance, 1);
+        --(pInstance->dequeSize);
+        result = 0;
+    }
+
+    return result;
+}
+
+int 	cDeque_popb(cDeque* pInstance)
+{
+    int result = -1;
+
+    if((size_t)(0) < pInstance->dequeSize)
+    {
+        --(pInstance->dequeSize);
+        result = 0;
+    }
+
+    return result;
+}
+
+int 	cDeque_reserve(cDeque* pInstance, const size_t count)
+{
+    return cDeque_reserveFor(pInstance, count);
+}
+
+int 	cDeque_setAllocator(cDeque* pInstance, const cAllocator* pAllocator)
+{
+    int result = -1;
+
+    if(NULL == pInstance->array)
+    {
+        pInstance->allocator = pAllocator;
+        result = 0;
+    }
+
+    return result;
+}
+
+void concreteConstructCDeque(cDeque* instance, size_t elemSize)
+{
+    if(NULL != instance)
+    {
+        const size_t alignSize = sizeof(int);
+
+        instance->elemSize  = elemSize;
+        instance->elemSizeAligned = CDEQUE_ALIGN_SIZE(instance->elemSize, alignSize);
+        instance->dequeSize = (size_t)(0);
+        instance->allocSize = (size_t)(0);
+        instance->head      = (size_t)(0);
+        instance->array     = NULL;
+        instance->allocator = NULL;
+    }
+}
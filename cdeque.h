@@ -0,0 +1,143 @@
+ /*
+ ANSI C Ring buffer deque implementation
+
+ It is created as an alternative to C++ STL <deque> container class. Elements are kept in a
+ circular buffer with a head index, so that push and pop run in O(1) time at both ends,
+ unlike cVector_pushf/cVector_popf which shift the whole array. Some template methods in
+ C++ <deque> which utilize Value type are alternatively implemented using void* arguments
+ and cDeque.elemSize element.
+
+ NOTE: Since cDeque allocates elements in heap, it should be deallocated by using "clear" method at
+ the end of the scope, no matter if cDeque is created on stack. Since this is a struct implementation
+ and won't be destructed automatically while returning from the scope,
+ the responsibility of destruction of the object is on the user.
+
+ Authors: akozan
+
+ Change Log:
+ 16.10.2026 first release
+ ------------------------------------------------------------------------------------------------*/
+
+
+#ifndef CDEQUE_H
+#define CDEQUE_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stddef.h>
+#include "callocator.h"
+
+typedef struct cDequeType cDeque;
+
+/*cDeque type.
+ NOTE: the implementation is not
+ concealed to make it able to allocate on
+ stack (not the array, only the struct itself).
+ These members are intended to be private.
+ DO NOT MODIFY THE VALUES DIRECTLY!*/
+struct cDequeType{
+	 /*size of the element type in bytes*/
+     size_t elemSize;
+     /*aligned elemSize in bytes*/
+     size_t elemSizeAligned;
+	 /*number of the elements*/
+     size_t dequeSize;
+	 /*deque allocation size, in terms of elements. Always 0 or a power of 2*/
+     size_t allocSize;
+     /*position of the first element in the array*/
+     size_t head;
+	 /*circular array of the recorded elements*/
+     void* array;
+     /*allocator of the array, NULL for the standard library*/
+     const cAllocator* allocator;
+};
+
+/* Returns the element at the index "idx", counted from the front of the deque.
+	\param instance : cDeque instance pointer
+	\param idx 		: index value.
+	\return 		: the element at the index "idx". if the index is invalid, returns NULL*/
+void* 	cDeque_getAt(cDeque* pInstance, const size_t idx);
+
+/* Returns the number of elements in the deque.
+	\param instance : cDeque instance pointer
+	\return 		: number of elements*/
+size_t 	cDeque_size(const cDeque* pInstance);
+
+/* Clears the deque and releases its array.
+	\param instance : cDeque instance pointer
+	\return 		: none.*/
+void 	cDeque_clear(cDeque* pInstance);
+
+/* Adds new element to the start of the deque.
+	\param instance : cDeque instance pointer
+	\param newElem	: pointer of the element to be added.
+	\return 		: result: 0 = Success, -1 = Failure*/
+int 	cDeque_pushf(cDeque* pInstance, const void* newElem);
+
+/* Adds new element to the end of the deque.
+	\param instance : cDeque instance pointer
+	\param newElem	: pointer of the element to be added.
+	\return 		: result: 0 = Success, -1 = Failure*/
+int 	cDeque_pushb(cDeque* pInstance, const void* newElem);
+
+/* Clears the element at the start of the deque.
+	\param instance : cDeque instance pointer
+	\return 		: result: 0 = Success, -1 = Failure*/
+int 	cDeque_popf(cDeque* pInstance);
+
+/* Clears the element at the end of the deque.
+	\param instance : cDeque instance pointer
+	\return 		: result: 0 = Success, -1 = Failure*/
+int 	cDeque_popb(cDeque* pInstance);
+
+/* Makes the deque able to hold "count" elements without any reallocation.
+   The allocation size is rounded up to a power of 2.
+	\param instance : cDeque instance pointer
+	\param count 	: number of the elements.
+	\return 		: result: 0 = Success, -1 = Failure*/
+int 	cDeque_reserve(cDeque* pInstance, const size_t count);
+
+/* Sets the allocator of the deque. It should be called after the construction,
+   before the first element is added.
+	\param instance   : cDeque instance pointer
+	\param pAllocator : allocator pointer, NULL for the standard library. It must
+                         outlive the deque.
+	\return 		  : result: 0 = Success, -1 = Failure (the array is already allocated)*/
+int 	cDeque_setAllocator(cDeque* pInstance, const cAllocator* pAllocator);
+
+/* Macro Extensions */
+/*---------------------------------------------------------------------------*/
+/* Returns the element at the start of the deque, NULL if empty.
+	\param instance : cDeque instance pointer
+	\return 		: pointer of the element*/
+#define cDeque_front(pInstance)\
+        cDeque_getAt(pInstance, (size_t)0)
+
+/* Returns the element at the end of the deque, NULL if empty.
+	\param instance : cDeque instance pointer
+	\return 		: pointer of the element*/
+#define cDeque_back(pInstance)\
+        cDeque_getAt(pInstance, ((pInstance)->dequeSize - 1))
+/*---------------------------------------------------------------------------*/
+
+
+/*---------------------------------------------------------------------------*/
+/*This function constructs an allocated cDeque object. Need to call after
+  the creation of object.
+  \param instance 	: allocated cDeque pointer to be constructed
+  \param elemSize 	: size of the element type
+  \return		  	: none*/
+void concreteConstructCDeque(cDeque* instance, size_t elemSize);
+
+/*This is a macro wrapper for "concreteConstructCDeque" function, provides creation
+using typenames. (C++ template logic)*/
+#define constructCDeque(instance, TYPE)  concreteConstructCDeque(instance, sizeof(TYPE))
+/*---------------------------------------------------------------------------*/
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
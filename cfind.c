@@ -0,0 +1,199 @@
+#include <string.h>
+#include "cfind.h"
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#define CFIND_USE_AVX2
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && (_M_IX86_FP >= 2))
+#include <emmintrin.h>
+#define CFIND_USE_SSE2
+#endif
+
+/*Maximum stride handled by the kernels*/
+#define CFIND_MAX_STRIDE        ((size_t)(8))
+
+/*Gives the pointer integer value of the element at the specified index*/
+#define CFIND_CALC_IDX_PTR_VAL(array, stride, idx)     ((size_t)(array) + (idx)*(stride))
+
+
+#if defined(CFIND_USE_AVX2) || defined(CFIND_USE_SSE2)
+/*Returns the index of the lowest set bit of a nonzero value*/
+static unsigned int cFind_lowestBit(unsigned int value)
+{
+#if defined(__GNUC__)
+    return (unsigned int)__builtin_ctz(value);
+#else
+    unsigned int bit = 0;
+    while(0 == (value & 1U))
+    {
+        value >>= 1;
+        ++bit;
+    }
+    return bit;
+#endif
+}
+#endif
+
+#if defined(CFIND_USE_AVX2)
+/*Scans the elements by 32 bytes, returns the number of the scanned elements.
+  *pFound is set if the element at the returned index matches.*/
+static size_t cFind_vectorScan(const unsigned char* array, const size_t count, const size_t stride,
+                               const unsigned char* pattern, const unsigned char* mask, int* pFound)
+{
+    const size_t laneCount = 32 / stride;
+    const __m256i patternVect = _mm256_loadu_si256((const __m256i*)pattern);
+    const __m256i maskVect = _mm256_loadu_si256((const __m256i*)mask);
+    size_t idx;
+
+    *pFound = 0;
+
+    for(idx = 0; (idx + laneCount) <= count; idx += laneCount)
+    {
+        const __m256i data = _mm256_and_si256(_mm256_loadu_si256((const __m256i*)(array + (idx * stride))), maskVect);
+        __m256i cmp;
+        unsigned int bits;
+
+        switch(stride)
+        {
+            case 1:  cmp = _mm256_cmpeq_epi8(data, patternVect);  break;
+            case 2:  cmp = _mm256_cmpeq_epi16(data, patternVect); break;
+            case 4:  cmp = _mm256_cmpeq_epi32(data, patternVect); break;
+            default: cmp = _mm256_cmpeq_epi64(data, patternVect); break;
+        }
+
+        bits = (unsigned int)_mm256_movemask_epi8(cmp);
+
+        if(0U != bits)
+        {
+            *pFound = 1;
+            idx += (cFind_lowestBit(bits) / (unsigned int)stride);
+            break;
+        }
+    }
+
+    return idx;
+}
+#elif defined(CFIND_USE_SSE2)
+/*Turns the byte mask of a vector comparison into the lane mask of 8 byte elements,
+  a lane is matched only if all of its 8 bytes are matched. Each lane is represented by
+  its lowest byte bit, so that the index of the lowest bit / 8 gives the lane.*/
+static unsigned int cFind_qwordLanes(unsigned int byteMask, const unsigned int laneCount)
+{
+    unsigned int laneMask = 0;
+    unsigned int lane;
+
+    for(lane = 0; lane < laneCount; ++lane)
+    {
+        if(0xFFU == ((byteMask >> (lane * 8U)) & 0xFFU))
+        {
+            laneMask |= (1U << (lane * 8U));
+        }
+    }
+
+    return laneMask;
+}
+/*Scans the elements by 16 bytes, returns the number of the scanned elements.
+  *pFound is set if the element at the returned index matches.*/
+static size_t cFind_vectorScan(const unsigned char* array, const size_t count, const size_t stride,
+                               const unsigned char* pattern, const unsigned char* mask, int* pFound)
+{
+    const size_t laneCount = 16 / stride;
+    const __m128i patternVect = _mm_loadu_si128((const __m128i*)pattern);
+    const __m128i maskVect = _mm_loadu_si128((const __m128i*)mask);
+    size_t idx;
+
+    *pFound = 0;
+
+    for(idx = 0; (idx + laneCount) <= count; idx += laneCount)
+    {
+        const __m128i data = _mm_and_si128(_mm_loadu_si128((const __m128i*)(array + (idx * stride))), maskVect);
+        unsigned int bits;
+
+        switch(stride)
+        {
+            case 1:  bits = (unsigned int)_mm_movemask_epi8(_mm_cmpeq_epi8(data, patternVect));  break;
+            case 2:  bits = (unsigned int)_mm_movemask_epi8(_mm_cmpeq_epi16(data, patternVect)); break;
+            case 4:  bits = (unsigned int)_mm_movemask_epi8(_mm_cmpeq_epi32(data, patternVect)); break;
+            /*SSE2 has no 64 bit comparison, both of the 32 bit halves must match*/
+            default: bits = cFind_qwordLanes((unsigned int)_mm_movemask_epi8(_mm_cmpeq_epi32(data, patternVect)), 2U); break;
+        }
+
+        if(0U != bits)
+        {
+            *pFound = 1;
+            idx += (cFind_lowestBit(bits) / (unsigned int)stride);
+            break;
+        }
+    }
+
+    return idx;
+}
+#endif
+
+size_t  cFind_first(const void* array, size_t count, size_t stride, const void* key, size_t keySize)
+{
+    size_t idx = 0;
+    /*set when the result is known, so that the generic comparison below is skipped*/
+    int done = 0;
+
+    if((NULL == array) || (NULL == key) || (keySize > stride))
+    {
+        idx = count;
+    }
+    else if((stride <= CFIND_MAX_STRIDE) && (0 == (stride & (stride - 1))))
+    {
+        /*Key bytes repeated for every lane, with a mask clearing the padding bytes*/
+        unsigned char pattern[32];
+        unsigned char mask[32];
+        size_t byteIdx;
+
+        for(byteIdx = 0; byteIdx < sizeof(pattern); ++byteIdx)
+        {
+            const size_t laneByte = byteIdx % stride;
+            pattern[byteIdx] = (laneByte < keySize) ? ((const unsigned char*)key)[laneByte] : (unsigned char)(0);
+            mask[byteIdx]    = (laneByte < keySize) ? (unsigned char)(0xFF) : (unsigned char)(0);
+        }
+
+#if defined(CFIND_USE_AVX2) || defined(CFIND_USE_SSE2)
+        idx = cFind_vectorScan((const unsigned char*)array, count, stride, pattern, mask, &done);
+#endif
+
+        if((0 == done) && (4 == sizeof(unsigned int)) && ((size_t)(4) <= stride))
+        {
+            /*Portable path and the tail of the vector path, compare 32 bit words of the elements*/
+            unsigned int patternWords[2];
+            unsigned int maskWords[2];
+            const size_t wordCount = stride / 4;
+
+            memcpy(patternWords, pattern, sizeof(patternWords));
+            memcpy(maskWords, mask, sizeof(maskWords));
+
+            for(; idx < count; ++idx)
+            {
+                unsigned int words[2];
+                memcpy(words, (const void*)CFIND_CALC_IDX_PTR_VAL(array, stride, idx), stride);
+
+                if(((words[0] & maskWords[0]) == patternWords[0]) &&
+                   ((1 == wordCount) || ((words[1] & maskWords[1]) == patternWords[1])))
+                {
+                    break;
+                }
+            }
+
+            done = 1;
+        }
+    }
+
+    if(0 == done)
+    {
+        for(; idx < count; ++idx)
+        {
+            if(0 == memcmp(key, (const void*)CFIND_CALC_IDX_PTR_VAL(array, stride, idx), keySize))
+            {
+                break;
+            }
+        }
+    }
+
+    return idx;
+}
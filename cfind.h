@@ -0,0 +1,39 @@
+/*
+ ANSI C search kernels of the containers
+ 
+ The containers search their arrays by comparing the key bytes of each element. For the
+ elements placed 1, 2, 4 or 8 bytes apart, the kernels given here compare a whole SIMD
+ register of elements per instruction: 16 bytes with SSE2 and 32 bytes with AVX2. The
+ instruction set is chosen at compile time (e.g. -mavx2), and a portable word by word
+ comparison is used on the other targets. The other element sizes are compared by memcmp.
+
+ Authors: akozan
+ 
+ Change Log:
+ 16.10.2026 first release
+ ------------------------------------------------------------------------------------------------*/
+
+
+#ifndef CFIND_H
+#define CFIND_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stddef.h>
+
+/* Returns the index of the first element whose first "keySize" bytes are equal to the key.
+	\param array    : pointer of the first element
+	\param count    : number of the elements
+	\param stride   : distance between the elements in bytes
+	\param key      : pointer of the key
+	\param keySize  : number of the compared bytes, not greater than stride
+	\return         : the index of the element. if not found, returns count*/
+size_t  cFind_first(const void* array, size_t count, size_t stride, const void* key, size_t keySize);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -1,11 +1,12 @@
 #include <stdlib.h>
 #include <string.h>
 #include "cmap.h"
+#include "cfind.h"
 
-/*This macro defines the power value used in calculation of map allocation size, in terms of pair count.
-If given 1, the insert and erase methods will reallocate the map whenever an element is
-added or removed.
-Otherwise, these methods will reallocate the map if required, with the nearest power of the
+/*This macro defines the default power value used in calculation of map allocation size, in terms of pair count.
+It can be changed per instance by cMap_setPolicy.
+If given 1, the insert method will reallocate the map whenever an element is added.
+Otherwise, it will reallocate the map if required, with the nearest power of the
 CMAP_ALLOC_POWER_SIZE.
 The value 2 will make it work in the same allocation strategy with C++ std::vector container.
 It provides lesser memory fragmentation.
@@ -14,17 +15,811 @@ NOTE: Do not define it as 0!
 #define CMAP_ALLOC_POWER_SIZE 2
 #define CMAP_ALLOC_POWER_SIZE_RND ((size_t)(CMAP_ALLOC_POWER_SIZE))
 
+/*This macro defines the default shrink divisor of the maps. The erase method shrinks the map
+when it is less than 1/CMAP_SHRINK_DIVISOR full. CPOLICY_NEVER_SHRINK disables the shrinking.*/
+#define CMAP_SHRINK_DIVISOR ((size_t)(4))
+
 /*Gives the pointer integer value of the array element at the specified index
   Why not to return directly the void pointer? That's because we need the
   pointer address value in integer to perform pointer arithmetics on void
   pointers.
 */
-#define CMAP_CALC_KEY_IDX_PTR_VAL(pInstance, idx)    ((size_t)((pInstance)->pairArray) + (idx)*((pInstance)->elemSize))
-#define CMAP_CALC_VAL_IDX_PTR_VAL(pInstance, idx)    (CMAP_CALC_KEY_IDX_PTR_VAL(pInstance, idx) + ((pInstance)->keySizeAligned))
+#define CMAP_CALC_KEY_IDX_PTR_VAL(pInstance, idx)    ((size_t)((pInstance)->pairArray) + (idx)*((pInstance)->keyStride))
+#define CMAP_CALC_VAL_IDX_PTR_VAL(pInstance, idx)    ((size_t)((pInstance)->pairArray) + ((pInstance)->valueOffset) + (idx)*((pInstance)->valueStride))
+
+/*Gives the offset of the first value in pairArray for the given allocation size. The values
+  follow the keys region in the structure of arrays layout, or the first key otherwise.*/
+#define CMAP_CALC_VAL_OFFSET(pInstance, allocationSize)  ((0 != ((pInstance)->flags & CMAP_FLAG_SOA_LAYOUT)) ?\
+        ((allocationSize) * ((pInstance)->keySizeAligned)) : ((pInstance)->keySizeAligned))
 
 /* This macro gets "size" and returns "align"ed size */
 #define CMAP_ALIGN_SIZE(size, align)  ((size) % (align)) ? ((size) + ((align) - ((size) % (align)))) : (size)
 
+/*Tells whether the value is a power of 2*/
+#define CMAP_IS_POWER_OF_2(value)     (((size_t)(0) != (value)) && ((size_t)(0) == ((value) & ((value) - 1))))
+
+/*Private flag of the maps read by several threads at once, see cMap_setSharedReads*/
+#define CMAP_FLAG_SHARED_READS      (0x80U)
+
+/*Tells whether the lookups not modifying the map are counted in the statistics*/
+#define CMAP_IS_READ_COUNTED(pInstance)  (0 == ((pInstance)->flags & CMAP_FLAG_SHARED_READS))
+
+/*Compares two keys of the map, either by the compare function or bytewise*/
+#define CMAP_COMPARE_KEYS(pInstance, key1, key2)  ((NULL != (pInstance)->compareFunc) ?\
+        (pInstance)->compareFunc((key1), (key2), (pInstance)->keySize) : memcmp((key1), (key2), (pInstance)->keySize))
+
+/*These macros define the maximum load factor of the hash index, as
+CMAP_HASH_LOAD_NUM / CMAP_HASH_LOAD_DEN. The index is doubled before the number of the pairs
+exceeds it. Linear probing keeps short probe sequences below 3/4 load.*/
+#define CMAP_HASH_LOAD_NUM          ((size_t)(3))
+#define CMAP_HASH_LOAD_DEN          ((size_t)(4))
+/*Initial number of the slots of the hash index, must be a power of 2*/
+#define CMAP_HASH_MIN_INDEX_SIZE    ((size_t)(8))
+
+/*Number of the keys looked up together by cMap_findBatch. The memory accesses of a group
+are prefetched one stage ahead of their use, so it should cover the memory latency.*/
+#define CMAP_BATCH_GROUP_SIZE       ((size_t)(16))
+/*Size of the pairArray blocks scanned for all of the keys of a group in the linear mode,
+in bytes. A block stays in the L1 cache while it is compared with each key.*/
+#define CMAP_BATCH_SCAN_BLOCK_SIZE  ((size_t)(8192))
+
+/*Prefetches the cache line of the given address for a read*/
+#if defined(__GNUC__)
+#define CMAP_PREFETCH(ptr)          __builtin_prefetch((const void*)(ptr), 0, 3)
+#elif defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+#include <xmmintrin.h>
+#define CMAP_PREFETCH(ptr)          _mm_prefetch((const char*)(ptr), _MM_HINT_T0)
+#else
+#define CMAP_PREFETCH(ptr)          ((void)(ptr))
+#endif
+
+
+/*Returns the slot of the given key in the hash index. If the key is not found,
+  the returned slot is the empty one where it should be placed and *pFound is 0.
+  The lookup is counted in the statistics only if isCounted is nonzero.*/
+static size_t cMap_hashProbe(cMap* pInstance, const void* key, int* pFound, const int isCounted)
+{
+    const size_t mask = pInstance->hashIndexSize - 1;
+    size_t slot = pInstance->hashFunc(key, pInstance->keySize) & mask;
+
+    *pFound = 0;
+    if(0 != isCounted)
+    {
+        CSTATS_ADD(pInstance, findCount, 1);
+    }
+
+    while(0 != pInstance->hashIndex[slot])
+    {
+        if(0 != isCounted)
+        {
+            CSTATS_ADD(pInstance, compareCount, 1);
+        }
+
+        if(0 == CMAP_COMPARE_KEYS(pInstance, key, (const void*)CMAP_CALC_KEY_IDX_PTR_VAL(pInstance, pInstance->hashIndex[slot] - 1)))
+        {
+            *pFound = 1;
+            break;
+        }
+        slot = (slot + 1) & mask;
+    }
+
+    return slot;
+}
+
+/*Reallocates the hash index with "newIndexSize" slots and reinserts all of the pairs.
+  \return : result: 0 = Success, -1 = Failure*/
+static int cMap_hashRebuild(cMap* pInstance, const size_t newIndexSize)
+{
+    int result = -1;
+    size_t* newIndex = (size_t*)cAllocator_alloc(pInstance->allocator, (newIndexSize * sizeof(size_t)));
+
+    if(NULL != newIndex)
+    {
+        const size_t mask = newIndexSize - 1;
+        size_t idx;
+
+        memset((void*)newIndex, 0, (newIndexSize * sizeof(size_t)));
+
+        for(idx = 0; idx < pInstance->mapSize; ++idx)
+        {
+            size_t slot = pInstance->hashFunc((const void*)CMAP_CALC_KEY_IDX_PTR_VAL(pInstance, idx), pInstance->keySize) & mask;
+
+            while(0 != newIndex[slot])
+            {
+                slot = (slot + 1) & mask;
+            }
+            newIndex[slot] = idx + 1;
+        }
+
+        cAllocator_free(pInstance->allocator, (void*)pInstance->hashIndex, (pInstance->hashIndexSize * sizeof(size_t)));
+        pInstance->hashIndex = newIndex;
+        pInstance->hashIndexSize = newIndexSize;
+        CSTATS_ALLOC(pInstance, pInstance->allocationSize, 1);
+        result = 0;
+    }
+
+    return result;
+}
+
+/*Returns the smallest index size holding "count" pairs within the maximum load factor.*/
+static size_t cMap_hashIndexSizeFor(const size_t count)
+{
+    size_t indexSize = CMAP_HASH_MIN_INDEX_SIZE;
+
+    while((count * CMAP_HASH_LOAD_DEN) > (indexSize * CMAP_HASH_LOAD_NUM))
+    {
+        indexSize *= (size_t)(2);
+    }
+
+    return indexSize;
+}
+
+/*Makes the hash index able to hold "count" pairs within the maximum load factor.
+  \return : result: 0 = Success, -1 = Failure*/
+static int cMap_hashReserve(cMap* pInstance, const size_t count)
+{
+    int result = 0;
+    const size_t newIndexSize = cMap_hashIndexSizeFor(count);
+
+    if(NULL == pInstance->hashIndex)
+    {
+        result = cMap_hashRebuild(pInstance, newIndexSize);
+    }
+    else if(newIndexSize > pInstance->hashIndexSize)
+    {
+        result = cMap_hashRebuild(pInstance, newIndexSize);
+    }
+
+    return result;
+}
+
+/*Empties the given slot of the hash index by shifting the following entries of the
+  probe sequence backwards, so that no tombstones are needed.*/
+static void cMap_hashRemoveSlot(cMap* pInstance, size_t slot)
+{
+    const size_t mask = pInstance->hashIndexSize - 1;
+    size_t next = (slot + 1) & mask;
+
+    while(0 != pInstance->hashIndex[next])
+    {
+        const size_t home = pInstance->hashFunc((const void*)CMAP_CALC_KEY_IDX_PTR_VAL(pInstance, pInstance->hashIndex[next] - 1), pInstance->keySize) & mask;
+
+        /*The entry can fill the hole only if the hole lies between its home slot and itself*/
+        if(((next - home) & mask) >= ((next - slot) & mask))
+        {
+            pInstance->hashIndex[slot] = pInstance->hashIndex[next];
+            slot = next;
+        }
+        next = (next + 1) & mask;
+    }
+
+    pInstance->hashIndex[slot] = 0;
+}
+
+/*Returns the index of the first pair whose key is not ordered before the given key,
+  by binary search. *pFound is set if the key at that index equals the given key.
+  The lookup is counted in the statistics only if isCounted is nonzero.*/
+static size_t cMap_sortedSearch(cMap* pInstance, const void* key, int* pFound, const int isCounted)
+{
+    size_t first = 0;
+    size_t count = pInstance->mapSize;
+
+    if(0 != isCounted)
+    {
+        CSTATS_ADD(pInstance, findCount, 1);
+    }
+
+    while((size_t)(0) < count)
+    {
+        const size_t step = count / 2;
+
+        if(0 != isCounted)
+        {
+            CSTATS_ADD(pInstance, compareCount, 1);
+        }
+
+        if(0 > CMAP_COMPARE_KEYS(pInstance, (const void*)CMAP_CALC_KEY_IDX_PTR_VAL(pInstance, first + step), key))
+        {
+            first += step + 1;
+            count -= step + 1;
+        }
+        else
+        {
+            count = step;
+        }
+    }
+
+    *pFound = (first < pInstance->mapSize) && (0 == CMAP_COMPARE_KEYS(pInstance, (const void*)CMAP_CALC_KEY_IDX_PTR_VAL(pInstance, first), key));
+
+    return first;
+}
+
+/*Returns the index of the given key in a linear map by scanning pairArray, mapSize if it is
+  not found. The lookup is counted in the statistics only if isCounted is nonzero.*/
+static size_t cMap_linearSearch(cMap* pInstance, const void* key, const int isCounted)
+{
+    size_t idx;
+
+    if(NULL == pInstance->compareFunc)
+    {
+        idx = cFind_first(pInstance->pairArray, pInstance->mapSize, pInstance->keyStride, key, pInstance->keySize);
+    }
+    else
+    {
+        for(idx = 0; idx < pInstance->mapSize; ++idx)
+        {
+            if(0 == CMAP_COMPARE_KEYS(pInstance, key, (void*)CMAP_CALC_KEY_IDX_PTR_VAL(pInstance, idx)))
+            {
+                break;
+            }
+        }
+    }
+
+    if(0 != isCounted)
+    {
+        CSTATS_ADD(pInstance, findCount, 1);
+        CSTATS_ADD(pInstance, compareCount, (idx < pInstance->mapSize) ? (idx + 1) : idx);
+    }
+
+    return idx;
+}
+
+/*Moves "count" pairs from the index "srcIdx" to the index "dstIdx" of pairArray.
+  The ranges may overlap.*/
+static void cMap_movePairs(cMap* pInstance, const size_t dstIdx, const size_t srcIdx, const size_t count)
+{
+    if(0 != (pInstance->flags & CMAP_FLAG_SOA_LAYOUT))
+    {
+        memmove((void*)CMAP_CALC_KEY_IDX_PTR_VAL(pInstance, dstIdx), (const void*)CMAP_CALC_KEY_IDX_PTR_VAL(pInstance, srcIdx), (count * pInstance->keySizeAligned));
+        memmove((void*)CMAP_CALC_VAL_IDX_PTR_VAL(pInstance, dstIdx), (const void*)CMAP_CALC_VAL_IDX_PTR_VAL(pInstance, srcIdx), (count * pInstance->valueSizeAligned));
+    }
+    else
+    {
+        memmove((void*)CMAP_CALC_KEY_IDX_PTR_VAL(pInstance, dstIdx), (const void*)CMAP_CALC_KEY_IDX_PTR_VAL(pInstance, srcIdx), (count * pInstance->elemSize));
+    }
+
+    CSTATS_ADD(pInstance, bytesMoved, count * pInstance->elemSize);
+}
+
+/*Moves the values region of a structure of arrays pairArray to its offset for the given
+  allocation size. The values are moved down before a shrinking reallocation and up
+  after a growing one.*/
+static void cMap_moveValues(cMap* pInstance, const size_t allocationSize)
+{
+    const size_t newValueOffset = CMAP_CALC_VAL_OFFSET(pInstance, allocationSize);
+
+    if(newValueOffset != pInstance->valueOffset)
+    {
+        memmove((void*)((size_t)(pInstance->pairArray) + newValueOffset), (const void*)CMAP_CALC_VAL_IDX_PTR_VAL(pInstance, 0), (pInstance->mapSize * pInstance->valueSizeAligned));
+        pInstance->valueOffset = newValueOffset;
+    }
+}
+
+/*Reallocates pairArray with "newAllocationSize" pairs, or releases it if zero.
+  \return : result: 0 = Success, -1 = Failure*/
+static int cMap_resize(cMap* pInstance, const size_t newAllocationSize)
+{
+    int result = 0;
+
+    if((size_t)(0) == newAllocationSize)
+    {
+        if(NULL != pInstance->pairArray)
+        {
+            cAllocator_freeAligned(pInstance->allocator, pInstance->pairArray, (pInstance->elemSize * pInstance->allocationSize), pInstance->baseAlign);
+            CSTATS_ALLOC(pInstance, (size_t)(0), (NULL != pInstance->hashIndex));
+        }
+        pInstance->pairArray = NULL;
+        pInstance->allocationSize = (size_t)(0);
+        pInstance->valueOffset = CMAP_CALC_VAL_OFFSET(pInstance, 0);
+    }
+    else if(newAllocationSize != pInstance->allocationSize)
+    {
+        const int isSoA = (0 != (pInstance->flags & CMAP_FLAG_SOA_LAYOUT));
+        void* newArrayPtr;
+
+        if(NULL == pInstance->pairArray)
+        {
+            newArrayPtr = cAllocator_allocAligned(pInstance->allocator, (pInstance->elemSize * newAllocationSize), pInstance->baseAlign);
+        }
+        else
+        {
+            if(isSoA && (newAllocationSize < pInstance->allocationSize))
+            {
+                cMap_moveValues(pInstance, newAllocationSize);
+            }
+
+            newArrayPtr = cAllocator_reallocAligned(pInstance->allocator, pInstance->pairArray, (pInstance->elemSize * pInstance->allocationSize), (pInstance->elemSize * newAllocationSize), pInstance->baseAlign);
+        }
+
+        if(NULL != newArrayPtr)
+        {
+            pInstance->pairArray = newArrayPtr;
+
+            if(isSoA)
+            {
+                cMap_moveValues(pInstance, newAllocationSize);
+            }
+
+            pInstance->allocationSize = newAllocationSize;
+            CSTATS_ALLOC(pInstance, newAllocationSize, 1);
+        }
+        else
+        {
+            if(isSoA && (NULL != pInstance->pairArray))
+            {
+                /*Shrinking failed, the values go back to the end of the whole keys region*/
+                cMap_moveValues(pInstance, pInstance->allocationSize);
+            }
+
+            result = -1;
+        }
+    }
+
+    return result;
+}
+
+/*Makes pairArray able to hold "count" pairs, growing it with the nearest power of the
+  growth factor in a single reallocation.
+  \return : result: 0 = Success, -1 = Failure*/
+static int cMap_reserveFor(cMap* pInstance, const size_t count)
+{
+    int result = 0;
+
+    if(count > pInstance->allocationSize)
+    {
+        const size_t growthFactor = pInstance->policy.growthFactor;
+        size_t newAllocationSize = ((size_t)(0) == pInstance->allocationSize) ? growthFactor : pInstance->allocationSize;
+
+        if((size_t)(1) < growthFactor)
+        {
+            /*Allocate space with the nearest power*/
+            while(newAllocationSize < count)
+            {
+                newAllocationSize *= growthFactor;
+            }
+        }
+        else if(newAllocationSize < count)
+        {
+            newAllocationSize = count;
+        }
+
+        result = cMap_resize(pInstance, newAllocationSize);
+    }
+
+    return result;
+}
+
+/*Shrinks pairArray after an erase according to the growth policy. It is divided by
+  the growth factor while it is less than 1/shrinkDivisor full, but it is never shrunk
+  below the initial allocation size.*/
+static void cMap_shrinkAfterErase(cMap* pInstance)
+{
+    if(CPOLICY_NEVER_SHRINK != pInstance->policy.shrinkDivisor)
+    {
+        const size_t growthFactor = pInstance->policy.growthFactor;
+        size_t newAllocationSize = pInstance->allocationSize;
+
+        while((pInstance->mapSize * pInstance->policy.shrinkDivisor) < newAllocationSize)
+        {
+            size_t nextAllocationSize = ((size_t)(1) < growthFactor) ? (newAllocationSize / growthFactor) : pInstance->mapSize;
+
+            if(nextAllocationSize < growthFactor)
+            {
+                nextAllocationSize = growthFactor;
+            }
+
+            if((nextAllocationSize < pInstance->mapSize) || (nextAllocationSize >= newAllocationSize))
+            {
+                break;
+            }
+
+            newAllocationSize = nextAllocationSize;
+        }
+
+        /*Shrinking realloc keeps pairArray on failure, so the result is not needed*/
+        (void)cMap_resize(pInstance, newAllocationSize);
+    }
+}
+
+/*Gives the pointer integer value of the key/value at the specified index of the caller's
+  key and value arrays in batch operations.*/
+#define CMAP_CALC_BATCH_KEY_PTR_VAL(pInstance, keys, idx)       ((size_t)(keys) + (idx)*((pInstance)->keySize))
+#define CMAP_CALC_BATCH_VAL_PTR_VAL(pInstance, values, idx)     ((size_t)(values) + (idx)*((pInstance)->valueSize))
+
+/*Inserts the batch through the hash index. The index and pairArray are reserved once,
+  so each pair costs a single probe.
+  \return : result: 0 = Success, -1 = Failure*/
+static int cMap_hashInsertBatch(cMap* pInstance, const void* keys, const void* values, const size_t count)
+{
+    int result = -1;
+
+    if((0 == cMap_hashReserve(pInstance, pInstance->mapSize + count)) &&
+       (0 == cMap_reserveFor(pInstance, pInstance->mapSize + count)))
+    {
+        size_t batchIdx;
+
+        for(batchIdx = 0; batchIdx < count; ++batchIdx)
+        {
+            int found;
+            const void* key = (const void*)CMAP_CALC_BATCH_KEY_PTR_VAL(pInstance, keys, batchIdx);
+            const size_t slot = cMap_hashProbe(pInstance, key, &found, 1);
+            size_t idx;
+
+            if(0 != found)
+            {
+                idx = pInstance->hashIndex[slot] - 1;
+            }
+            else
+            {
+                idx = pInstance->mapSize;
+                memcpy((void*)CMAP_CALC_KEY_IDX_PTR_VAL(pInstance, idx), key, pInstance->keySize);
+
+                ++pInstance->mapSize;
+                pInstance->hashIndex[slot] = pInstance->mapSize;
+            }
+
+            memcpy((void*)CMAP_CALC_VAL_IDX_PTR_VAL(pInstance, idx), (const void*)CMAP_CALC_BATCH_VAL_PTR_VAL(pInstance, values, batchIdx), pInstance->valueSize);
+        }
+
+        result = 0;
+    }
+
+    return result;
+}
+
+/*Sorts the batch positions in "order" by their keys with a stable bottom-up merge sort,
+  using "temp" as the work area. Both arrays have "count" elements.*/
+static void cMap_sortBatchOrder(const cMap* pInstance, const void* keys, size_t* order, size_t* temp, const size_t count)
+{
+    size_t width;
+    size_t* src = order;
+    size_t* dst = temp;
+
+    for(width = 1; width < count; width *= 2)
+    {
+        size_t start;
+
+        for(start = 0; start < count; start += 2 * width)
+        {
+            const size_t mid = ((start + width) < count) ? (start + width) : count;
+            const size_t end = ((start + 2 * width) < count) ? (start + 2 * width) : count;
+            size_t left = start;
+            size_t right = mid;
+            size_t out = start;
+
+            while(out < end)
+            {
+                if((left < mid) &&
+                   ((right >= end) || (0 >= CMAP_COMPARE_KEYS(pInstance, (const void*)CMAP_CALC_BATCH_KEY_PTR_VAL(pInstance, keys, src[left]), (const void*)CMAP_CALC_BATCH_KEY_PTR_VAL(pInstance, keys, src[right])))))
+                {
+                    dst[out++] = src[left++];
+                }
+                else
+                {
+                    dst[out++] = src[right++];
+                }
+            }
+        }
+
+        {
+            size_t* swap = src;
+            src = dst;
+            dst = swap;
+        }
+    }
+
+    if(src != order)
+    {
+        memcpy(order, src, count * sizeof(size_t));
+    }
+}
+
+/*Inserts the batch into a sorted map: the batch is sorted once, duplicates are dropped
+  keeping the last one, and the new pairs are merged into pairArray from its end in a
+  single sweep.
+  \return : result: 0 = Success, -1 = Failure*/
+static int cMap_sortedInsertBatch(cMap* pInstance, const void* keys, const void* values, const size_t count)
+{
+    int result = -1;
+    size_t* order = (size_t*)cAllocator_alloc(pInstance->allocator, (2 * count * sizeof(size_t)));
+
+    if(NULL != order)
+    {
+        /*"existing" keeps the pair index of the keys already in the map, or mapSize if new*/
+        size_t* existing = order + count;
+        size_t uniqueCount = 0;
+        size_t newCount = 0;
+        size_t batchIdx;
+
+        for(batchIdx = 0; batchIdx < count; ++batchIdx)
+        {
+            order[batchIdx] = batchIdx;
+        }
+
+        cMap_sortBatchOrder(pInstance, keys, order, existing, count);
+
+        /*Keep the last one of the equal keys, like the repeated inserts would do*/
+        for(batchIdx = 0; batchIdx < count; ++batchIdx)
+        {
+            if(((batchIdx + 1) == count) ||
+               (0 != CMAP_COMPARE_KEYS(pInstance, (const void*)CMAP_CALC_BATCH_KEY_PTR_VAL(pInstance, keys, order[batchIdx]), (const void*)CMAP_CALC_BATCH_KEY_PTR_VAL(pInstance, keys, order[batchIdx + 1]))))
+            {
+                int found;
+                const size_t idx = cMap_sortedSearch(pInstance, (const void*)CMAP_CALC_BATCH_KEY_PTR_VAL(pInstance, keys, order[batchIdx]), &found, 1);
+
+                order[uniqueCount] = order[batchIdx];
+                existing[uniqueCount] = (0 != found) ? idx : pInstance->mapSize;
+                newCount += (0 != found) ? 0 : 1;
+                ++uniqueCount;
+            }
+        }
+
+        if(0 == cMap_reserveFor(pInstance, pInstance->mapSize + newCount))
+        {
+            size_t mapIdx = pInstance->mapSize;
+            size_t outIdx = pInstance->mapSize + newCount;
+
+            for(batchIdx = uniqueCount; batchIdx > 0; --batchIdx)
+            {
+                const size_t srcIdx = order[batchIdx - 1];
+
+                if(existing[batchIdx - 1] < pInstance->mapSize)
+                {
+                    memcpy((void*)CMAP_CALC_VAL_IDX_PTR_VAL(pInstance, existing[batchIdx - 1]), (const void*)CMAP_CALC_BATCH_VAL_PTR_VAL(pInstance, values, srcIdx), pInstance->valueSize);
+                    continue;
+                }
+
+                /*Move the greater pairs of the map to their final place, then put the new one*/
+                while((mapIdx > 0) &&
+                      (0 < CMAP_COMPARE_KEYS(pInstance, (const void*)CMAP_CALC_KEY_IDX_PTR_VAL(pInstance, mapIdx - 1), (const void*)CMAP_CALC_BATCH_KEY_PTR_VAL(pInstance, keys, srcIdx))))
+                {
+                    --mapIdx;
+                    --outIdx;
+                    cMap_movePairs(pInstance, outIdx, mapIdx, 1);
+                }
+
+                --outIdx;
+                memcpy((void*)CMAP_CALC_KEY_IDX_PTR_VAL(pInstance, outIdx), (const void*)CMAP_CALC_BATCH_KEY_PTR_VAL(pInstance, keys, srcIdx), pInstance->keySize);
+                memcpy((void*)CMAP_CALC_VAL_IDX_PTR_VAL(pInstance, outIdx), (const void*)CMAP_CALC_BATCH_VAL_PTR_VAL(pInstance, values, srcIdx), pInstance->valueSize);
+            }
+
+            pInstance->mapSize += newCount;
+            result = 0;
+        }
+
+        cAllocator_free(pInstance->allocator, (void*)order, (2 * count * sizeof(size_t)));
+    }
+
+    return result;
+}
+
+/*Sets the result of a batch lookup to the pair at the index "idx", or to NULLs if it is mapSize*/
+static void cMap_setBatchResult(const cMap* pInstance, const size_t idx, cPair* pResult)
+{
+    if(idx < pInstance->mapSize)
+    {
+        pResult->first  = (void*)CMAP_CALC_KEY_IDX_PTR_VAL(pInstance, idx);
+        pResult->second = (void*)CMAP_CALC_VAL_IDX_PTR_VAL(pInstance, idx);
+    }
+    else
+    {
+        pResult->first  = NULL;
+        pResult->second = NULL;
+    }
+}
+
+/*Looks up a group of keys in the hash index by group prefetching: the home slots of all of
+  the keys are prefetched first, then the pairs they point to, and the probes run last on
+  the lines already on their way to the cache.*/
+static void cMap_hashFindGroup(cMap* pInstance, const void* keys, const size_t count, cPair* results)
+{
+    const int isCounted = CMAP_IS_READ_COUNTED(pInstance);
+    const size_t mask = pInstance->hashIndexSize - 1;
+    size_t slotList[CMAP_BATCH_GROUP_SIZE];
+    size_t groupIdx;
+
+    for(groupIdx = 0; groupIdx < count; ++groupIdx)
+    {
+        slotList[groupIdx] = pInstance->hashFunc((const void*)CMAP_CALC_BATCH_KEY_PTR_VAL(pInstance, keys, groupIdx), pInstance->keySize) & mask;
+        CMAP_PREFETCH(&(pInstance->hashIndex[slotList[groupIdx]]));
+    }
+
+    for(groupIdx = 0; groupIdx < count; ++groupIdx)
+    {
+        const size_t entry = pInstance->hashIndex[slotList[groupIdx]];
+
+        if(0 != entry)
+        {
+            CMAP_PREFETCH(CMAP_CALC_KEY_IDX_PTR_VAL(pInstance, entry - 1));
+        }
+    }
+
+    for(groupIdx = 0; groupIdx < count; ++groupIdx)
+    {
+        const void* key = (const void*)CMAP_CALC_BATCH_KEY_PTR_VAL(pInstance, keys, groupIdx);
+        size_t slot = slotList[groupIdx];
+        size_t idx = pInstance->mapSize;
+
+        if(0 != isCounted)
+        {
+            CSTATS_ADD(pInstance, findCount, 1);
+        }
+
+        while(0 != pInstance->hashIndex[slot])
+        {
+            if(0 != isCounted)
+            {
+                CSTATS_ADD(pInstance, compareCount, 1);
+            }
+
+            if(0 == CMAP_COMPARE_KEYS(pInstance, key, (const void*)CMAP_CALC_KEY_IDX_PTR_VAL(pInstance, pInstance->hashIndex[slot] - 1)))
+            {
+                idx = pInstance->hashIndex[slot] - 1;
+                break;
+            }
+            slot = (slot + 1) & mask;
+        }
+
+        cMap_setBatchResult(pInstance, idx, &results[groupIdx]);
+    }
+}
+
+/*Looks up a group of keys in a sorted map by interleaved binary searches. Each round takes
+  one step of every search and prefetches the key the search compares in the next round.*/
+static void cMap_sortedFindGroup(cMap* pInstance, const void* keys, const size_t count, cPair* results)
+{
+    const int isCounted = CMAP_IS_READ_COUNTED(pInstance);
+    size_t firstList[CMAP_BATCH_GROUP_SIZE];
+    size_t countList[CMAP_BATCH_GROUP_SIZE];
+    size_t activeCount = count;
+    size_t groupIdx;
+
+    for(groupIdx = 0; groupIdx < count; ++groupIdx)
+    {
+        firstList[groupIdx] = 0;
+        countList[groupIdx] = pInstance->mapSize;
+        if(0 != isCounted)
+        {
+            CSTATS_ADD(pInstance, findCount, 1);
+        }
+    }
+
+    while((size_t)(0) < activeCount)
+    {
+        activeCount = 0;
+
+        for(groupIdx = 0; groupIdx < count; ++groupIdx)
+        {
+            if((size_t)(0) < countList[groupIdx])
+            {
+                const size_t step = countList[groupIdx] / 2;
+
+                if(0 != isCounted)
+                {
+                    CSTATS_ADD(pInstance, compareCount, 1);
+                }
+
+                if(0 > CMAP_COMPARE_KEYS(pInstance, (const void*)CMAP_CALC_KEY_IDX_PTR_VAL(pInstance, firstList[groupIdx] + step), (const void*)CMAP_CALC_BATCH_KEY_PTR_VAL(pInstance, keys, groupIdx)))
+                {
+                    firstList[groupIdx] += step + 1;
+                    countList[groupIdx] -= step + 1;
+                }
+                else
+                {
+                    countList[groupIdx] = step;
+                }
+
+                if((size_t)(0) < countList[groupIdx])
+                {
+                    CMAP_PREFETCH(CMAP_CALC_KEY_IDX_PTR_VAL(pInstance, firstList[groupIdx] + (countList[groupIdx] / 2)));
+                    ++activeCount;
+                }
+            }
+        }
+    }
+
+    for(groupIdx = 0; groupIdx < count; ++groupIdx)
+    {
+        size_t idx = firstList[groupIdx];
+
+        if((idx < pInstance->mapSize) &&
+           (0 != CMAP_COMPARE_KEYS(pInstance, (const void*)CMAP_CALC_KEY_IDX_PTR_VAL(pInstance, idx), (const void*)CMAP_CALC_BATCH_KEY_PTR_VAL(pInstance, keys, groupIdx))))
+        {
+            idx = pInstance->mapSize;
+        }
+
+        cMap_setBatchResult(pInstance, idx, &results[groupIdx]);
+    }
+}
+
+/*Looks up a group of keys in a linear map. pairArray is scanned once for the whole group in
+  blocks, each block being compared with all of the keys not found yet while it is in the
+  cache, instead of streaming the whole array from the memory for each key.*/
+static void cMap_linearFindGroup(cMap* pInstance, const void* keys, const size_t count, cPair* results)
+{
+    const int isCounted = CMAP_IS_READ_COUNTED(pInstance);
+    const size_t blockCount = (CMAP_BATCH_SCAN_BLOCK_SIZE > pInstance->keyStride) ? (CMAP_BATCH_SCAN_BLOCK_SIZE / pInstance->keyStride) : (size_t)(1);
+    size_t idxList[CMAP_BATCH_GROUP_SIZE];
+    size_t pendingCount = count;
+    size_t blockStart;
+    size_t groupIdx;
+
+    for(groupIdx = 0; groupIdx < count; ++groupIdx)
+    {
+        idxList[groupIdx] = pInstance->mapSize;
+        if(0 != isCounted)
+        {
+            CSTATS_ADD(pInstance, findCount, 1);
+        }
+    }
+
+    for(blockStart = 0; (blockStart < pInstance->mapSize) && ((size_t)(0) < pendingCount); blockStart += blockCount)
+    {
+        const size_t blockSize = ((pInstance->mapSize - blockStart) < blockCount) ? (pInstance->mapSize - blockStart) : blockCount;
+
+        for(groupIdx = 0; groupIdx < count; ++groupIdx)
+        {
+            if(idxList[groupIdx] == pInstance->mapSize)
+            {
+                const void* key = (const void*)CMAP_CALC_BATCH_KEY_PTR_VAL(pInstance, keys, groupIdx);
+                size_t blockIdx;
+
+                if(NULL == pInstance->compareFunc)
+                {
+                    blockIdx = cFind_first((const void*)CMAP_CALC_KEY_IDX_PTR_VAL(pInstance, blockStart), blockSize, pInstance->keyStride, key, pInstance->keySize);
+                }
+                else
+                {
+                    for(blockIdx = 0; blockIdx < blockSize; ++blockIdx)
+                    {
+                        if(0 == CMAP_COMPARE_KEYS(pInstance, key, (const void*)CMAP_CALC_KEY_IDX_PTR_VAL(pInstance, blockStart + blockIdx)))
+                        {
+                            break;
+                        }
+                    }
+                }
+
+                if(0 != isCounted)
+                {
+                    CSTATS_ADD(pInstance, compareCount, (blockIdx < blockSize) ? (blockIdx + 1) : blockSize);
+                }
+
+                if(blockIdx < blockSize)
+                {
+                    idxList[groupIdx] = blockStart + blockIdx;
+                    --pendingCount;
+                }
+            }
+        }
+    }
+
+    for(groupIdx = 0; groupIdx < count; ++groupIdx)
+    {
+        cMap_setBatchResult(pInstance, idxList[groupIdx], &results[groupIdx]);
+    }
+}
+
+size_t  cMap_defaultHash(const void* key, size_t keySize)
+{
+    /*FNV-1a over the key bytes, followed by a finalizer mixing the high bits
+      into the low ones, since the index slot is taken from the low bits*/
+    const unsigned char* bytes = (const unsigned char*)key;
+    size_t hash = (size_t)(2166136261UL);
+    size_t idx;
+
+    for(idx = 0; idx < keySize; ++idx)
+    {
+        hash ^= (size_t)(bytes[idx]);
+        hash *= (size_t)(16777619UL);
+    }
+
+    hash ^= (hash >> 13);
+    hash *= (size_t)(0x5bd1e995UL);
+    hash ^= (hash >> 15);
+
+    return hash;
+}
+
 
 int 	cMap_getAt(cMap* pInstance, const size_t idx, cPair* pPair)
 {
@@ -36,154 +831,532 @@ int 	cMap_getAt(cMap* pInstance, const size_t idx, cPair* pPair)
         {
             pPair->first  = (void*)CMAP_CALC_KEY_IDX_PTR_VAL(pInstance, idx);
             pPair->second = (void*)CMAP_CALC_VAL_IDX_PTR_VAL(pInstance, idx);
-            retVal = 0; 
+            retVal = 0; 
+        }
+    }
+    
+    return retVal;
+}
+
+size_t 	cMap_size(const cMap* pInstance)
+{
+    return pInstance->mapSize;	
+}
+
+void 	cMap_clear(cMap* pInstance)
+{
+    if((NULL != pInstance->pairArray) || (NULL != pInstance->hashIndex))
+    {
+        CSTATS_ALLOC(pInstance, (size_t)(0), 0);
+    }
+
+    if(NULL != pInstance->pairArray)
+    {
+        cAllocator_freeAligned(pInstance->allocator, pInstance->pairArray, (pInstance->elemSize * pInstance->allocationSize), pInstance->baseAlign);
+        pInstance->pairArray = NULL;
+    }
+
+    if(NULL != pInstance->hashIndex)
+    {
+        cAllocator_free(pInstance->allocator, (void*)pInstance->hashIndex, (pInstance->hashIndexSize * sizeof(size_t)));
+        pInstance->hashIndex = NULL;
+    }
+       
+    pInstance->mapSize = (size_t)(0);
+    pInstance->allocationSize = (size_t)(0);
+    pInstance->valueOffset = CMAP_CALC_VAL_OFFSET(pInstance, 0);
+    pInstance->hashIndexSize = (size_t)(0);
+}
+
+int 	cMap_find(cMap* pInstance, const void* key, cPair* pPair)
+{	
+    int retVal = -1;   
+
+    if(NULL != key)
+    {
+        if(NULL != pPair)
+        {
+            size_t idx;
+
+            if(NULL != pInstance->hashFunc)
+            {
+                if(NULL != pInstance->hashIndex)
+                {
+                    int found;
+                    const size_t slot = cMap_hashProbe(pInstance, key, &found, CMAP_IS_READ_COUNTED(pInstance));
+
+                    if(0 != found)
+                    {
+                        idx = pInstance->hashIndex[slot] - 1;
+                        pPair->first  = (void*)CMAP_CALC_KEY_IDX_PTR_VAL(pInstance, idx);
+                        pPair->second = (void*)CMAP_CALC_VAL_IDX_PTR_VAL(pInstance, idx);
+                        retVal = 0;
+                    }
+                }
+            }
+            else if(0 != (pInstance->flags & CMAP_FLAG_SORTED))
+            {
+                int found;
+
+                idx = cMap_sortedSearch(pInstance, key, &found, CMAP_IS_READ_COUNTED(pInstance));
+
+                if(0 != found)
+                {
+                    pPair->first  = (void*)CMAP_CALC_KEY_IDX_PTR_VAL(pInstance, idx);
+                    pPair->second = (void*)CMAP_CALC_VAL_IDX_PTR_VAL(pInstance, idx);
+                    retVal = 0;
+                }
+            }
+            else
+            {
+                idx = cMap_linearSearch(pInstance, key, CMAP_IS_READ_COUNTED(pInstance));
+
+                if(idx < pInstance->mapSize)
+                {
+                    pPair->first  = (void*)CMAP_CALC_KEY_IDX_PTR_VAL(pInstance, idx);
+                    pPair->second = (void*)CMAP_CALC_VAL_IDX_PTR_VAL(pInstance, idx);
+                    retVal = 0;
+                }
+            }
+        } 
+    }
+
+    return retVal;
+}
+
+int 	cMap_emplace(cMap* pInstance, const void* key, cPair* pPair, int* pInserted)
+{
+    int result = -1;
+
+    if((NULL != pInstance) && (NULL != key) && (NULL != pPair))
+    {
+        /*index of the pair of the key once it is found or placed, mapSize on failure*/
+        size_t idx = pInstance->mapSize;
+        int found = 0;
+
+        if(NULL != pInstance->hashFunc)
+        {
+            if(0 == cMap_hashReserve(pInstance, pInstance->mapSize + 1))
+            {
+                const size_t slot = cMap_hashProbe(pInstance, key, &found, 1);
+
+                if(0 != found)
+                {
+                    idx = pInstance->hashIndex[slot] - 1;
+                }
+                else if(0 == cMap_reserveFor(pInstance, pInstance->mapSize + 1))
+                {
+                    idx = pInstance->mapSize;
+                    memcpy((void*)CMAP_CALC_KEY_IDX_PTR_VAL(pInstance, idx), key, pInstance->keySize);
+
+                    ++pInstance->mapSize;
+                    pInstance->hashIndex[slot] = pInstance->mapSize;
+                }
+            }
+        }
+        else if(0 != (pInstance->flags & CMAP_FLAG_SORTED))
+        {
+            const size_t sortedIdx = cMap_sortedSearch(pInstance, key, &found, 1);
+
+            if(0 != found)
+            {
+                idx = sortedIdx;
+            }
+            else if(0 == cMap_reserveFor(pInstance, pInstance->mapSize + 1))
+            {
+                if(sortedIdx < pInstance->mapSize)
+                {
+                    cMap_movePairs(pInstance, sortedIdx + 1, sortedIdx, pInstance->mapSize - sortedIdx);
+                }
+
+                memcpy((void*)CMAP_CALC_KEY_IDX_PTR_VAL(pInstance, sortedIdx), key, pInstance->keySize);
+
+                ++pInstance->mapSize;
+                idx = sortedIdx;
+            }
+        }
+        else
+        {
+            const size_t linearIdx = cMap_linearSearch(pInstance, key, 1);
+
+            if(linearIdx < pInstance->mapSize)
+            {
+                found = 1;
+                idx = linearIdx;
+            }
+            else if(0 == cMap_reserveFor(pInstance, pInstance->mapSize + 1))
+            {
+                idx = pInstance->mapSize;
+                memcpy((void*)CMAP_CALC_KEY_IDX_PTR_VAL(pInstance, idx), key, pInstance->keySize);
+
+                ++pInstance->mapSize;
+            }
+        }
+
+        if(idx < pInstance->mapSize)
+        {
+            pPair->first  = (void*)CMAP_CALC_KEY_IDX_PTR_VAL(pInstance, idx);
+            pPair->second = (void*)CMAP_CALC_VAL_IDX_PTR_VAL(pInstance, idx);
+
+            if(NULL != pInserted)
+            {
+                *pInserted = (0 != found) ? 0 : 1;
+            }
+
+            CSTATS_ADD(pInstance, insertCount, 1);
+            result = 0;
         }
     }
-    
-    return retVal;
-}
 
-size_t 	cMap_size(const cMap* pInstance)
-{
-    return pInstance->mapSize;	
+    return result;
 }
 
-void 	cMap_clear(cMap* pInstance)
+int	cMap_insert(cMap* pInstance, const cPair* newPair)
 {
-    if(NULL != pInstance->pairArray)
-    {
-        free(pInstance->pairArray);
-        pInstance->pairArray = NULL;
-    }
-       
-    pInstance->mapSize = (size_t)(0);
-    pInstance->allocationSize = (size_t)(0);
-}
-
-int 	cMap_find(cMap* pInstance, const void* key, cPair* pPair)
-{	
-    int retVal = -1;   
+    int result = -1;
 
-    if(NULL != key)
+    if(NULL != newPair)
     {
-        if(NULL != pPair)
-        {
-            size_t idx;
+        cPair pair;
 
-            for(idx = 0; idx < pInstance->mapSize; ++idx)
-            {
-                if(0 == memcmp(key, (void*)CMAP_CALC_KEY_IDX_PTR_VAL(pInstance, idx), pInstance->keySize))
-                {
-                    pPair->first  = (void*)CMAP_CALC_KEY_IDX_PTR_VAL(pInstance, idx);
-                    pPair->second = (void*)CMAP_CALC_VAL_IDX_PTR_VAL(pInstance, idx);
-                    retVal = 0;
-                    break;
-                }		
-            }	
-        } 
+        if(0 == cMap_emplace(pInstance, newPair->first, &pair, NULL))
+        {
+            memcpy(pair.second, newPair->second, pInstance->valueSize);
+            result = 0;
+        }
     }
 
-    return retVal;
+    return result;
 }
 
-int	cMap_insert(cMap* pInstance, const cPair* newPair)
+int 	cMap_erase(cMap* pInstance, const void* key)
 {
     int result = -1;
     
-    if(NULL != pInstance)
+    if((NULL != key) && ((size_t)(0) < pInstance->mapSize))
     {
-        if(NULL != newPair)
+        size_t idx = pInstance->mapSize;
+
+        if(NULL != pInstance->hashFunc)
         {
-            cPair checkPair;
-            
-            if(0 == cMap_find(pInstance, newPair->first, &checkPair))
+            int found;
+            const size_t slot = cMap_hashProbe(pInstance, key, &found, 1);
+
+            if(0 != found)
             {
-                memcpy(checkPair.second, newPair->second, pInstance->valueSizeAligned);
+                idx = pInstance->hashIndex[slot] - 1;
+                cMap_hashRemoveSlot(pInstance, slot);
             }
-            else
+        }
+        else if(0 != (pInstance->flags & CMAP_FLAG_SORTED))
+        {
+            int found;
+            const size_t sortedIdx = cMap_sortedSearch(pInstance, key, &found, 1);
+
+            if(0 != found)
+            {
+                idx = sortedIdx;
+            }
+        }
+        else
+        {
+            idx = cMap_linearSearch(pInstance, key, 1);
+        }
+
+        if(idx < pInstance->mapSize)
+        {
+            --(pInstance->mapSize);
+
+            if(idx < pInstance->mapSize)
             {
-                void* newArrayPtr = pInstance->pairArray;
-                        
-                if((size_t)(0) == pInstance->mapSize)
+                if(0 != (pInstance->flags & CMAP_FLAG_UNORDERED_ERASE))
                 {
-                    pInstance->allocationSize = CMAP_ALLOC_POWER_SIZE_RND;
-                    newArrayPtr = (void*)malloc(pInstance->elemSize * pInstance->allocationSize);					
-                }				
+                    /*Move the last pair into the hole and redirect its index slot*/
+                    cMap_movePairs(pInstance, idx, pInstance->mapSize, 1);
+
+                    if(NULL != pInstance->hashFunc)
+                    {
+                        int found;
+                        const size_t lastSlot = cMap_hashProbe(pInstance, (const void*)CMAP_CALC_KEY_IDX_PTR_VAL(pInstance, idx), &found, 0);
+                        pInstance->hashIndex[lastSlot] = idx + 1;
+                    }
+                }
                 else
                 {
-#if (1 < CMAP_ALLOC_POWER_SIZE)						
-                    if(pInstance->mapSize == pInstance->allocationSize)
-                    {
-                        /*Allocate space with the nearest power*/					
-                        pInstance->allocationSize *= CMAP_ALLOC_POWER_SIZE_RND;
-                        newArrayPtr = (void*)realloc((void*)(pInstance->pairArray), (pInstance->elemSize * pInstance->allocationSize));
-                    }                   	
-#else
-                    ++(pInstance->allocationSize);
-                    newArrayPtr = (void*)realloc((void*)(pInstance->pairArray), (pInstance->elemSize * pInstance->allocationSize));
-#endif	       					
+                    cMap_movePairs(pInstance, idx, idx + 1, pInstance->mapSize - idx);
                 }
+            }
 
-                if(NULL != newArrayPtr)
-                {
-                    pInstance->pairArray = newArrayPtr;			    
+            cMap_shrinkAfterErase(pInstance);
+
+            CSTATS_ADD(pInstance, eraseCount, 1);
+            result = 0;
+        }
+    }
+    
+    return result;
+}
 
-                    memcpy((void*)CMAP_CALC_KEY_IDX_PTR_VAL(pInstance, pInstance->mapSize), newPair->first, pInstance->keySizeAligned);
-                    memcpy((void*)CMAP_CALC_VAL_IDX_PTR_VAL(pInstance, pInstance->mapSize), newPair->second,pInstance->valueSizeAligned);
+int 	cMap_insertBatch(cMap* pInstance, const void* keys, const void* values, const size_t count)
+{
+    int result = -1;
 
-                    ++pInstance->mapSize;
+    if((NULL != pInstance) && (NULL != keys) && (NULL != values))
+    {
+        if((size_t)(0) == count)
+        {
+            result = 0;
+        }
+        else if(NULL != pInstance->hashFunc)
+        {
+            result = cMap_hashInsertBatch(pInstance, keys, values, count);
+        }
+        else if(0 != (pInstance->flags & CMAP_FLAG_SORTED))
+        {
+            result = cMap_sortedInsertBatch(pInstance, keys, values, count);
+        }
+        else
+        {
+            /*Deduplicate through a temporary hash index instead of a linear find per pair*/
+            pInstance->hashFunc = cMap_defaultHash;
 
-                    result = 0;
-                }                
+            result = cMap_hashInsertBatch(pInstance, keys, values, count);
+
+            if(NULL != pInstance->hashIndex)
+            {
+                cAllocator_free(pInstance->allocator, (void*)pInstance->hashIndex, (pInstance->hashIndexSize * sizeof(size_t)));
+                pInstance->hashIndex = NULL;
+                CSTATS_ALLOC(pInstance, pInstance->allocationSize, (NULL != pInstance->pairArray));
             }
+            pInstance->hashIndexSize = (size_t)(0);
+            pInstance->hashFunc = NULL;
+        }
+
+        if(0 == result)
+        {
+            CSTATS_ADD(pInstance, insertCount, count);
         }
     }
 
     return result;
 }
 
-int 	cMap_erase(cMap* pInstance, const void* key)
+size_t 	cMap_findBatch(cMap* pInstance, const void* keys, const size_t count, cPair* results)
 {
-    int result = -1;
-    
-    if((size_t)(0) < pInstance->mapSize)
+    size_t foundCount = 0;
+
+    if((NULL != pInstance) && (NULL != keys) && (NULL != results))
     {
-        cPair pairToDelete;
+        size_t first;
 
-        if(0 == cMap_find(pInstance, key, &pairToDelete))
+        for(first = 0; first < count; first += CMAP_BATCH_GROUP_SIZE)
         {
-            --(pInstance->mapSize);
+            const void* groupKeys = (const void*)CMAP_CALC_BATCH_KEY_PTR_VAL(pInstance, keys, first);
+            const size_t groupCount = ((count - first) < CMAP_BATCH_GROUP_SIZE) ? (count - first) : CMAP_BATCH_GROUP_SIZE;
+            size_t groupIdx;
 
-            if((size_t)(0) < pInstance->mapSize)
-            {			
-                memmove((void*)(pairToDelete.first), (const void*)((size_t)(pairToDelete.first) + pInstance->elemSize), ((pInstance->mapSize * pInstance->elemSize) - ((size_t)(pairToDelete.first) - (size_t)pInstance->pairArray)));		
-                
-#if (1 < CMAP_ALLOC_POWER_SIZE)
-                if(CMAP_ALLOC_POWER_SIZE_RND < pInstance->allocationSize)
-                {				
-                    if(pInstance->mapSize == (pInstance->allocationSize / CMAP_ALLOC_POWER_SIZE_RND))				
-                    {				
-                        pInstance->pairArray = (void*)realloc((void*)pInstance->pairArray, (pInstance->mapSize * pInstance->elemSize));
-                        
-                        pInstance->allocationSize /= CMAP_ALLOC_POWER_SIZE_RND;
+            if(NULL != pInstance->hashFunc)
+            {
+                if(NULL != pInstance->hashIndex)
+                {
+                    cMap_hashFindGroup(pInstance, groupKeys, groupCount, &results[first]);
+                }
+                else
+                {
+                    for(groupIdx = 0; groupIdx < groupCount; ++groupIdx)
+                    {
+                        cMap_setBatchResult(pInstance, pInstance->mapSize, &results[first + groupIdx]);
                     }
                 }
-#else
-                pInstance->pairArray = (void*)realloc((void*)pInstance->pairArray, (pInstance->mapSize * pInstance->elemSize));
-                --(pInstance->allocationSize);
-#endif	
-                
+            }
+            else if(0 != (pInstance->flags & CMAP_FLAG_SORTED))
+            {
+                cMap_sortedFindGroup(pInstance, groupKeys, groupCount, &results[first]);
             }
             else
             {
-                free(pInstance->pairArray);
-                pInstance->allocationSize = (size_t)(0);
+                cMap_linearFindGroup(pInstance, groupKeys, groupCount, &results[first]);
+            }
+
+            for(groupIdx = 0; groupIdx < groupCount; ++groupIdx)
+            {
+                foundCount += (NULL != results[first + groupIdx].first) ? 1 : 0;
             }
-            
-            result = 0;
         }
     }
-    
+
+    return foundCount;
+}
+
+int 	cMap_buildFrom(cMap* pInstance, const void* keys, const void* values, const size_t count)
+{
+    int result = -1;
+
+    if(NULL != pInstance)
+    {
+        cMap_clear(pInstance);
+        result = cMap_insertBatch(pInstance, keys, values, count);
+    }
+
+    return result;
+}
+
+size_t 	cMap_lowerBound(cMap* pInstance, const void* key)
+{
+    size_t idx = pInstance->mapSize;
+
+    if((NULL != key) && (0 != (pInstance->flags & CMAP_FLAG_SORTED)))
+    {
+        int found;
+        idx = cMap_sortedSearch(pInstance, key, &found, CMAP_IS_READ_COUNTED(pInstance));
+    }
+
+    return idx;
+}
+
+size_t 	cMap_upperBound(cMap* pInstance, const void* key)
+{
+    size_t idx = pInstance->mapSize;
+
+    if((NULL != key) && (0 != (pInstance->flags & CMAP_FLAG_SORTED)))
+    {
+        int found;
+        idx = cMap_sortedSearch(pInstance, key, &found, CMAP_IS_READ_COUNTED(pInstance));
+
+        if(0 != found)
+        {
+            ++idx;
+        }
+    }
+
+    return idx;
+}
+
+int 	cMap_range(cMap* pInstance, const void* lowKey, const void* highKey, size_t* pFirst, size_t* pLast)
+{
+    int result = -1;
+
+    if((0 != (pInstance->flags & CMAP_FLAG_SORTED)) && (NULL != pFirst) && (NULL != pLast))
+    {
+        *pFirst = (NULL != lowKey) ? cMap_lowerBound(pInstance, lowKey) : (size_t)(0);
+        *pLast  = (NULL != highKey) ? cMap_lowerBound(pInstance, highKey) : pInstance->mapSize;
+
+        if(*pLast < *pFirst)
+        {
+            *pLast = *pFirst;
+        }
+
+        result = 0;
+    }
+
+    return result;
+}
+
+int 	cMap_reserve(cMap* pInstance, const size_t count)
+{
+    int result = 0;
+
+    if(count > pInstance->allocationSize)
+    {
+        result = cMap_resize(pInstance, count);
+    }
+
+    if((0 == result) && (NULL != pInstance->hashFunc))
+    {
+        result = cMap_hashReserve(pInstance, count);
+    }
+
+    return result;
+}
+
+int 	cMap_shrinkToFit(cMap* pInstance)
+{
+    int result = cMap_resize(pInstance, pInstance->mapSize);
+
+    if((0 == result) && (NULL != pInstance->hashIndex))
+    {
+        if((size_t)(0) == pInstance->mapSize)
+        {
+            cAllocator_free(pInstance->allocator, (void*)pInstance->hashIndex, (pInstance->hashIndexSize * sizeof(size_t)));
+            pInstance->hashIndex = NULL;
+            pInstance->hashIndexSize = (size_t)(0);
+            CSTATS_ALLOC(pInstance, (size_t)(0), (NULL != pInstance->pairArray));
+        }
+        else if(cMap_hashIndexSizeFor(pInstance->mapSize) < pInstance->hashIndexSize)
+        {
+            result = cMap_hashRebuild(pInstance, cMap_hashIndexSizeFor(pInstance->mapSize));
+        }
+    }
+
+    return result;
+}
+
+int 	cMap_setAllocator(cMap* pInstance, const cAllocator* pAllocator)
+{
+    int result = -1;
+
+    if((NULL == pInstance->pairArray) && (NULL == pInstance->hashIndex))
+    {
+        pInstance->allocator = pAllocator;
+        result = 0;
+    }
+
+    return result;
+}
+
+int 	cMap_stats(const cMap* pInstance, cStats* pStats)
+{
+    return CSTATS_GET(pInstance, pStats);
+}
+
+void 	cMap_setSharedReads(cMap* pInstance)
+{
+    pInstance->flags |= CMAP_FLAG_SHARED_READS;
+}
+
+int 	cMap_setPolicy(cMap* pInstance, const cGrowthPolicy* pPolicy)
+{
+    int result = -1;
+
+    if((NULL != pPolicy) && ((size_t)(0) < pPolicy->growthFactor))
+    {
+        pInstance->policy = *pPolicy;
+        result = 0;
+    }
+
+    return result;
+}
+
+int 	cMap_setAlignment(cMap* pInstance, const size_t elemAlign, const size_t baseAlign)
+{
+    int result = -1;
+    const size_t newElemAlign = ((size_t)(0) == elemAlign) ? sizeof(int) : elemAlign;
+
+    if((NULL == pInstance->pairArray) && (NULL == pInstance->hashIndex) &&
+       CMAP_IS_POWER_OF_2(newElemAlign) && (((size_t)(0) == baseAlign) || CMAP_IS_POWER_OF_2(baseAlign)))
+    {
+        pInstance->keySizeAligned   = CMAP_ALIGN_SIZE(pInstance->keySize, newElemAlign);
+        pInstance->valueSizeAligned = CMAP_ALIGN_SIZE(pInstance->valueSize, newElemAlign);
+        pInstance->elemSize = pInstance->keySizeAligned + pInstance->valueSizeAligned;
+
+        if(0 != (pInstance->flags & CMAP_FLAG_SOA_LAYOUT))
+        {
+            pInstance->keyStride   = pInstance->keySizeAligned;
+            pInstance->valueStride = pInstance->valueSizeAligned;
+        }
+        else
+        {
+            pInstance->keyStride   = pInstance->elemSize;
+            pInstance->valueStride = pInstance->elemSize;
+        }
+        pInstance->valueOffset = CMAP_CALC_VAL_OFFSET(pInstance, 0);
+        pInstance->elemAlign = newElemAlign;
+
+        /*The keys and values are aligned only if the array is*/
+        pInstance->baseAlign = (baseAlign < newElemAlign) ? newElemAlign : baseAlign;
+        result = 0;
+    }
+
     return result;
 }
 
@@ -203,5 +1376,77 @@ void concreteConstructCMap(cMap* instance, size_t keySize, size_t valueSize)
         instance->valueSizeAligned = CMAP_ALIGN_SIZE(instance->valueSize, alignSize);
 
         instance->elemSize = instance->keySizeAligned + instance->valueSizeAligned;
+
+        /*Pairs are interleaved by default (array of structures layout)*/
+        instance->keyStride   = instance->elemSize;
+        instance->valueStride = instance->elemSize;
+        instance->valueOffset = instance->keySizeAligned;
+
+        instance->hashFunc      = NULL;
+        instance->compareFunc   = NULL;
+        instance->hashIndex     = NULL;
+        instance->hashIndexSize = (size_t)(0);
+        instance->flags         = 0U;
+
+        instance->policy.growthFactor  = CMAP_ALLOC_POWER_SIZE_RND;
+        instance->policy.shrinkDivisor = CMAP_SHRINK_DIVISOR;
+        instance->allocator = NULL;
+        instance->elemAlign = alignSize;
+        instance->baseAlign = (size_t)(0);
+
+        CSTATS_INIT(instance, CSTATS_KIND_MAP);
     } 
 }
+
+void concreteConstructCMapFlags(cMap* instance, size_t keySize, size_t valueSize, unsigned int flags)
+{
+    concreteConstructCMap(instance, keySize, valueSize);
+
+    if(NULL != instance)
+    {
+        instance->flags = (flags & (CMAP_FLAG_UNORDERED_ERASE | CMAP_FLAG_SOA_LAYOUT));
+
+        if(0 != (instance->flags & CMAP_FLAG_SOA_LAYOUT))
+        {
+            instance->keyStride   = instance->keySizeAligned;
+            instance->valueStride = instance->valueSizeAligned;
+            instance->valueOffset = CMAP_CALC_VAL_OFFSET(instance, 0);
+        }
+    }
+}
+
+void concreteConstructCMapAligned(cMap* instance, size_t keySize, size_t valueSize, unsigned int flags, size_t elemAlign, size_t baseAlign)
+{
+    concreteConstructCMapFlags(instance, keySize, valueSize, flags);
+
+    if(NULL != instance)
+    {
+        /*Invalid alignments leave the default ones*/
+        (void)cMap_setAlignment(instance, elemAlign, baseAlign);
+    }
+}
+
+void concreteConstructCHashMap(cMap* instance, size_t keySize, size_t valueSize, cMapHashFunc hashFunc, cMapCompareFunc compareFunc)
+{
+    concreteConstructCMap(instance, keySize, valueSize);
+
+    if(NULL != instance)
+    {
+        instance->hashFunc    = (NULL != hashFunc) ? hashFunc : cMap_defaultHash;
+        instance->compareFunc = compareFunc;
+        /*The index would have to be renumbered by a shifting erase, so pairs are never kept in order*/
+        instance->flags      |= CMAP_FLAG_UNORDERED_ERASE;
+    }
+}
+
+
+void concreteConstructCSortedMap(cMap* instance, size_t keySize, size_t valueSize, cMapCompareFunc compareFunc)
+{
+    concreteConstructCMap(instance, keySize, valueSize);
+
+    if(NULL != instance)
+    {
+        instance->compareFunc = compareFunc;
+        instance->flags      |= CMAP_FLAG_SORTED;
+    }
+}
@@ -14,6 +14,18 @@
  
  Change Log:
  22.03.2019 first release
+ 16.10.2026 hashed mode (open addressing index beside pairArray)
+ 16.10.2026 sorted mode (binary search and range queries)
+ 16.10.2026 batch insert and bulk build
+ 16.10.2026 unordered (swap with last) erase
+ 16.10.2026 per instance growth policy, reserve and shrinkToFit
+ 16.10.2026 pluggable allocator
+ 16.10.2026 vectorized find kernel for the linear mode (cfind)
+ 16.10.2026 structure of arrays layout
+ 16.10.2026 operation statistics (cstats)
+ 16.10.2026 emplace (in place construction)
+ 16.10.2026 batch lookup with prefetching
+ 16.10.2026 configurable key, value and pairArray alignment
  ------------------------------------------------------------------------------------------------*/
 
 
@@ -25,6 +37,9 @@ extern "C" {
 #endif
 
 #include <stddef.h>
+#include "cpolicy.h"
+#include "callocator.h"
+#include "cstats.h"
 
 
 /*cPair type, used to contain key-value bindings
@@ -34,6 +49,33 @@ typedef struct {
 	void* second;
 } cPair;	
 
+/*Hash function type of the hashed cMap instances.
+  \param key     : pointer of the key
+  \param keySize : size of the key type in bytes
+  \return        : hash value of the key*/
+typedef size_t (*cMapHashFunc)(const void* key, size_t keySize);
+
+/*Key comparison function type. It follows the memcmp convention,
+  so that memcmp itself can be given for POD keys. Sorted maps also use
+  the sign of the result to order the keys.
+  \param key1    : pointer of the first key
+  \param key2    : pointer of the second key
+  \param keySize : size of the key type in bytes
+  \return        : 0 if the keys are equal, <0 if key1 is ordered before key2, >0 otherwise*/
+typedef int (*cMapCompareFunc)(const void* key1, const void* key2, size_t keySize);
+
+/*cMap flags*/
+/*The pairs are kept in key order. It is set by concreteConstructCSortedMap.*/
+#define CMAP_FLAG_SORTED            (0x01U)
+/*Erase moves the last pair into the place of the erased one in O(1) time, instead of
+shifting all of the following pairs. The pair order is not kept. It is always set for
+hashed maps and ignored by sorted maps.*/
+#define CMAP_FLAG_UNORDERED_ERASE   (0x02U)
+/*pairArray keeps all of the keys contiguously, followed by all of the values (structure of
+arrays), instead of interleaving each key with its value. Key scans then touch only the key
+bytes, which pays off for small keys with large values. It is given to concreteConstructCMapFlags.*/
+#define CMAP_FLAG_SOA_LAYOUT        (0x04U)
+
 typedef struct cMapType cMap;
 
 /*cMap type. 
@@ -53,12 +95,39 @@ struct cMapType{
      size_t valueSizeAligned;
      /*size of a map element in bytes*/
      size_t elemSize;
+     /*distance between two consecutive keys in pairArray, in bytes*/
+     size_t keyStride;
+     /*distance between two consecutive values in pairArray, in bytes*/
+     size_t valueStride;
+     /*offset of the first value in pairArray, in bytes*/
+     size_t valueOffset;
      /*number of the elements*/
      size_t mapSize;
      /*map allocation size, in terms of elements*/
      size_t allocationSize;
      /*dynamic array of the recorded pair elements*/
      void* pairArray;
+     /*hash function of the keys, NULL if the map is not hashed*/
+     cMapHashFunc hashFunc;
+     /*comparison function of the keys, NULL for bytewise comparison*/
+     cMapCompareFunc compareFunc;
+     /*open addressing index of pairArray (hashed maps only). Each slot
+       keeps (pair index + 1), 0 for an empty slot*/
+     size_t* hashIndex;
+     /*number of the slots in hashIndex, always a power of 2*/
+     size_t hashIndexSize;
+     /*CMAP_FLAG_XXX bits of the map*/
+     unsigned int flags;
+     /*growth policy of pairArray*/
+     cGrowthPolicy policy;
+     /*allocator of pairArray and hashIndex, NULL for the standard library*/
+     const cAllocator* allocator;
+     /*alignment of the keys and values in bytes*/
+     size_t elemAlign;
+     /*alignment of the pairArray address in bytes, 0 for that of the allocator*/
+     size_t baseAlign;
+     /*operation statistics, only if CSTATS_ENABLED is defined*/
+     CSTATS_MEMBER
 };
 
 /* Returns the pair at the index "idx".
@@ -91,12 +160,138 @@ int 	cMap_find(cMap* pInstance, const void* key, cPair* pPair);
 	\return 		: result: 0 = Success, -1 = Failure*/
 int		cMap_insert(cMap* pInstance, const cPair* newPair);
 
+/* Returns the pair of the given key, adding it with an uninitialized value if it is not in
+   the map (C++ try_emplace). The value can then be built in place, without copying it from
+   another one and without a separate find.
+   NOTE: the pair is valid until the next insertion or erasure of the map.
+	\param instance  : cMap instance pointer
+	\param key 		 : pointer of the key.
+    \param pPair     : the pair of the key
+    \param pInserted : set to 1 if the pair is added, 0 if it was already in the map. may be NULL
+	\return 		 : result: 0 = Success, -1 = Failure*/
+int 	cMap_emplace(cMap* pInstance, const void* key, cPair* pPair, int* pInserted);
+
 /* Deletes the pair containing given key.
+    NOTE: maps with CMAP_FLAG_UNORDERED_ERASE (including hashed maps) move the last
+    pair into the place of the erased one, so the pair order is not kept.
 	\param instance : cMap instance pointer
 	\param key 		: pointer of the key.
 	\return 		: result: 0 = Success, -1 = Failure*/
 int 	cMap_erase(cMap* pInstance, const void* key);
 
+/* Makes the map able to hold "count" pairs without any reallocation.
+	\param instance : cMap instance pointer
+	\param count 	: number of the pairs.
+	\return 		: result: 0 = Success, -1 = Failure*/
+int 	cMap_reserve(cMap* pInstance, const size_t count);
+
+/* Reallocates the map with the number of pairs it holds. An empty map is released.
+	\param instance : cMap instance pointer
+	\return 		: result: 0 = Success, -1 = Failure*/
+int 	cMap_shrinkToFit(cMap* pInstance);
+
+/* Sets the allocator of the map. It should be called after the construction,
+   before the first pair is added.
+	\param instance   : cMap instance pointer
+	\param pAllocator : allocator pointer, NULL for the standard library. It must
+                         outlive the map.
+	\return 		  : result: 0 = Success, -1 = Failure (the map is already allocated)*/
+int 	cMap_setAllocator(cMap* pInstance, const cAllocator* pAllocator);
+
+/* Sets the alignment of the keys and values and of pairArray, e.g. 16 or 32 bytes for SIMD
+   types or 64 bytes (a cache line) for pairArray. It is applied to every allocation of
+   pairArray. It should be called after the construction (in any mode), before the first pair
+   is added.
+	\param instance  : cMap instance pointer
+	\param elemAlign : alignment of the keys and values in bytes, a power of 2. Their sizes are
+                        padded to it. 0 for the default, sizeof(int)
+	\param baseAlign : alignment of the pairArray address in bytes, a power of 2. 0 for elemAlign
+	\return 		  : result: 0 = Success, -1 = Failure (invalid alignment or the map is
+                        already allocated)*/
+int 	cMap_setAlignment(cMap* pInstance, const size_t elemAlign, const size_t baseAlign);
+
+/* Sets the growth policy of the map. The default policy grows the map by 2
+   and shrinks it when it is less than 1/4 full.
+	\param instance : cMap instance pointer
+	\param pPolicy  : pointer of the policy. growthFactor must be greater than 0.
+	\return 		: result: 0 = Success, -1 = Failure*/
+int 	cMap_setPolicy(cMap* pInstance, const cGrowthPolicy* pPolicy);
+
+/* Gives the operation statistics of the map.
+	\param instance : cMap instance pointer
+	\param pStats   : the counters of the map since its construction
+	\return 		: result: 0 = Success, -1 = Failure (CSTATS_ENABLED is not defined)*/
+int 	cMap_stats(const cMap* pInstance, cStats* pStats);
+
+/* Stops counting the lookups which do not modify the map (find, findBatch, lowerBound and
+   upperBound) in its statistics, so that they can be made by several threads at once. Used by
+   cConcurrentMap and cSnapshotMap for the maps they share between their readers.
+	\param instance : cMap instance pointer*/
+void 	cMap_setSharedReads(cMap* pInstance);
+
+/* Looks up a batch of keys. The lookups of a group of keys are interleaved, and the memory
+   they will touch is prefetched ahead (hashed maps: index slots and pairs, sorted maps: the
+   next binary search steps), so that the cache misses of the keys overlap. Linear maps scan
+   pairArray once per group instead of once per key.
+	\param instance : cMap instance pointer
+	\param keys 	: array of "count" keys, keySize bytes each.
+	\param count 	: number of the keys.
+    \param results  : array of "count" pairs, set to the pair of each key. both members are
+                      NULL for the keys not found
+	\return 		: number of the keys found*/
+size_t 	cMap_findBatch(cMap* pInstance, const void* keys, const size_t count, cPair* results);
+
+/* Adds the given pairs to the map, as if cMap_insert was called for each of them in order,
+   so that a later duplicate key overwrites the value of an earlier one. pairArray is grown
+   once for the whole batch and the duplicates are detected by a hash or sort pass.
+	\param instance : cMap instance pointer
+	\param keys 	: array of "count" keys, keySize bytes each.
+	\param values 	: array of "count" values, valueSize bytes each.
+	\param count 	: number of the pairs.
+	\return 		: result: 0 = Success, -1 = Failure*/
+int 	cMap_insertBatch(cMap* pInstance, const void* keys, const void* values, const size_t count);
+
+/* Clears the map and builds it from the given pairs by cMap_insertBatch.
+	\param instance : cMap instance pointer
+	\param keys 	: array of "count" keys, keySize bytes each.
+	\param values 	: array of "count" values, valueSize bytes each.
+	\param count 	: number of the pairs.
+	\return 		: result: 0 = Success, -1 = Failure*/
+int 	cMap_buildFrom(cMap* pInstance, const void* keys, const void* values, const size_t count);
+
+/* Returns the index of the first pair whose key is not ordered before the given key.
+   Only meaningful for sorted maps.
+	\param instance : cMap instance pointer
+	\param key 		: pointer of the key.
+	\return 		: index of the pair. if there is no such pair or the map is not sorted,
+                      returns the size of map*/
+size_t 	cMap_lowerBound(cMap* pInstance, const void* key);
+
+/* Returns the index of the first pair whose key is ordered after the given key.
+   Only meaningful for sorted maps.
+	\param instance : cMap instance pointer
+	\param key 		: pointer of the key.
+	\return 		: index of the pair. if there is no such pair or the map is not sorted,
+                      returns the size of map*/
+size_t 	cMap_upperBound(cMap* pInstance, const void* key);
+
+/* Gives the index range of the pairs whose keys are in [lowKey, highKey) in a sorted map.
+   The pairs can then be iterated in key order with cMap_getAt.
+	\param instance : cMap instance pointer
+	\param lowKey 	: pointer of the lower key (inclusive), NULL for the start of map.
+	\param highKey 	: pointer of the higher key (exclusive), NULL for the end of map.
+	\param pFirst 	: index of the first pair in the range
+	\param pLast 	: index after the last pair in the range
+	\return 		: result: 0 = Success, -1 = Failure (map is not sorted)*/
+int 	cMap_range(cMap* pInstance, const void* lowKey, const void* highKey, size_t* pFirst, size_t* pLast);
+
+/* Default hash function of the hashed maps. It hashes the key bytes, so it is
+   suitable for POD keys without padding bytes.
+	\param key 		: pointer of the key.
+	\param keySize  : size of the key type in bytes
+	\return 		: hash value of the key*/
+size_t  cMap_defaultHash(const void* key, size_t keySize);
+
 
 /*---------------------------------------------------------------------------*/
 /*This function constructs an allocated cMap object. Need to call after
@@ -110,6 +305,62 @@ void concreteConstructCMap(cMap* instance, size_t keySize, size_t valueSize);
 /*This is a macro wrapper for "concreteConstructCMap" function, provides creation using
 typenames. (C++ template logic)*/
 #define constructCMap(instance, TYPE1, TYPE2)  concreteConstructCMap(instance, sizeof(TYPE1), sizeof(TYPE2))
+
+/*This function constructs an allocated cMap object with the given flags.
+  \param instance 	: allocated cMap pointer to be constructed
+  \param keySize 	: size of the key type
+  \param valueSize 	: size of the value type
+  \param flags 	    : combination of CMAP_FLAG_UNORDERED_ERASE and CMAP_FLAG_SOA_LAYOUT
+  \return		  	: none*/
+void concreteConstructCMapFlags(cMap* instance, size_t keySize, size_t valueSize, unsigned int flags);
+
+/*This is a macro wrapper for "concreteConstructCMapFlags" function, provides creation using
+typenames. (C++ template logic)*/
+#define constructCMapFlags(instance, TYPE1, TYPE2, flags)  concreteConstructCMapFlags(instance, sizeof(TYPE1), sizeof(TYPE2), flags)
+
+/*This function constructs an allocated cMap object with the given flags and alignments, see
+  cMap_setAlignment. Invalid alignments leave the default ones.
+  \param instance 	: allocated cMap pointer to be constructed
+  \param keySize 	: size of the key type
+  \param valueSize 	: size of the value type
+  \param flags 	    : combination of CMAP_FLAG_UNORDERED_ERASE and CMAP_FLAG_SOA_LAYOUT
+  \param elemAlign 	: alignment of the keys and values in bytes, 0 for the default
+  \param baseAlign 	: alignment of the pairArray address in bytes, 0 for elemAlign
+  \return		  	: none*/
+void concreteConstructCMapAligned(cMap* instance, size_t keySize, size_t valueSize, unsigned int flags, size_t elemAlign, size_t baseAlign);
+
+/*This is a macro wrapper for "concreteConstructCMapAligned" function, provides creation using
+typenames. (C++ template logic)*/
+#define constructCMapAligned(instance, TYPE1, TYPE2, flags, elemAlign, baseAlign)  concreteConstructCMapAligned(instance, sizeof(TYPE1), sizeof(TYPE2), flags, elemAlign, baseAlign)
+
+/*This function constructs an allocated cMap object in hashed mode. The pairs are
+  still kept in pairArray and can be iterated with cMap_getAt, while an open addressing
+  index beside it makes find, insert and erase run in O(1) expected time.
+  \param instance 	: allocated cMap pointer to be constructed
+  \param keySize 	: size of the key type
+  \param valueSize 	: size of the value type
+  \param hashFunc 	: hash function of the keys, NULL for cMap_defaultHash
+  \param compareFunc : comparison function of the keys, NULL for bytewise comparison
+  \return		  	: none*/
+void concreteConstructCHashMap(cMap* instance, size_t keySize, size_t valueSize, cMapHashFunc hashFunc, cMapCompareFunc compareFunc);
+
+/*This is a macro wrapper for "concreteConstructCHashMap" function, provides creation using
+typenames. (C++ template logic)*/
+#define constructCHashMap(instance, TYPE1, TYPE2, hashFunc, compareFunc)  concreteConstructCHashMap(instance, sizeof(TYPE1), sizeof(TYPE2), hashFunc, compareFunc)
+
+/*This function constructs an allocated cMap object in sorted mode. The pairs are kept
+  in pairArray in key order, so that find runs binary search in O(log n) time and
+  cMap_getAt iterates the pairs in key order. Insert and erase shift the following pairs.
+  \param instance 	: allocated cMap pointer to be constructed
+  \param keySize 	: size of the key type
+  \param valueSize 	: size of the value type
+  \param compareFunc : comparison function of the keys, NULL for bytewise comparison
+  \return		  	: none*/
+void concreteConstructCSortedMap(cMap* instance, size_t keySize, size_t valueSize, cMapCompareFunc compareFunc);
+
+/*This is a macro wrapper for "concreteConstructCSortedMap" function, provides creation using
+typenames. (C++ template logic)*/
+#define constructCSortedMap(instance, TYPE1, TYPE2, compareFunc)  concreteConstructCSortedMap(instance, sizeof(TYPE1), sizeof(TYPE2), compareFunc)
 /*---------------------------------------------------------------------------*/
 
 #ifdef __cplusplus
@@ -0,0 +1,1056 @@
+/*POSIX threads and sysconf are hidden by the strict ANSI modes of the POSIX headers*/
+#if !defined(_POSIX_C_SOURCE) && !defined(_XOPEN_SOURCE)
+#define _POSIX_C_SOURCE 200112L
+#endif
+
+#include <stdlib.h>
+#include <string.h>
+#include <stdatomic.h>
+#include <unistd.h>
+#include "cparallel.h"
+#include "cfind.h"
+
+/*Calculates the address of the element at the given index*/
+#define CPARALLEL_IDX_PTR_VAL(array, idx, elemSize)  ((size_t)(array) + (idx)*(elemSize))
+
+/*Compares two elements, either by the compare function or bytewise*/
+#define CPARALLEL_COMPARE(compareFunc, elem1, elem2, elemSize)  ((NULL != (compareFunc)) ?\
+        (compareFunc)((elem1), (elem2), (elemSize)) : memcmp((elem1), (elem2), (elemSize)))
+
+/*Compares two keys of the map, like cMap itself does*/
+#define CPARALLEL_COMPARE_KEYS(pMap, key1, key2)  ((NULL != (pMap)->compareFunc) ?\
+        (pMap)->compareFunc((key1), (key2), (pMap)->keySize) : memcmp((key1), (key2), (pMap)->keySize))
+
+/*Number of the chunks per worker when the grain size is chosen automatically. More chunks
+  balance uneven tasks better, fewer ones cost less locking.*/
+#define CPARALLEL_CHUNKS_PER_WORKER     ((size_t)(8))
+
+/*Size of the blocks sorted by insertion sort before the merges of cParallel_sort*/
+#define CPARALLEL_INSERTION_SORT_SIZE   ((size_t)(16))
+
+/*Minimum number of the index slots of a partition of cParallel_buildMap. The probe sequences
+  rarely run off the end of a region this large.*/
+#define CPARALLEL_MIN_PARTITION_SLOTS   ((size_t)(1024))
+
+/*Partial results of the reductions are placed at multiples of the strictest fundamental alignment*/
+typedef union {
+    long l;
+    double d;
+    void* p;
+} cParallelMaxAlign;
+
+#define CPARALLEL_ALIGN_SIZE(size)      ((((size) + sizeof(cParallelMaxAlign) - 1) / sizeof(cParallelMaxAlign)) * sizeof(cParallelMaxAlign))
+
+/*Search state of cParallel_find and cParallel_findIf*/
+typedef struct {
+    const cVector* pVector;
+    const void* elem;
+    cVectorPredicateFunc predicate;
+    void* context;
+    /*smallest matching index found so far, the size of the vector if none*/
+    atomic_size_t foundIdx;
+} cParallelFind;
+
+/*Sorting state of cParallel_sort*/
+typedef struct {
+    void* array;
+    /*temporary array of the same size*/
+    void* buffer;
+    size_t elemSize;
+    size_t compareSize;
+    cVectorCompareFunc compareFunc;
+    size_t count;
+    /*number of the elements of a run sorted by a single task*/
+    size_t runSize;
+    /*source and destination of the merge round, and the size of the sorted runs merged*/
+    const void* src;
+    void* dst;
+    size_t width;
+} cParallelSort;
+
+/*Building state of cParallel_buildMap*/
+typedef struct {
+    cMap* pMap;
+    const void* keys;
+    const void* values;
+    size_t count;
+    size_t mask;
+    size_t grainSize;
+    size_t partitionCount;
+    /*the partition of a slot is slot >> partitionShift*/
+    size_t partitionShift;
+    /*hash of each key, then the index of the last value of each placed key*/
+    size_t* hashes;
+    /*input indices in partition order. The keys left to the serial pass are moved to the
+      start of the segment of their partition.*/
+    size_t* order;
+    /*[chunkCount * partitionCount] histograms of the chunks, then their scatter offsets*/
+    size_t* offsets;
+    /*[partitionCount + 1] first position of each partition in order*/
+    size_t* partitionFirst;
+    /*[partitionCount] number of the keys of each partition left to the serial pass*/
+    size_t* overflowCount;
+    /*[partitionCount] number of the unique keys placed by each partition, then its first pair*/
+    size_t* pairFirst;
+} cParallelBuild;
+
+/*Reduction state of cParallel_reduce and cParallel_reduceMap*/
+typedef struct {
+    const cVector* pVector;
+    cMap* pMap;
+    size_t grainSize;
+    /*partial results of the chunks, resultStride bytes apart*/
+    unsigned char* partials;
+    size_t resultStride;
+    cParallelAccumulateFunc accumulate;
+    cParallelPairAccumulateFunc pairAccumulate;
+    void* context;
+} cParallelReduce;
+
+
+/*Takes the next chunk of the worker's own queue. If it is empty, steals the second half of the
+  chunks left to another worker and continues with them.
+  \return : result: 0 = a chunk is given in *pChunk, -1 = no chunk is left*/
+static int cThreadPool_takeChunk(cThreadPool* pPool, const size_t workerIdx, size_t* pChunk)
+{
+    cThreadPoolQueue* pQueue = &pPool->queueArray[workerIdx];
+    int result = -1;
+    size_t victim;
+
+    pthread_mutex_lock(&pQueue->lock);
+    if(pQueue->first < pQueue->last)
+    {
+        *pChunk = pQueue->first;
+        ++pQueue->first;
+        result = 0;
+    }
+    pthread_mutex_unlock(&pQueue->lock);
+
+    for(victim = 1; (0 != result) && (victim < pPool->workerCount); ++victim)
+    {
+        cThreadPoolQueue* pVictim = &pPool->queueArray[(workerIdx + victim) % pPool->workerCount];
+        size_t first = (size_t)(0);
+        size_t last = (size_t)(0);
+
+        pthread_mutex_lock(&pVictim->lock);
+        if(pVictim->first < pVictim->last)
+        {
+            first = pVictim->last - ((pVictim->last - pVictim->first + 1) / 2);
+            last = pVictim->last;
+            pVictim->last = first;
+        }
+        pthread_mutex_unlock(&pVictim->lock);
+
+        if(first < last)
+        {
+            /*The stolen chunks are published in the own queue, so that they can be stolen again*/
+            pthread_mutex_lock(&pQueue->lock);
+            pQueue->first = first + 1;
+            pQueue->last = last;
+            pthread_mutex_unlock(&pQueue->lock);
+
+            *pChunk = first;
+            result = 0;
+        }
+    }
+
+    return result;
+}
+
+/*Runs the chunks of the current job on the given worker until none is left*/
+static void cThreadPool_runJob(cThreadPool* pPool, const size_t workerIdx)
+{
+    size_t chunk;
+
+    while(0 == cThreadPool_takeChunk(pPool, workerIdx, &chunk))
+    {
+        const size_t first = chunk * pPool->grainSize;
+        const size_t last = ((pPool->count - first) > pPool->grainSize) ? (first + pPool->grainSize) : pPool->count;
+
+        pPool->func(first, last, workerIdx, pPool->context);
+    }
+}
+
+/*Main function of the threads of the pool, given the queue of the thread*/
+static void* cThreadPool_threadMain(void* arg)
+{
+    cThreadPoolQueue* pQueue = (cThreadPoolQueue*)arg;
+    cThreadPool* pPool = pQueue->pPool;
+    const size_t workerIdx = (size_t)(pQueue - pPool->queueArray);
+    size_t generation = (size_t)(0);
+
+    for(;;)
+    {
+        pthread_mutex_lock(&pPool->lock);
+        while((0 == pPool->isStopping) && (generation == pPool->generation))
+        {
+            pthread_cond_wait(&pPool->startCond, &pPool->lock);
+        }
+
+        if(0 != pPool->isStopping)
+        {
+            pthread_mutex_unlock(&pPool->lock);
+            break;
+        }
+        generation = pPool->generation;
+        pthread_mutex_unlock(&pPool->lock);
+
+        cThreadPool_runJob(pPool, workerIdx);
+
+        pthread_mutex_lock(&pPool->lock);
+        --pPool->activeCount;
+        if((size_t)(0) == pPool->activeCount)
+        {
+            pthread_cond_signal(&pPool->doneCond);
+        }
+        pthread_mutex_unlock(&pPool->lock);
+    }
+
+    return NULL;
+}
+
+/*Returns the grain size of the algorithms below: a few chunks per worker, but not smaller
+  than CPARALLEL_MIN_GRAIN_SIZE elements.*/
+static size_t cParallel_grainSize(const cThreadPool* pPool, const size_t count)
+{
+    const size_t grainSize = count / (pPool->workerCount * CPARALLEL_CHUNKS_PER_WORKER);
+
+    return (grainSize > CPARALLEL_MIN_GRAIN_SIZE) ? grainSize : CPARALLEL_MIN_GRAIN_SIZE;
+}
+
+size_t  cThreadPool_size(const cThreadPool* pPool)
+{
+    return pPool->workerCount;
+}
+
+int     cThreadPool_parallelFor(cThreadPool* pPool, size_t count, size_t grainSize, cParallelForFunc func, void* context)
+{
+    int result = -1;
+
+    if((NULL != pPool) && (NULL != func))
+    {
+        size_t chunkCount;
+
+        if((size_t)(0) == grainSize)
+        {
+            grainSize = count / (pPool->workerCount * CPARALLEL_CHUNKS_PER_WORKER);
+            grainSize = ((size_t)(0) == grainSize) ? (size_t)(1) : grainSize;
+        }
+        chunkCount = ((size_t)(0) == count) ? (size_t)(0) : (((count - 1) / grainSize) + 1);
+
+        if(((size_t)(1) == pPool->workerCount) || ((size_t)(1) >= chunkCount))
+        {
+            /*Not worth waking up the threads, the chunks are run in order by the calling thread*/
+            size_t first;
+
+            for(first = 0; first < count; first += grainSize)
+            {
+                func(first, ((count - first) > grainSize) ? (first + grainSize) : count, (size_t)(0), context);
+            }
+        }
+        else
+        {
+            const size_t share = chunkCount / pPool->workerCount;
+            const size_t remainder = chunkCount % pPool->workerCount;
+            size_t workerIdx;
+
+            pthread_mutex_lock(&pPool->jobLock);
+            pthread_mutex_lock(&pPool->lock);
+
+            /*The threads are all idle here, the job is published by the pool lock*/
+            for(workerIdx = 0; workerIdx < pPool->workerCount; ++workerIdx)
+            {
+                pPool->queueArray[workerIdx].first = (workerIdx * share) + ((workerIdx < remainder) ? workerIdx : remainder);
+                pPool->queueArray[workerIdx].last = pPool->queueArray[workerIdx].first + share + ((workerIdx < remainder) ? 1 : 0);
+            }
+            pPool->func = func;
+            pPool->context = context;
+            pPool->count = count;
+            pPool->grainSize = grainSize;
+            pPool->activeCount = pPool->workerCount - 1;
+            ++pPool->generation;
+            pthread_cond_broadcast(&pPool->startCond);
+            pthread_mutex_unlock(&pPool->lock);
+
+            cThreadPool_runJob(pPool, (size_t)(0));
+
+            pthread_mutex_lock(&pPool->lock);
+            while((size_t)(0) != pPool->activeCount)
+            {
+                pthread_cond_wait(&pPool->doneCond, &pPool->lock);
+            }
+            pthread_mutex_unlock(&pPool->lock);
+            pthread_mutex_unlock(&pPool->jobLock);
+        }
+        result = 0;
+    }
+
+    return result;
+}
+
+void    cThreadPool_destroy(cThreadPool* pPool)
+{
+    if(NULL != pPool)
+    {
+        size_t workerIdx;
+
+        pthread_mutex_lock(&pPool->lock);
+        pPool->isStopping = 1;
+        pthread_cond_broadcast(&pPool->startCond);
+        pthread_mutex_unlock(&pPool->lock);
+
+        for(workerIdx = 1; workerIdx < pPool->workerCount; ++workerIdx)
+        {
+            pthread_join(pPool->threadArray[workerIdx - 1], NULL);
+        }
+
+        for(workerIdx = 0; workerIdx < pPool->workerCount; ++workerIdx)
+        {
+            pthread_mutex_destroy(&pPool->queueArray[workerIdx].lock);
+        }
+        pthread_mutex_destroy(&pPool->jobLock);
+        pthread_cond_destroy(&pPool->doneCond);
+        pthread_cond_destroy(&pPool->startCond);
+        pthread_mutex_destroy(&pPool->lock);
+
+        free((void*)pPool->threadArray);
+        free((void*)pPool->queueArray);
+        pPool->threadArray = NULL;
+        pPool->queueArray = NULL;
+        pPool->workerCount = (size_t)(0);
+    }
+}
+
+
+/*Task of cParallel_find and cParallel_findIf. The chunks after the smallest match found so far
+  are skipped, and a chunk is cut at it.*/
+static void cParallel_findTask(size_t first, size_t last, size_t workerIdx, void* context)
+{
+    cParallelFind* pFind = (cParallelFind*)context;
+    const cVector* pVector = pFind->pVector;
+    const size_t foundIdx = atomic_load_explicit(&pFind->foundIdx, memory_order_relaxed);
+
+    (void)workerIdx;
+
+    if(first < foundIdx)
+    {
+        size_t idx;
+
+        last = (last < foundIdx) ? last : foundIdx;
+
+        if(NULL == pFind->predicate)
+        {
+            idx = first + cFind_first((const void*)CPARALLEL_IDX_PTR_VAL(pVector->array, first, pVector->elemSizeAligned),
+                                      last - first, pVector->elemSizeAligned, pFind->elem, pVector->elemSize);
+        }
+        else
+        {
+            for(idx = first; idx < last; ++idx)
+            {
+                if(0 != pFind->predicate((const void*)CPARALLEL_IDX_PTR_VAL(pVector->array, idx, pVector->elemSizeAligned), pFind->context))
+                {
+                    break;
+                }
+            }
+        }
+
+        if(idx < last)
+        {
+            size_t expected = atomic_load_explicit(&pFind->foundIdx, memory_order_relaxed);
+
+            /*Keeps the smallest of the matches of the threads*/
+            while((idx < expected) &&
+                  (0 == atomic_compare_exchange_weak_explicit(&pFind->foundIdx, &expected, idx, memory_order_relaxed, memory_order_relaxed)))
+            {
+            }
+        }
+    }
+}
+
+/*Common implementation of cParallel_find and cParallel_findIf*/
+static size_t cParallel_findImpl(cThreadPool* pPool, const cVector* pInstance, const void* elem, cVectorPredicateFunc predicate, void* context)
+{
+    cParallelFind find;
+
+    find.pVector = pInstance;
+    find.elem = elem;
+    find.predicate = predicate;
+    find.context = context;
+    atomic_init(&find.foundIdx, pInstance->vectSize);
+
+    (void)cThreadPool_parallelFor(pPool, pInstance->vectSize, cParallel_grainSize(pPool, pInstance->vectSize), cParallel_findTask, (void*)&find);
+
+    return atomic_load(&find.foundIdx);
+}
+
+size_t  cParallel_find(cThreadPool* pPool, const cVector* pInstance, const void* elem)
+{
+    return cParallel_findImpl(pPool, pInstance, elem, NULL, NULL);
+}
+
+size_t  cParallel_findIf(cThreadPool* pPool, const cVector* pInstance, cVectorPredicateFunc predicate, void* context)
+{
+    return cParallel_findImpl(pPool, pInstance, NULL, predicate, context);
+}
+
+
+/*Merges the sorted ranges a[0, countA) and b[0, countB) into dst. Ties are taken from a first,
+  so that the merge is stable.*/
+static void cParallel_merge(const cParallelSort* pSort, const void* a, size_t countA, const void* b, size_t countB, void* dst)
+{
+    const size_t elemSize = pSort->elemSize;
+    size_t idxA = (size_t)(0);
+    size_t idxB = (size_t)(0);
+    size_t idxDst = (size_t)(0);
+
+    while((idxA < countA) && (idxB < countB))
+    {
+        const void* elemA = (const void*)CPARALLEL_IDX_PTR_VAL(a, idxA, elemSize);
+        const void* elemB = (const void*)CPARALLEL_IDX_PTR_VAL(b, idxB, elemSize);
+
+        if(0 > CPARALLEL_COMPARE(pSort->compareFunc, elemB, elemA, pSort->compareSize))
+        {
+            memcpy((void*)CPARALLEL_IDX_PTR_VAL(dst, idxDst, elemSize), elemB, elemSize);
+            ++idxB;
+        }
+        else
+        {
+            memcpy((void*)CPARALLEL_IDX_PTR_VAL(dst, idxDst, elemSize), elemA, elemSize);
+            ++idxA;
+        }
+        ++idxDst;
+    }
+
+    memcpy((void*)CPARALLEL_IDX_PTR_VAL(dst, idxDst, elemSize), (const void*)CPARALLEL_IDX_PTR_VAL(a, idxA, elemSize), (countA - idxA) * elemSize);
+    idxDst += countA - idxA;
+    memcpy((void*)CPARALLEL_IDX_PTR_VAL(dst, idxDst, elemSize), (const void*)CPARALLEL_IDX_PTR_VAL(b, idxB, elemSize), (countB - idxB) * elemSize);
+}
+
+/*Returns the number of the elements taken from a among the first "rank" elements of the merge
+  of a[0, countA) and b[0, countB), i.e. where the merge path crosses the given diagonal.*/
+static size_t cParallel_mergeRank(const cParallelSort* pSort, const void* a, size_t countA, const void* b, size_t countB, size_t rank)
+{
+    size_t low = (rank > countB) ? (rank - countB) : (size_t)(0);
+    size_t high = (rank < countA) ? rank : countA;
+
+    /*Smallest i such that the element b[rank - i - 1] (if any) is ordered before a[i] (if any)*/
+    while(low < high)
+    {
+        const size_t mid = low + ((high - low) / 2);
+
+        if(0 > CPARALLEL_COMPARE(pSort->compareFunc, (const void*)CPARALLEL_IDX_PTR_VAL(b, rank - mid - 1, pSort->elemSize),
+                                 (const void*)CPARALLEL_IDX_PTR_VAL(a, mid, pSort->elemSize), pSort->compareSize))
+        {
+            high = mid;
+        }
+        else
+        {
+            low = mid + 1;
+        }
+    }
+
+    return low;
+}
+
+/*Task sorting the runs of cParallel_sort. Blocks of the run are sorted by insertion sort, then
+  merged bottom-up between the run and its region of the buffer.*/
+static void cParallel_sortRunTask(size_t first, size_t last, size_t workerIdx, void* context)
+{
+    const cParallelSort* pSort = (const cParallelSort*)context;
+    const size_t elemSize = pSort->elemSize;
+    size_t run;
+
+    (void)workerIdx;
+
+    for(run = first; run < last; ++run)
+    {
+        const size_t runFirst = run * pSort->runSize;
+        const size_t count = ((pSort->count - runFirst) > pSort->runSize) ? pSort->runSize : (pSort->count - runFirst);
+        unsigned char* src = (unsigned char*)CPARALLEL_IDX_PTR_VAL(pSort->array, runFirst, elemSize);
+        unsigned char* dst = (unsigned char*)CPARALLEL_IDX_PTR_VAL(pSort->buffer, runFirst, elemSize);
+        size_t blockFirst;
+        size_t width;
+
+        for(blockFirst = 0; blockFirst < count; blockFirst += CPARALLEL_INSERTION_SORT_SIZE)
+        {
+            const size_t blockLast = ((count - blockFirst) > CPARALLEL_INSERTION_SORT_SIZE) ? (blockFirst + CPARALLEL_INSERTION_SORT_SIZE) : count;
+            size_t idx;
+
+            for(idx = blockFirst + 1; idx < blockLast; ++idx)
+            {
+                size_t position = idx;
+
+                /*The element is held in the buffer while the greater ones are shifted*/
+                memcpy((void*)dst, (const void*)(src + (idx * elemSize)), elemSize);
+                while((position > blockFirst) &&
+                      (0 > CPARALLEL_COMPARE(pSort->compareFunc, (const void*)dst, (const void*)(src + ((position - 1) * elemSize)), pSort->compareSize)))
+                {
+                    --position;
+                }
+
+                if(position != idx)
+                {
+                    memmove((void*)(src + ((position + 1) * elemSize)), (const void*)(src + (position * elemSize)), (idx - position) * elemSize);
+                    memcpy((void*)(src + (position * elemSize)), (const void*)dst, elemSize);
+                }
+            }
+        }
+
+        for(width = CPARALLEL_INSERTION_SORT_SIZE; width < count; width *= 2)
+        {
+            unsigned char* swap;
+
+            for(blockFirst = 0; blockFirst < count; blockFirst += 2 * width)
+            {
+                const size_t countA = ((count - blockFirst) > width) ? width : (count - blockFirst);
+                const size_t countB = ((count - blockFirst - countA) > width) ? width : (count - blockFirst - countA);
+
+                cParallel_merge(pSort, (const void*)(src + (blockFirst * elemSize)), countA,
+                                (const void*)(src + ((blockFirst + countA) * elemSize)), countB, (void*)(dst + (blockFirst * elemSize)));
+            }
+
+            swap = src;
+            src = dst;
+            dst = swap;
+        }
+
+        if((size_t)(src) != CPARALLEL_IDX_PTR_VAL(pSort->array, runFirst, elemSize))
+        {
+            memcpy((void*)dst, (const void*)src, count * elemSize);
+        }
+    }
+}
+
+/*Task of a merge round of cParallel_sort. The chunk is a range of the output, which may span
+  several merges of the round; each part is merged from where its merge path crosses it.*/
+static void cParallel_sortMergeTask(size_t first, size_t last, size_t workerIdx, void* context)
+{
+    const cParallelSort* pSort = (const cParallelSort*)context;
+    const size_t elemSize = pSort->elemSize;
+    size_t mergeFirst = (first / (2 * pSort->width)) * (2 * pSort->width);
+
+    (void)workerIdx;
+
+    for(; mergeFirst < last; mergeFirst += 2 * pSort->width)
+    {
+        const size_t countA = ((pSort->count - mergeFirst) > pSort->width) ? pSort->width : (pSort->count - mergeFirst);
+        const size_t countB = ((pSort->count - mergeFirst - countA) > pSort->width) ? pSort->width : (pSort->count - mergeFirst - countA);
+        const void* a = (const void*)CPARALLEL_IDX_PTR_VAL(pSort->src, mergeFirst, elemSize);
+        const void* b = (const void*)CPARALLEL_IDX_PTR_VAL(pSort->src, mergeFirst + countA, elemSize);
+        const size_t rankFirst = ((first > mergeFirst) ? first : mergeFirst) - mergeFirst;
+        const size_t rankLast = (((mergeFirst + countA + countB) < last) ? (mergeFirst + countA + countB) : last) - mergeFirst;
+        const size_t idxAFirst = cParallel_mergeRank(pSort, a, countA, b, countB, rankFirst);
+        const size_t idxALast = cParallel_mergeRank(pSort, a, countA, b, countB, rankLast);
+
+        cParallel_merge(pSort, (const void*)CPARALLEL_IDX_PTR_VAL(a, idxAFirst, elemSize), idxALast - idxAFirst,
+                        (const void*)CPARALLEL_IDX_PTR_VAL(b, rankFirst - idxAFirst, elemSize), (rankLast - idxALast) - (rankFirst - idxAFirst),
+                        (void*)CPARALLEL_IDX_PTR_VAL(pSort->dst, mergeFirst + rankFirst, elemSize));
+    }
+}
+
+/*Task copying the sorted buffer back to the array*/
+static void cParallel_sortCopyTask(size_t first, size_t last, size_t workerIdx, void* context)
+{
+    const cParallelSort* pSort = (const cParallelSort*)context;
+
+    (void)workerIdx;
+
+    memcpy((void*)CPARALLEL_IDX_PTR_VAL(pSort->array, first, pSort->elemSize),
+           (const void*)CPARALLEL_IDX_PTR_VAL(pSort->buffer, first, pSort->elemSize), (last - first) * pSort->elemSize);
+}
+
+int     cParallel_sort(cThreadPool* pPool, cVector* pInstance, cVectorCompareFunc compareFunc)
+{
+    int result = 0;
+
+    if(pInstance->vectSize > (size_t)(1))
+    {
+        const size_t grainSize = cParallel_grainSize(pPool, pInstance->vectSize);
+        const size_t bufferSize = pInstance->vectSize * pInstance->elemSizeAligned;
+        cParallelSort sort;
+
+        sort.array = pInstance->array;
+        sort.buffer = cAllocator_alloc(pInstance->allocator, bufferSize);
+        sort.elemSize = pInstance->elemSizeAligned;
+        sort.compareSize = pInstance->elemSize;
+        sort.compareFunc = compareFunc;
+        sort.count = pInstance->vectSize;
+
+        if(NULL == sort.buffer)
+        {
+            result = -1;
+        }
+        else
+        {
+            size_t runCount = sort.count / CPARALLEL_MIN_GRAIN_SIZE;
+
+            /*A run per worker, each sorted by a single task*/
+            runCount = (runCount > pPool->workerCount) ? pPool->workerCount : runCount;
+            runCount = ((size_t)(0) == runCount) ? (size_t)(1) : runCount;
+            sort.runSize = ((sort.count - 1) / runCount) + 1;
+            (void)cThreadPool_parallelFor(pPool, runCount, (size_t)(1), cParallel_sortRunTask, (void*)&sort);
+
+            sort.src = sort.array;
+            sort.dst = sort.buffer;
+            for(sort.width = sort.runSize; sort.width < sort.count; sort.width *= 2)
+            {
+                const void* swap = sort.src;
+
+                (void)cThreadPool_parallelFor(pPool, sort.count, grainSize, cParallel_sortMergeTask, (void*)&sort);
+                sort.src = sort.dst;
+                sort.dst = (void*)swap;
+            }
+
+            if(sort.src != sort.array)
+            {
+                (void)cThreadPool_parallelFor(pPool, sort.count, grainSize, cParallel_sortCopyTask, (void*)&sort);
+            }
+
+            cAllocator_free(pInstance->allocator, sort.buffer, bufferSize);
+            CSTATS_ADD(pInstance, bytesMoved, 2 * bufferSize);
+        }
+    }
+
+    return result;
+}
+
+
+/*Task hashing the keys of cParallel_buildMap and counting them per partition*/
+static void cParallel_buildHashTask(size_t first, size_t last, size_t workerIdx, void* context)
+{
+    const cParallelBuild* pBuild = (const cParallelBuild*)context;
+    const cMap* pMap = pBuild->pMap;
+    size_t* histogram = &pBuild->offsets[(first / pBuild->grainSize) * pBuild->partitionCount];
+    size_t idx;
+
+    (void)workerIdx;
+
+    for(idx = first; idx < last; ++idx)
+    {
+        const size_t hash = pMap->hashFunc((const void*)CPARALLEL_IDX_PTR_VAL(pBuild->keys, idx, pMap->keySize), pMap->keySize);
+
+        pBuild->hashes[idx] = hash;
+        ++histogram[(hash & pBuild->mask) >> pBuild->partitionShift];
+    }
+}
+
+/*Task scattering the input indices of a chunk to the segments of their partitions in order.
+  The chunks have their own offsets, so the order of the input is kept within a partition.*/
+static void cParallel_buildScatterTask(size_t first, size_t last, size_t workerIdx, void* context)
+{
+    const cParallelBuild* pBuild = (const cParallelBuild*)context;
+    size_t* offsets = &pBuild->offsets[(first / pBuild->grainSize) * pBuild->partitionCount];
+    size_t idx;
+
+    (void)workerIdx;
+
+    for(idx = first; idx < last; ++idx)
+    {
+        pBuild->order[offsets[(pBuild->hashes[idx] & pBuild->mask) >> pBuild->partitionShift]++] = idx;
+    }
+}
+
+/*Task inserting the keys of the partitions into their regions of the hash index. A slot holds
+  the input index of the first occurrence of a key + 1, and the hash of that index is replaced
+  by the input index of the last one. A key whose probe sequence runs off the end of the region
+  is left to the serial pass.*/
+static void cParallel_buildInsertTask(size_t first, size_t last, size_t workerIdx, void* context)
+{
+    const cParallelBuild* pBuild = (const cParallelBuild*)context;
+    const cMap* pMap = pBuild->pMap;
+    size_t partition;
+
+    (void)workerIdx;
+
+    for(partition = first; partition < last; ++partition)
+    {
+        const size_t slotLast = (partition + 1) << pBuild->partitionShift;
+        size_t overflowCount = (size_t)(0);
+        size_t uniqueCount = (size_t)(0);
+        size_t position;
+
+        for(position = pBuild->partitionFirst[partition]; position < pBuild->partitionFirst[partition + 1]; ++position)
+        {
+            const size_t idx = pBuild->order[position];
+            const void* key = (const void*)CPARALLEL_IDX_PTR_VAL(pBuild->keys, idx, pMap->keySize);
+            size_t slot = pBuild->hashes[idx] & pBuild->mask;
+
+            while((slot < slotLast) && (0 != pMap->hashIndex[slot]) &&
+                  (0 != CPARALLEL_COMPARE_KEYS(pMap, key, (const void*)CPARALLEL_IDX_PTR_VAL(pBuild->keys, pMap->hashIndex[slot] - 1, pMap->keySize))))
+            {
+                ++slot;
+            }
+
+            if(slot == slotLast)
+            {
+                pBuild->order[pBuild->partitionFirst[partition] + overflowCount] = idx;
+                ++overflowCount;
+            }
+            else if(0 == pMap->hashIndex[slot])
+            {
+                pMap->hashIndex[slot] = idx + 1;
+                pBuild->hashes[idx] = idx;
+                ++uniqueCount;
+            }
+            else
+            {
+                pBuild->hashes[pMap->hashIndex[slot] - 1] = idx;
+            }
+        }
+
+        pBuild->overflowCount[partition] = overflowCount;
+        pBuild->pairFirst[partition] = uniqueCount;
+    }
+}
+
+/*Task copying the pairs of the partitions to their places in pairArray, and pointing the slots
+  of the index to them*/
+static void cParallel_buildPairTask(size_t first, size_t last, size_t workerIdx, void* context)
+{
+    const cParallelBuild* pBuild = (const cParallelBuild*)context;
+    cMap* pMap = pBuild->pMap;
+    size_t partition;
+
+    (void)workerIdx;
+
+    for(partition = first; partition < last; ++partition)
+    {
+        const size_t slotLast = (partition + 1) << pBuild->partitionShift;
+        size_t pairIdx = pBuild->pairFirst[partition];
+        size_t slot;
+
+        for(slot = partition << pBuild->partitionShift; slot < slotLast; ++slot)
+        {
+            if(0 != pMap->hashIndex[slot])
+            {
+                const size_t idx = pMap->hashIndex[slot] - 1;
+                cPair pair;
+
+                (void)cMap_getAt(pMap, pairIdx, &pair);
+                memcpy(pair.first, (const void*)CPARALLEL_IDX_PTR_VAL(pBuild->keys, idx, pMap->keySize), pMap->keySize);
+                memcpy(pair.second, (const void*)CPARALLEL_IDX_PTR_VAL(pBuild->values, pBuild->hashes[idx], pMap->valueSize), pMap->valueSize);
+                pMap->hashIndex[slot] = pairIdx + 1;
+                ++pairIdx;
+            }
+        }
+    }
+}
+
+int     cParallel_buildMap(cThreadPool* pPool, cMap* pInstance, const void* keys, const void* values, const size_t count)
+{
+    int result = -1;
+
+    if((NULL == pInstance) || (NULL == pInstance->hashFunc) ||
+       ((size_t)(1) == pPool->workerCount) || (count < (2 * CPARALLEL_MIN_GRAIN_SIZE)))
+    {
+        result = cMap_buildFrom(pInstance, keys, values, count);
+    }
+    else if((NULL != keys) && (NULL != values))
+    {
+        cMap_clear(pInstance);
+
+        if(0 == cMap_reserve(pInstance, count))
+        {
+            const size_t indexSize = pInstance->hashIndexSize;
+            const size_t grainSize = cParallel_grainSize(pPool, count);
+            const size_t chunkCount = ((count - 1) / grainSize) + 1;
+            size_t partitionCount = (size_t)(1);
+            size_t partitionShift = (size_t)(0);
+            size_t tempSize;
+            size_t* temp;
+
+            while(((size_t)(1) << partitionShift) < indexSize)
+            {
+                ++partitionShift;
+            }
+
+            /*The partitions are regions of the index of at least CPARALLEL_MIN_PARTITION_SLOTS*/
+            while((partitionCount < (pPool->workerCount * CPARALLEL_CHUNKS_PER_WORKER)) &&
+                  ((indexSize / (2 * partitionCount)) >= CPARALLEL_MIN_PARTITION_SLOTS))
+            {
+                partitionCount *= 2;
+                --partitionShift;
+            }
+
+            tempSize = ((2 * count) + ((chunkCount + 3) * partitionCount) + 1) * sizeof(size_t);
+            temp = (size_t*)cAllocator_alloc(pInstance->allocator, tempSize);
+
+            if(NULL != temp)
+            {
+                cParallelBuild build;
+                size_t overflowTotal = (size_t)(0);
+                size_t position = (size_t)(0);
+                size_t partition;
+                size_t chunk;
+
+                build.pMap = pInstance;
+                build.keys = keys;
+                build.values = values;
+                build.count = count;
+                build.mask = indexSize - 1;
+                build.grainSize = grainSize;
+                build.partitionCount = partitionCount;
+                build.partitionShift = partitionShift;
+                build.hashes = temp;
+                build.order = &temp[count];
+                build.offsets = &temp[2 * count];
+                build.partitionFirst = &build.offsets[chunkCount * partitionCount];
+                build.overflowCount = &build.partitionFirst[partitionCount + 1];
+                build.pairFirst = &build.overflowCount[partitionCount];
+
+                memset((void*)build.offsets, 0, (chunkCount * partitionCount * sizeof(size_t)));
+                (void)cThreadPool_parallelFor(pPool, count, grainSize, cParallel_buildHashTask, (void*)&build);
+
+                /*Turns the histograms into the scatter offsets, partition by partition*/
+                for(partition = 0; partition < partitionCount; ++partition)
+                {
+                    build.partitionFirst[partition] = position;
+                    for(chunk = 0; chunk < chunkCount; ++chunk)
+                    {
+                        const size_t keyCount = build.offsets[(chunk * partitionCount) + partition];
+
+                        build.offsets[(chunk * partitionCount) + partition] = position;
+                        position += keyCount;
+                    }
+                }
+                build.partitionFirst[partitionCount] = position;
+
+                (void)cThreadPool_parallelFor(pPool, count, grainSize, cParallel_buildScatterTask, (void*)&build);
+                (void)cThreadPool_parallelFor(pPool, partitionCount, (size_t)(1), cParallel_buildInsertTask, (void*)&build);
+
+                /*The pairs of the partitions are laid side by side in the order of the partitions*/
+                position = (size_t)(0);
+                for(partition = 0; partition < partitionCount; ++partition)
+                {
+                    const size_t uniqueCount = build.pairFirst[partition];
+
+                    build.pairFirst[partition] = position;
+                    position += uniqueCount;
+                    overflowTotal += build.overflowCount[partition];
+                }
+                pInstance->mapSize = position;
+
+                (void)cThreadPool_parallelFor(pPool, partitionCount, (size_t)(1), cParallel_buildPairTask, (void*)&build);
+                CSTATS_ADD(pInstance, insertCount, count - overflowTotal);
+
+                /*The keys run off their regions are inserted one by one. The pairs are already
+                  reserved, so they cannot fail.*/
+                result = 0;
+                for(partition = 0; (0 == result) && (partition < partitionCount); ++partition)
+                {
+                    for(position = 0; (0 == result) && (position < build.overflowCount[partition]); ++position)
+                    {
+                        const size_t idx = build.order[build.partitionFirst[partition] + position];
+                        cPair pair;
+
+                        result = cMap_emplace(pInstance, (const void*)CPARALLEL_IDX_PTR_VAL(keys, idx, pInstance->keySize), &pair, NULL);
+                        if(0 == result)
+                        {
+                            memcpy(pair.second, (const void*)CPARALLEL_IDX_PTR_VAL(values, idx, pInstance->valueSize), pInstance->valueSize);
+                        }
+                    }
+                }
+
+                cAllocator_free(pInstance->allocator, (void*)temp, tempSize);
+            }
+        }
+    }
+
+    return result;
+}
+
+
+/*Task accumulating the elements of a chunk into its partial result*/
+static void cParallel_reduceTask(size_t first, size_t last, size_t workerIdx, void* context)
+{
+    const cParallelReduce* pReduce = (const cParallelReduce*)context;
+    void* partial = (void*)&pReduce->partials[(first / pReduce->grainSize) * pReduce->resultStride];
+    size_t idx;
+
+    (void)workerIdx;
+
+    if(NULL != pReduce->pVector)
+    {
+        for(idx = first; idx < last; ++idx)
+        {
+            pReduce->accumulate(partial, (const void*)CPARALLEL_IDX_PTR_VAL(pReduce->pVector->array, idx, pReduce->pVector->elemSizeAligned), pReduce->context);
+        }
+    }
+    else
+    {
+        for(idx = first; idx < last; ++idx)
+        {
+            cPair pair;
+
+            (void)cMap_getAt(pReduce->pMap, idx, &pair);
+            pReduce->pairAccumulate(partial, (const void*)pair.first, (const void*)pair.second, pReduce->context);
+        }
+    }
+}
+
+/*Common implementation of cParallel_reduce and cParallel_reduceMap*/
+static int cParallel_reduceImpl(cThreadPool* pPool, cParallelReduce* pReduce, const cAllocator* allocator, size_t count,
+                                void* result, size_t resultSize, cParallelCombineFunc combine)
+{
+    int retVal = 0;
+
+    if((size_t)(0) != count)
+    {
+        const size_t chunkCount = ((count - 1) / pReduce->grainSize) + 1;
+        const size_t partialsSize = chunkCount * pReduce->resultStride;
+
+        pReduce->partials = (unsigned char*)cAllocator_alloc(allocator, partialsSize);
+
+        if(NULL == pReduce->partials)
+        {
+            retVal = -1;
+        }
+        else
+        {
+            size_t chunk;
+
+            for(chunk = 0; chunk < chunkCount; ++chunk)
+            {
+                memcpy((void*)&pReduce->partials[chunk * pReduce->resultStride], (const void*)result, resultSize);
+            }
+
+            (void)cThreadPool_parallelFor(pPool, count, pReduce->grainSize, cParallel_reduceTask, (void*)pReduce);
+
+            for(chunk = 0; chunk < chunkCount; ++chunk)
+            {
+                combine(result, (const void*)&pReduce->partials[chunk * pReduce->resultStride], pReduce->context);
+            }
+
+            cAllocator_free(allocator, (void*)pReduce->partials, partialsSize);
+        }
+    }
+
+    return retVal;
+}
+
+int     cParallel_reduce(cThreadPool* pPool, const cVector* pInstance, void* result, size_t resultSize,
+                         cParallelAccumulateFunc accumulate, cParallelCombineFunc combine, void* context)
+{
+    cParallelReduce reduce;
+
+    reduce.pVector = pInstance;
+    reduce.pMap = NULL;
+    reduce.grainSize = cParallel_grainSize(pPool, pInstance->vectSize);
+    reduce.resultStride = CPARALLEL_ALIGN_SIZE(resultSize);
+    reduce.accumulate = accumulate;
+    reduce.pairAccumulate = NULL;
+    reduce.context = context;
+
+    return cParallel_reduceImpl(pPool, &reduce, pInstance->allocator, pInstance->vectSize, result, resultSize, combine);
+}
+
+int     cParallel_reduceMap(cThreadPool* pPool, cMap* pInstance, void* result, size_t resultSize,
+                            cParallelPairAccumulateFunc accumulate, cParallelCombineFunc combine, void* context)
+{
+    cParallelReduce reduce;
+
+    reduce.pVector = NULL;
+    reduce.pMap = pInstance;
+    reduce.grainSize = cParallel_grainSize(pPool, pInstance->mapSize);
+    reduce.resultStride = CPARALLEL_ALIGN_SIZE(resultSize);
+    reduce.accumulate = NULL;
+    reduce.pairAccumulate = accumulate;
+    reduce.context = context;
+
+    return cParallel_reduceImpl(pPool, &reduce, pInstance->allocator, pInstance->mapSize, result, resultSize, combine);
+}
+
+
+int concreteConstructCThreadPool(cThreadPool* instance, size_t workerCount)
+{
+    int result = -1;
+
+    if((size_t)(0) == workerCount)
+    {
+        const long processorCount = sysconf(_SC_NPROCESSORS_ONLN);
+
+        workerCount = (processorCount > 0) ? (size_t)(processorCount) : (size_t)(1);
+    }
+
+    instance->workerCount = (size_t)(0);
+    instance->generation = (size_t)(0);
+    instance->activeCount = (size_t)(0);
+    instance->isStopping = 0;
+    instance->func = NULL;
+    instance->context = NULL;
+    instance->count = (size_t)(0);
+    instance->grainSize = (size_t)(1);
+    instance->threadArray = ((size_t)(1) < workerCount) ? (pthread_t*)malloc((workerCount - 1) * sizeof(pthread_t)) : NULL;
+    instance->queueArray = (cThreadPoolQueue*)malloc(workerCount * sizeof(cThreadPoolQueue));
+
+    if(((NULL != instance->threadArray) || ((size_t)(1) == workerCount)) && (NULL != instance->queueArray) &&
+       (0 == pthread_mutex_init(&instance->lock, NULL)))
+    {
+        if(0 == pthread_cond_init(&instance->startCond, NULL))
+        {
+            if(0 == pthread_cond_init(&instance->doneCond, NULL))
+            {
+                if(0 == pthread_mutex_init(&instance->jobLock, NULL))
+                {
+                    result = 0;
+                }
+                else
+                {
+                    pthread_cond_destroy(&instance->doneCond);
+                }
+            }
+
+            if(0 != result)
+            {
+                pthread_cond_destroy(&instance->startCond);
+            }
+        }
+
+        if(0 != result)
+        {
+            pthread_mutex_destroy(&instance->lock);
+        }
+    }
+
+    if(0 == result)
+    {
+        /*The queues and threads started so far are released by cThreadPool_destroy on failure*/
+        while((0 == result) && (instance->workerCount < workerCount))
+        {
+            cThreadPoolQueue* pQueue = &instance->queueArray[instance->workerCount];
+
+            pQueue->first = (size_t)(0);
+            pQueue->last = (size_t)(0);
+            pQueue->pPool = instance;
+
+            if(0 != pthread_mutex_init(&pQueue->lock, NULL))
+            {
+                result = -1;
+            }
+            else if(((size_t)(0) != instance->workerCount) &&
+                    (0 != pthread_create(&instance->threadArray[instance->workerCount - 1], NULL, cThreadPool_threadMain, (void*)pQueue)))
+            {
+                pthread_mutex_destroy(&pQueue->lock);
+                result = -1;
+            }
+            else
+            {
+                ++instance->workerCount;
+            }
+        }
+
+        if(0 != result)
+        {
+            cThreadPool_destroy(instance);
+        }
+    }
+    else
+    {
+        free((void*)instance->threadArray);
+        free((void*)instance->queueArray);
+        instance->threadArray = NULL;
+        instance->queueArray = NULL;
+    }
+
+    return result;
+}
@@ -0,0 +1,232 @@
+ /*
+ Parallel algorithms of cVector and cMap
+
+ The algorithms given here split the work on the arrays of a large container across the
+ threads of a cThreadPool:
+
+ - cThreadPool_parallelFor : calls a function for the chunks of an index range on all of the
+                             threads. Each thread takes the chunks of its own share in index
+                             order, and an idle thread steals the second half of the chunks
+                             left to another one, so that uneven chunks are balanced.
+ - cParallel_find, cParallel_findIf : first matching element of a vector. The chunks after a
+                             match found by any thread are cancelled.
+ - cParallel_sort          : stable merge sort of a vector. The runs of the threads are sorted
+                             independently and merged in rounds, each merge split across the
+                             threads by the merge path of its output.
+ - cParallel_buildMap      : builds a hashed cMap from key and value arrays. The keys are
+                             partitioned by their hash index slots, each partition is inserted
+                             into its own region of the index by one thread, and the pairs of
+                             the partitions are then merged into pairArray side by side.
+ - cParallel_reduce, cParallel_reduceMap : reduce the elements (or pairs) chunk by chunk on the
+                             threads, then combine the partial results in chunk order.
+
+ The calling thread works as one of the threads of the pool. The temporary arrays are allocated
+ by the calling thread with the allocator of the container, so it need not be thread safe; the
+ functions given to the algorithms (comparison, hash, predicate...) are called concurrently.
+
+ NOTE: Unlike the core containers, it relies on POSIX threads, and its source on C11 atomics
+ (<stdatomic.h>). In the strict ANSI modes of the compilers, the sources including this header
+ should define _POSIX_C_SOURCE as 200112L or later. A pool must be released by
+ cThreadPool_destroy.
+
+ Authors: akozan
+
+ Change Log:
+ 16.10.2026 first release
+ ------------------------------------------------------------------------------------------------*/
+
+
+#ifndef CPARALLEL_H
+#define CPARALLEL_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stddef.h>
+#include <pthread.h>
+#include "calgorithm.h"
+#include "cmap.h"
+
+/*Size of the cache line the work queues are padded to*/
+#ifndef CPARALLEL_CACHE_LINE_SIZE
+#define CPARALLEL_CACHE_LINE_SIZE   64
+#endif
+
+/*Minimum number of the elements of a chunk of the parallel algorithms. Smaller containers are
+  processed by the calling thread alone, since waking up the pool would cost more.*/
+#ifndef CPARALLEL_MIN_GRAIN_SIZE
+#define CPARALLEL_MIN_GRAIN_SIZE    ((size_t)(4096))
+#endif
+
+/*Task function type of cThreadPool_parallelFor.
+  \param first     : index of the first element of the chunk
+  \param last      : index after the last element of the chunk
+  \param workerIdx : index of the thread running the chunk, in [0, cThreadPool_size). 0 is the
+                     calling thread
+  \param context   : user data given to cThreadPool_parallelFor
+  \return          : none*/
+typedef void (*cParallelForFunc)(size_t first, size_t last, size_t workerIdx, void* context);
+
+/*Accumulation function type of cParallel_reduce.
+  \param partial : partial result of the chunk
+  \param elem    : pointer of the element to be accumulated into it
+  \param context : user data given to the algorithm
+  \return        : none*/
+typedef void (*cParallelAccumulateFunc)(void* partial, const void* elem, void* context);
+
+/*Accumulation function type of cParallel_reduceMap.
+  \param partial : partial result of the chunk
+  \param key     : pointer of the key of the pair to be accumulated into it
+  \param value   : pointer of the value of the pair
+  \param context : user data given to the algorithm
+  \return        : none*/
+typedef void (*cParallelPairAccumulateFunc)(void* partial, const void* key, const void* value, void* context);
+
+/*Combination function type of the reductions. It must be associative.
+  \param result  : result combined so far, updated in place
+  \param partial : partial result of the next chunk
+  \param context : user data given to the algorithm
+  \return        : none*/
+typedef void (*cParallelCombineFunc)(void* result, const void* partial, void* context);
+
+/*Work queue of a thread: the chunks [first, last) of the running job left to it. The padding
+  keeps the queues of the neighbour threads in different cache lines.*/
+typedef struct {
+     pthread_mutex_t lock;
+     size_t first;
+     size_t last;
+     /*pool of the queue, given to the thread of the queue*/
+     struct cThreadPoolType* pPool;
+     char padding[CPARALLEL_CACHE_LINE_SIZE];
+} cThreadPoolQueue;
+
+typedef struct cThreadPoolType cThreadPool;
+
+/*cThreadPool type.
+ These members are intended to be private.
+ DO NOT MODIFY THE VALUES DIRECTLY!*/
+struct cThreadPoolType{
+     /*threads of the pool, workerCount - 1 of them besides the calling thread*/
+     pthread_t* threadArray;
+     /*work queues of the workers, the calling thread first*/
+     cThreadPoolQueue* queueArray;
+     /*number of the workers, including the calling thread*/
+     size_t workerCount;
+     /*guards the job members below*/
+     pthread_mutex_t lock;
+     /*signals a new job (or the destruction) to the threads*/
+     pthread_cond_t startCond;
+     /*signals the end of the job to the calling thread*/
+     pthread_cond_t doneCond;
+     /*serializes the jobs of different calling threads*/
+     pthread_mutex_t jobLock;
+     /*task function and user data of the running job*/
+     cParallelForFunc func;
+     void* context;
+     /*number of the elements and of the elements per chunk of the running job*/
+     size_t count;
+     size_t grainSize;
+     /*number of the jobs started, a thread runs a job when it changes*/
+     size_t generation;
+     /*number of the threads still running the job*/
+     size_t activeCount;
+     /*nonzero when the threads should exit*/
+     int isStopping;
+};
+
+/* Returns the number of the workers of the pool, including the calling thread.
+	\param pPool : cThreadPool instance pointer
+	\return      : number of the workers*/
+size_t  cThreadPool_size(const cThreadPool* pPool);
+
+/* Calls the task function for the chunks of [0, count) on all of the workers, and returns when
+   all of them are done. It must not be called from a task of the same pool.
+	\param pPool     : cThreadPool instance pointer
+	\param count     : number of the elements
+	\param grainSize : number of the elements of a chunk, 0 to split the range into a few
+                       chunks per worker
+	\param func      : task function
+	\param context   : user data passed to the task function
+	\return          : result: 0 = Success, -1 = Failure (invalid arguments)*/
+int     cThreadPool_parallelFor(cThreadPool* pPool, size_t count, size_t grainSize, cParallelForFunc func, void* context);
+
+/* Stops the threads and releases the pool. It must not be running a job.
+	\param pPool : cThreadPool instance pointer
+	\return      : none*/
+void    cThreadPool_destroy(cThreadPool* pPool);
+
+/* Returns the index of the first element of the vector equal to the given one, like cVector_find.
+	\param pPool    : cThreadPool instance pointer
+	\param instance : cVector instance pointer
+	\param elem     : pointer of the element
+	\return         : the index of the element. if not found, returns the size of vector*/
+size_t  cParallel_find(cThreadPool* pPool, const cVector* pInstance, const void* elem);
+
+/* Returns the index of the first element of the vector satisfying the predicate.
+	\param pPool     : cThreadPool instance pointer
+	\param instance  : cVector instance pointer
+	\param predicate : predicate function
+	\param context   : user data passed to the predicate
+	\return          : the index of the element. if not found, returns the size of vector*/
+size_t  cParallel_findIf(cThreadPool* pPool, const cVector* pInstance, cVectorPredicateFunc predicate, void* context);
+
+/* Sorts the vector. The sort is stable. It needs a temporary copy of the array.
+	\param pPool       : cThreadPool instance pointer
+	\param instance    : cVector instance pointer
+	\param compareFunc : comparison function of the elements, NULL for bytewise comparison
+	\return            : result: 0 = Success, -1 = Failure (no memory)*/
+int     cParallel_sort(cThreadPool* pPool, cVector* pInstance, cVectorCompareFunc compareFunc);
+
+/* Clears the map and builds it from the given pairs, like cMap_buildFrom: a later duplicate key
+   overwrites the value of an earlier one. Hashed maps are built in parallel, the others by
+   cMap_buildFrom.
+	\param pPool    : cThreadPool instance pointer
+	\param instance : cMap instance pointer
+	\param keys     : array of "count" keys, keySize bytes each.
+	\param values   : array of "count" values, valueSize bytes each.
+	\param count    : number of the pairs.
+	\return         : result: 0 = Success, -1 = Failure*/
+int     cParallel_buildMap(cThreadPool* pPool, cMap* pInstance, const void* keys, const void* values, const size_t count);
+
+/* Reduces the elements of the vector. Each chunk is accumulated into a copy of the initial
+   result, and the partial results are combined into the result in chunk order.
+	\param pPool      : cThreadPool instance pointer
+	\param instance   : cVector instance pointer
+	\param result     : the result of "resultSize" bytes. It holds the identity of the reduction
+                        on entry, e.g. 0 for a sum
+	\param resultSize : size of the result in bytes
+	\param accumulate : accumulation function of an element
+	\param combine    : combination function of two results
+	\param context    : user data passed to the functions
+	\return           : result: 0 = Success, -1 = Failure (no memory)*/
+int     cParallel_reduce(cThreadPool* pPool, const cVector* pInstance, void* result, size_t resultSize,
+                         cParallelAccumulateFunc accumulate, cParallelCombineFunc combine, void* context);
+
+/* Reduces the pairs of the map, in the same way as cParallel_reduce.
+	\param pPool      : cThreadPool instance pointer
+	\param instance   : cMap instance pointer
+	\param result     : the result of "resultSize" bytes, holding the identity of the reduction
+	\param resultSize : size of the result in bytes
+	\param accumulate : accumulation function of a pair
+	\param combine    : combination function of two results
+	\param context    : user data passed to the functions
+	\return           : result: 0 = Success, -1 = Failure (no memory)*/
+int     cParallel_reduceMap(cThreadPool* pPool, cMap* pInstance, void* result, size_t resultSize,
+                            cParallelPairAccumulateFunc accumulate, cParallelCombineFunc combine, void* context);
+
+
+/*---------------------------------------------------------------------------*/
+/*This function constructs an allocated cThreadPool object and starts its threads.
+  \param instance    : allocated cThreadPool pointer to be constructed
+  \param workerCount : number of the workers including the calling thread, 0 for the number
+                       of the online processors
+  \return            : result: 0 = Success, -1 = Failure*/
+int concreteConstructCThreadPool(cThreadPool* instance, size_t workerCount);
+/*---------------------------------------------------------------------------*/
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,850 @@
+/*The file mapping functions are hidden by the strict ANSI modes of the POSIX headers*/
+#if !defined(_WIN32) && !defined(_POSIX_C_SOURCE) && !defined(_XOPEN_SOURCE)
+#define _POSIX_C_SOURCE 200112L
+#endif
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "cpersist.h"
+
+#if defined(_WIN32)
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
+
+/*Identification of the files*/
+#define CPERSIST_MAGIC              "cCntSnap"
+#define CPERSIST_MAGIC_SIZE         ((size_t)(8))
+/*Written in the native byte order, it tells whether the file is read in the same one*/
+#define CPERSIST_BYTE_ORDER         0x01020304UL
+
+/*Kinds of the saved containers*/
+#define CPERSIST_KIND_VECTOR        0UL
+#define CPERSIST_KIND_MAP           1UL
+
+/*Functions of a saved map*/
+/*The map is hashed*/
+#define CPERSIST_FUNC_HASHED        (0x01UL)
+/*The hash function is not cMap_defaultHash*/
+#define CPERSIST_FUNC_CUSTOM_HASH   (0x02UL)
+/*The keys are compared by a function instead of bytewise*/
+#define CPERSIST_FUNC_COMPARE       (0x04UL)
+
+/*Largest value of size_t*/
+#define CPERSIST_SIZE_MAX           ((size_t)(-1))
+
+/* This macro gets "size" and returns "align"ed size */
+#define CPERSIST_ALIGN_SIZE(size, align)  (((size) % (align)) ? ((size) + ((align) - ((size) % (align)))) : (size))
+
+/*Modulus of the Adler-32 checksum*/
+#define CPERSIST_ADLER_MOD          65521UL
+/*Number of the bytes summed before the modulo, so that the sums cannot overflow 32 bits*/
+#define CPERSIST_ADLER_BLOCK        ((size_t)(5552))
+
+/*Header at the beginning of the files. The array starts at arrayOffset and the hash index
+  (hashed maps only) at indexOffset, both aligned to CPERSIST_DATA_ALIGN.*/
+typedef struct {
+    char magic[8];
+    unsigned long version;
+    unsigned long byteOrder;
+    unsigned long headerSize;
+    unsigned long sizeofSize;
+    unsigned long kind;
+    /*CMAP_FLAG_XXX bits of a map*/
+    unsigned long flags;
+    /*CPERSIST_FUNC_XXX bits of a map*/
+    unsigned long funcs;
+    /*Adler-32 checksum of the array and the hash index*/
+    unsigned long checksum;
+    /*alignment of the elements (the keys and values of a map) and of the array address*/
+    size_t elemAlign;
+    size_t baseAlign;
+    /*element sizes of a vector*/
+    size_t elemSize;
+    size_t elemSizeAligned;
+    /*pair sizes of a map*/
+    size_t keySize;
+    size_t keySizeAligned;
+    size_t valueSize;
+    size_t valueSizeAligned;
+    size_t pairSize;
+    /*number of the elements or pairs*/
+    size_t count;
+    /*position and size of the array in bytes. The values of a structure of arrays map follow
+      its keys at count * keySizeAligned.*/
+    size_t arrayOffset;
+    size_t arraySize;
+    /*position of the hash index in bytes and its number of the slots*/
+    size_t indexOffset;
+    size_t indexSize;
+} cPersistHeader;
+
+/*A part of the payload of a file*/
+typedef struct {
+    const void* data;
+    size_t size;
+} cPersistChunk;
+
+/*Allocator of the mapped containers. Their arrays belong to the mapping, so they can neither
+  be reallocated nor released.*/
+static void* cPersist_refuseAlloc(void* context, size_t size)
+{
+    (void)context;
+    (void)size;
+
+    return NULL;
+}
+
+static void* cPersist_refuseRealloc(void* context, void* ptr, size_t oldSize, size_t newSize)
+{
+    (void)context;
+    (void)ptr;
+    (void)oldSize;
+    (void)newSize;
+
+    return NULL;
+}
+
+static void cPersist_ignoreFree(void* context, void* ptr, size_t size)
+{
+    (void)context;
+    (void)ptr;
+    (void)size;
+}
+
+static const cAllocator cPersistMappedAllocator = {
+    cPersist_refuseAlloc,
+    cPersist_refuseRealloc,
+    cPersist_ignoreFree,
+    NULL
+};
+
+/*Adds the given bytes to an Adler-32 checksum, starting from 1UL*/
+static unsigned long cPersist_adler32(unsigned long checksum, const void* data, size_t size)
+{
+    const unsigned char* pByte = (const unsigned char*)data;
+    unsigned long sumA = checksum & 0xFFFFUL;
+    unsigned long sumB = (checksum >> 16) & 0xFFFFUL;
+
+    while((size_t)(0) < size)
+    {
+        size_t blockSize = (size < CPERSIST_ADLER_BLOCK) ? size : CPERSIST_ADLER_BLOCK;
+
+        size -= blockSize;
+
+        while((size_t)(0) < blockSize)
+        {
+            sumA += *pByte;
+            sumB += sumA;
+            ++pByte;
+            --blockSize;
+        }
+
+        sumA %= CPERSIST_ADLER_MOD;
+        sumB %= CPERSIST_ADLER_MOD;
+    }
+
+    return (sumB << 16) | sumA;
+}
+
+static unsigned long cPersist_checksum(const cPersistChunk* chunks, size_t chunkCount)
+{
+    unsigned long checksum = 1UL;
+    size_t chunkIdx;
+
+    for(chunkIdx = 0; chunkIdx < chunkCount; ++chunkIdx)
+    {
+        checksum = cPersist_adler32(checksum, chunks[chunkIdx].data, chunks[chunkIdx].size);
+    }
+
+    return checksum;
+}
+
+/*Fills the fields of a header common to all of the kinds*/
+static void cPersist_initHeader(cPersistHeader* pHeader, unsigned long kind)
+{
+    memset((void*)pHeader, 0, sizeof(cPersistHeader));
+
+    memcpy((void*)pHeader->magic, (const void*)CPERSIST_MAGIC, CPERSIST_MAGIC_SIZE);
+    pHeader->version    = CPERSIST_VERSION;
+    pHeader->byteOrder  = CPERSIST_BYTE_ORDER;
+    pHeader->headerSize = (unsigned long)sizeof(cPersistHeader);
+    pHeader->sizeofSize = (unsigned long)sizeof(size_t);
+    pHeader->kind       = kind;
+
+    pHeader->arrayOffset = CPERSIST_ALIGN_SIZE(sizeof(cPersistHeader), CPERSIST_DATA_ALIGN);
+}
+
+/*Places the hash index after the array of a header*/
+static void cPersist_placeIndex(cPersistHeader* pHeader, size_t indexSize)
+{
+    pHeader->indexSize = indexSize;
+    pHeader->indexOffset = pHeader->arrayOffset + pHeader->arraySize;
+
+    if((size_t)(0) != indexSize)
+    {
+        pHeader->indexOffset = CPERSIST_ALIGN_SIZE(pHeader->indexOffset, CPERSIST_DATA_ALIGN);
+    }
+}
+
+/*Writes zero bytes up to the given offset of the file*/
+static int cPersist_writePadding(FILE* file, size_t* pOffset, size_t offset)
+{
+    static const char padding[CPERSIST_DATA_ALIGN] = { 0 };
+    int result = 0;
+
+    if(offset > *pOffset)
+    {
+        if((offset - *pOffset) != fwrite((const void*)padding, 1, (offset - *pOffset), file))
+        {
+            result = -1;
+        }
+        *pOffset = offset;
+    }
+
+    return result;
+}
+
+/*Writes a file with the header, the array chunks from arrayOffset and the index chunk (the
+  last one of "chunks" if indexSize is not 0) from indexOffset. The checksum is filled here.
+  \return : result: 0 = Success, -1 = Failure*/
+static int cPersist_writeFile(const char* path, cPersistHeader* pHeader, const cPersistChunk* chunks, size_t chunkCount)
+{
+    int result = -1;
+    FILE* file;
+
+    pHeader->checksum = cPersist_checksum(chunks, chunkCount);
+
+    file = fopen(path, "wb");
+
+    if(NULL != file)
+    {
+        const size_t arrayChunkCount = ((size_t)(0) != pHeader->indexSize) ? (chunkCount - 1) : chunkCount;
+        size_t offset = sizeof(cPersistHeader);
+        size_t chunkIdx;
+
+        result = (1 == fwrite((const void*)pHeader, sizeof(cPersistHeader), 1, file)) ? 0 : -1;
+
+        if(0 == result)
+        {
+            result = cPersist_writePadding(file, &offset, pHeader->arrayOffset);
+        }
+
+        for(chunkIdx = 0; (0 == result) && (chunkIdx < chunkCount); ++chunkIdx)
+        {
+            if(chunkIdx == arrayChunkCount)
+            {
+                result = cPersist_writePadding(file, &offset, pHeader->indexOffset);
+            }
+
+            if((0 == result) && ((size_t)(0) != chunks[chunkIdx].size))
+            {
+                if(1 != fwrite(chunks[chunkIdx].data, chunks[chunkIdx].size, 1, file))
+                {
+                    result = -1;
+                }
+                offset += chunks[chunkIdx].size;
+            }
+        }
+
+        if(0 != fclose(file))
+        {
+            result = -1;
+        }
+
+        if(0 != result)
+        {
+            (void)remove(path);
+        }
+    }
+
+    return result;
+}
+
+/*Checks a header read from a file of "fileSize" bytes, CPERSIST_SIZE_MAX if unknown.
+  \return : result: 0 = Success, -1 = Failure*/
+static int cPersist_checkHeader(const cPersistHeader* pHeader, unsigned long kind, size_t fileSize)
+{
+    int result = -1;
+
+    if((0 == memcmp((const void*)pHeader->magic, (const void*)CPERSIST_MAGIC, CPERSIST_MAGIC_SIZE)) &&
+       (CPERSIST_VERSION == pHeader->version) &&
+       (CPERSIST_BYTE_ORDER == pHeader->byteOrder) &&
+       ((unsigned long)sizeof(cPersistHeader) == pHeader->headerSize) &&
+       ((unsigned long)sizeof(size_t) == pHeader->sizeofSize) &&
+       (kind == pHeader->kind))
+    {
+        const size_t elemSize = (CPERSIST_KIND_VECTOR == kind) ? pHeader->elemSizeAligned : pHeader->pairSize;
+        const size_t indexBytes = pHeader->indexSize * sizeof(size_t);
+
+        /*The sizes must be consistent and lie within the file*/
+        if(((size_t)(0) != elemSize) &&
+           (pHeader->count <= (CPERSIST_SIZE_MAX / elemSize)) &&
+           ((pHeader->count * elemSize) == pHeader->arraySize) &&
+           (pHeader->indexSize <= (CPERSIST_SIZE_MAX / sizeof(size_t))) &&
+           (pHeader->arrayOffset >= sizeof(cPersistHeader)) &&
+           (pHeader->arrayOffset <= fileSize) &&
+           (pHeader->arraySize <= (fileSize - pHeader->arrayOffset)) &&
+           (pHeader->indexOffset >= (pHeader->arrayOffset + pHeader->arraySize)) &&
+           (pHeader->indexOffset <= fileSize) &&
+           (indexBytes <= (fileSize - pHeader->indexOffset)) &&
+           (0 == (pHeader->arrayOffset % CPERSIST_DATA_ALIGN)) &&
+           (((size_t)(0) == pHeader->indexSize) || (0 == (pHeader->indexOffset % CPERSIST_DATA_ALIGN))))
+        {
+            result = 0;
+        }
+    }
+
+    return result;
+}
+
+/*Reads "size" bytes of the payload of a file from "offset" into "data", skipping the padding
+  after the current offset of the file. The parts are read in the order of their offsets.
+  \return : result: 0 = Success, -1 = Failure*/
+static int cPersist_readPayload(FILE* file, size_t* pOffset, size_t offset, void* data, size_t size)
+{
+    char padding[CPERSIST_DATA_ALIGN];
+    int result = 0;
+
+    while((0 == result) && (*pOffset < offset))
+    {
+        const size_t skipSize = ((offset - *pOffset) < CPERSIST_DATA_ALIGN) ? (offset - *pOffset) : CPERSIST_DATA_ALIGN;
+
+        result = (skipSize == fread((void*)padding, 1, skipSize, file)) ? 0 : -1;
+        *pOffset += skipSize;
+    }
+
+    if((0 == result) && ((size_t)(0) != size))
+    {
+        result = (1 == fread(data, size, 1, file)) ? 0 : -1;
+        *pOffset += size;
+    }
+
+    return result;
+}
+
+/*Maps the whole of a file as private (copy-on-write) pages
+  \return : result: 0 = Success, -1 = Failure*/
+static int cPersist_mapFile(cPersistMapping* pMapping, const char* path)
+{
+    int result = -1;
+
+    pMapping->address = NULL;
+    pMapping->size = (size_t)(0);
+
+#if defined(_WIN32)
+    {
+        HANDLE file = CreateFileA(path, GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+
+        if(INVALID_HANDLE_VALUE != file)
+        {
+            LARGE_INTEGER fileSize;
+
+            if((0 != GetFileSizeEx(file, &fileSize)) && (0 < fileSize.QuadPart) &&
+               ((LONGLONG)(size_t)fileSize.QuadPart == fileSize.QuadPart))
+            {
+                HANDLE mapping = CreateFileMappingA(file, NULL, PAGE_WRITECOPY, 0, 0, NULL);
+
+                if(NULL != mapping)
+                {
+                    void* address = MapViewOfFile(mapping, FILE_MAP_COPY, 0, 0, 0);
+
+                    if(NULL != address)
+                    {
+                        pMapping->address = address;
+                        pMapping->size = (size_t)fileSize.QuadPart;
+                        result = 0;
+                    }
+                    /*The view keeps the mapping alive*/
+                    (void)CloseHandle(mapping);
+                }
+            }
+            (void)CloseHandle(file);
+        }
+    }
+#else
+    {
+        const int file = open(path, O_RDONLY);
+
+        if(0 <= file)
+        {
+            struct stat fileStat;
+
+            if((0 == fstat(file, &fileStat)) && (0 < fileStat.st_size) &&
+               ((off_t)(size_t)fileStat.st_size == fileStat.st_size))
+            {
+                void* address = mmap(NULL, (size_t)fileStat.st_size, (PROT_READ | PROT_WRITE), MAP_PRIVATE, file, 0);
+
+                if(MAP_FAILED != address)
+                {
+                    pMapping->address = address;
+                    pMapping->size = (size_t)fileStat.st_size;
+                    result = 0;
+                }
+            }
+            /*The mapping stays valid after the file is closed*/
+            (void)close(file);
+        }
+    }
+#endif
+
+    return result;
+}
+
+void    cPersist_unmap(cPersistMapping* pMapping)
+{
+    if((NULL != pMapping) && (NULL != pMapping->address))
+    {
+#if defined(_WIN32)
+        (void)UnmapViewOfFile(pMapping->address);
+#else
+        (void)munmap(pMapping->address, pMapping->size);
+#endif
+        pMapping->address = NULL;
+        pMapping->size = (size_t)(0);
+    }
+}
+
+/*Maps a file and checks its header, and optionally its checksum
+  \return : the header at the beginning of the mapping, NULL on failure*/
+static const cPersistHeader* cPersist_openMapping(cPersistMapping* pMapping, const char* path, unsigned long kind, unsigned int flags)
+{
+    const cPersistHeader* pHeader = NULL;
+
+    if(0 == cPersist_mapFile(pMapping, path))
+    {
+        if(sizeof(cPersistHeader) <= pMapping->size)
+        {
+            pHeader = (const cPersistHeader*)pMapping->address;
+
+            if(0 != cPersist_checkHeader(pHeader, kind, pMapping->size))
+            {
+                pHeader = NULL;
+            }
+            else if(0 != (flags & CPERSIST_FLAG_VERIFY))
+            {
+                cPersistChunk chunks[2];
+
+                chunks[0].data = (const void*)((size_t)(pMapping->address) + pHeader->arrayOffset);
+                chunks[0].size = pHeader->arraySize;
+                chunks[1].data = (const void*)((size_t)(pMapping->address) + pHeader->indexOffset);
+                chunks[1].size = pHeader->indexSize * sizeof(size_t);
+
+                if(pHeader->checksum != cPersist_checksum(chunks, 2))
+                {
+                    pHeader = NULL;
+                }
+            }
+        }
+
+        if(NULL == pHeader)
+        {
+            cPersist_unmap(pMapping);
+        }
+    }
+
+    return pHeader;
+}
+
+int     cVector_save(const cVector* pInstance, const char* path)
+{
+    int result = -1;
+
+    if((NULL != pInstance) && (NULL != path))
+    {
+        cPersistHeader header;
+        cPersistChunk chunk;
+
+        cPersist_initHeader(&header, CPERSIST_KIND_VECTOR);
+
+        header.elemSize        = pInstance->elemSize;
+        header.elemSizeAligned = pInstance->elemSizeAligned;
+        header.elemAlign       = pInstance->elemAlign;
+        header.baseAlign       = pInstance->baseAlign;
+        header.count           = pInstance->vectSize;
+        header.arraySize       = pInstance->vectSize * pInstance->elemSizeAligned;
+        cPersist_placeIndex(&header, (size_t)(0));
+
+        chunk.data = pInstance->array;
+        chunk.size = header.arraySize;
+
+        result = cPersist_writeFile(path, &header, &chunk, 1);
+    }
+
+    return result;
+}
+
+/*Constructs a vector of the saved element size and alignments, which must have the same layout
+  \return : result: 0 = Success, -1 = Failure*/
+static int cPersist_constructVector(cVector* pInstance, const cPersistHeader* pHeader)
+{
+    concreteConstructCVector(pInstance, pHeader->elemSize);
+
+    if((pInstance->elemAlign != pHeader->elemAlign) || (pInstance->baseAlign != pHeader->baseAlign))
+    {
+        (void)cVector_setAlignment(pInstance, pHeader->elemAlign, pHeader->baseAlign);
+    }
+
+    return ((pInstance->elemSizeAligned == pHeader->elemSizeAligned) &&
+            (pInstance->elemAlign == pHeader->elemAlign) &&
+            (pInstance->baseAlign == pHeader->baseAlign)) ? 0 : -1;
+}
+
+int     cVector_load(cVector* pInstance, const char* path)
+{
+    int result = -1;
+
+    if((NULL != pInstance) && (NULL != path))
+    {
+        FILE* file = fopen(path, "rb");
+
+        if(NULL != file)
+        {
+            cPersistHeader header;
+
+            if((1 == fread((void*)&header, sizeof(cPersistHeader), 1, file)) &&
+               (0 == cPersist_checkHeader(&header, CPERSIST_KIND_VECTOR, CPERSIST_SIZE_MAX)) &&
+               (0 == cPersist_constructVector(pInstance, &header)))
+            {
+                void* array = NULL;
+
+                if((size_t)(0) != header.count)
+                {
+                    array = cAllocator_allocAligned(pInstance->allocator, header.arraySize, pInstance->baseAlign);
+                }
+
+                if((NULL != array) || ((size_t)(0) == header.count))
+                {
+                    size_t offset = sizeof(cPersistHeader);
+                    cPersistChunk chunk;
+
+                    chunk.data = array;
+                    chunk.size = header.arraySize;
+
+                    if((0 == cPersist_readPayload(file, &offset, header.arrayOffset, array, header.arraySize)) &&
+                       (header.checksum == cPersist_checksum(&chunk, 1)))
+                    {
+                        pInstance->array     = array;
+                        pInstance->vectSize  = header.count;
+                        pInstance->allocSize = header.count;
+
+                        if(NULL != array)
+                        {
+                            CSTATS_ALLOC(pInstance, header.count, 1);
+                        }
+                        result = 0;
+                    }
+                    else if(NULL != array)
+                    {
+                        cAllocator_freeAligned(pInstance->allocator, array, header.arraySize, pInstance->baseAlign);
+                    }
+                }
+            }
+
+            (void)fclose(file);
+        }
+    }
+
+    return result;
+}
+
+int     cVector_map(cVector* pInstance, cPersistMapping* pMapping, const char* path, unsigned int flags)
+{
+    int result = -1;
+
+    if((NULL != pInstance) && (NULL != pMapping) && (NULL != path))
+    {
+        const cPersistHeader* pHeader = cPersist_openMapping(pMapping, path, CPERSIST_KIND_VECTOR, flags);
+
+        if(NULL != pHeader)
+        {
+            if((0 == cPersist_constructVector(pInstance, pHeader)) && (pInstance->baseAlign <= CPERSIST_DATA_ALIGN))
+            {
+                /*The array belongs to the mapping, which aligns it*/
+                pInstance->allocator = &cPersistMappedAllocator;
+                pInstance->baseAlign = (size_t)(0);
+
+                if((size_t)(0) != pHeader->count)
+                {
+                    pInstance->array     = (void*)((size_t)(pMapping->address) + pHeader->arrayOffset);
+                    pInstance->vectSize  = pHeader->count;
+                    pInstance->allocSize = pHeader->count;
+                }
+                result = 0;
+            }
+            else
+            {
+                cPersist_unmap(pMapping);
+            }
+        }
+    }
+
+    return result;
+}
+
+int     cMap_save(const cMap* pInstance, const char* path)
+{
+    int result = -1;
+
+    if((NULL != pInstance) && (NULL != path))
+    {
+        cPersistHeader header;
+        cPersistChunk chunks[3];
+        size_t chunkCount = 0;
+        size_t indexSize = (size_t)(0);
+
+        cPersist_initHeader(&header, CPERSIST_KIND_MAP);
+
+        header.flags            = (unsigned long)pInstance->flags;
+        header.keySize          = pInstance->keySize;
+        header.keySizeAligned   = pInstance->keySizeAligned;
+        header.valueSize        = pInstance->valueSize;
+        header.valueSizeAligned = pInstance->valueSizeAligned;
+        header.pairSize         = pInstance->elemSize;
+        header.elemAlign        = pInstance->elemAlign;
+        header.baseAlign        = pInstance->baseAlign;
+        header.count            = pInstance->mapSize;
+        header.arraySize        = pInstance->mapSize * pInstance->elemSize;
+
+        if(NULL != pInstance->hashFunc)
+        {
+            header.funcs |= CPERSIST_FUNC_HASHED;
+            header.funcs |= (cMap_defaultHash != pInstance->hashFunc) ? CPERSIST_FUNC_CUSTOM_HASH : 0UL;
+
+            if(NULL != pInstance->hashIndex)
+            {
+                indexSize = pInstance->hashIndexSize;
+            }
+        }
+        header.funcs |= (NULL != pInstance->compareFunc) ? CPERSIST_FUNC_COMPARE : 0UL;
+
+        cPersist_placeIndex(&header, indexSize);
+
+        if(0 != (pInstance->flags & CMAP_FLAG_SOA_LAYOUT))
+        {
+            /*The unused key slots are left out, the values follow the saved keys*/
+            chunks[chunkCount].data = pInstance->pairArray;
+            chunks[chunkCount].size = pInstance->mapSize * pInstance->keySizeAligned;
+            ++chunkCount;
+            chunks[chunkCount].data = (const void*)((size_t)(pInstance->pairArray) + pInstance->valueOffset);
+            chunks[chunkCount].size = pInstance->mapSize * pInstance->valueSizeAligned;
+            ++chunkCount;
+        }
+        else
+        {
+            chunks[chunkCount].data = pInstance->pairArray;
+            chunks[chunkCount].size = header.arraySize;
+            ++chunkCount;
+        }
+
+        if((size_t)(0) != indexSize)
+        {
+            chunks[chunkCount].data = (const void*)pInstance->hashIndex;
+            chunks[chunkCount].size = indexSize * sizeof(size_t);
+            ++chunkCount;
+        }
+
+        result = cPersist_writeFile(path, &header, chunks, chunkCount);
+    }
+
+    return result;
+}
+
+/*Constructs a map of the saved kind with the given functions, which must match the saved ones
+  as far as it can be told. The pair layout must be the same as well.
+  \return : result: 0 = Success, -1 = Failure*/
+static int cPersist_constructMap(cMap* pInstance, const cPersistHeader* pHeader, cMapHashFunc hashFunc, cMapCompareFunc compareFunc)
+{
+    const int isHashed = (0 != (pHeader->funcs & CPERSIST_FUNC_HASHED));
+    int result = -1;
+
+    if(!isHashed && ((size_t)(0) != pHeader->indexSize))
+    {
+        /*Only the hashed maps have an index*/
+    }
+    else if(isHashed && ((size_t)(0) == pHeader->indexSize) && ((size_t)(0) != pHeader->count))
+    {
+        /*A hashed map holding pairs has an index*/
+    }
+    else if(isHashed && ((0 != (pHeader->indexSize & (pHeader->indexSize - 1))) || (pHeader->indexSize < pHeader->count)))
+    {
+        /*The slots are found by masking the hash, and each pair has one*/
+    }
+    else if((0 != (pHeader->funcs & CPERSIST_FUNC_CUSTOM_HASH)) != ((NULL != hashFunc) && (cMap_defaultHash != hashFunc)))
+    {
+        /*A different hash function would not find the pairs in the index*/
+    }
+    else if((0 != (pHeader->funcs & CPERSIST_FUNC_COMPARE)) != (NULL != compareFunc))
+    {
+        /*A different comparison function would not match (or order) the keys the same way*/
+    }
+    else
+    {
+        if(isHashed)
+        {
+            concreteConstructCHashMap(pInstance, pHeader->keySize, pHeader->valueSize, hashFunc, compareFunc);
+        }
+        else if(0 != (pHeader->flags & CMAP_FLAG_SORTED))
+        {
+            concreteConstructCSortedMap(pInstance, pHeader->keySize, pHeader->valueSize, compareFunc);
+        }
+        else
+        {
+            concreteConstructCMapFlags(pInstance, pHeader->keySize, pHeader->valueSize, (unsigned int)pHeader->flags);
+            pInstance->compareFunc = compareFunc;
+        }
+
+        if((pInstance->elemAlign != pHeader->elemAlign) || (pInstance->baseAlign != pHeader->baseAlign))
+        {
+            (void)cMap_setAlignment(pInstance, pHeader->elemAlign, pHeader->baseAlign);
+        }
+
+        if((pInstance->keySizeAligned == pHeader->keySizeAligned) &&
+           (pInstance->valueSizeAligned == pHeader->valueSizeAligned) &&
+           (pInstance->elemSize == pHeader->pairSize) &&
+           (pInstance->elemAlign == pHeader->elemAlign) &&
+           (pInstance->baseAlign == pHeader->baseAlign))
+        {
+            result = 0;
+        }
+    }
+
+    return result;
+}
+
+/*Sets the arrays of a map constructed by cPersist_constructMap*/
+static void cPersist_attachMap(cMap* pInstance, const cPersistHeader* pHeader, void* pairArray, size_t* hashIndex)
+{
+    pInstance->pairArray      = pairArray;
+    pInstance->mapSize        = pHeader->count;
+    pInstance->allocationSize = (NULL != pairArray) ? pHeader->count : (size_t)(0);
+    pInstance->hashIndex      = hashIndex;
+    pInstance->hashIndexSize  = (NULL != hashIndex) ? pHeader->indexSize : (size_t)(0);
+
+    if(0 != (pInstance->flags & CMAP_FLAG_SOA_LAYOUT))
+    {
+        pInstance->valueOffset = pInstance->allocationSize * pInstance->keySizeAligned;
+    }
+}
+
+int     cMap_load(cMap* pInstance, const char* path, cMapHashFunc hashFunc, cMapCompareFunc compareFunc)
+{
+    int result = -1;
+
+    if((NULL != pInstance) && (NULL != path))
+    {
+        FILE* file = fopen(path, "rb");
+
+        if(NULL != file)
+        {
+            cPersistHeader header;
+
+            if((1 == fread((void*)&header, sizeof(cPersistHeader), 1, file)) &&
+               (0 == cPersist_checkHeader(&header, CPERSIST_KIND_MAP, CPERSIST_SIZE_MAX)) &&
+               (0 == cPersist_constructMap(pInstance, &header, hashFunc, compareFunc)))
+            {
+                const size_t indexBytes = header.indexSize * sizeof(size_t);
+                void* pairArray = NULL;
+                size_t* hashIndex = NULL;
+
+                if((size_t)(0) != header.count)
+                {
+                    pairArray = cAllocator_allocAligned(pInstance->allocator, header.arraySize, pInstance->baseAlign);
+                }
+
+                if((size_t)(0) != header.indexSize)
+                {
+                    hashIndex = (size_t*)cAllocator_alloc(pInstance->allocator, indexBytes);
+                }
+
+                if(((NULL != pairArray) || ((size_t)(0) == header.count)) &&
+                   ((NULL != hashIndex) || ((size_t)(0) == header.indexSize)))
+                {
+                    size_t offset = sizeof(cPersistHeader);
+                    cPersistChunk chunks[2];
+
+                    chunks[0].data = pairArray;
+                    chunks[0].size = header.arraySize;
+                    chunks[1].data = (const void*)hashIndex;
+                    chunks[1].size = indexBytes;
+
+                    if((0 == cPersist_readPayload(file, &offset, header.arrayOffset, pairArray, header.arraySize)) &&
+                       (0 == cPersist_readPayload(file, &offset, header.indexOffset, (void*)hashIndex, indexBytes)) &&
+                       (header.checksum == cPersist_checksum(chunks, 2)))
+                    {
+                        cPersist_attachMap(pInstance, &header, pairArray, hashIndex);
+
+                        if((NULL != pairArray) || (NULL != hashIndex))
+                        {
+                            CSTATS_ALLOC(pInstance, pInstance->allocationSize, 1);
+                        }
+                        result = 0;
+                    }
+                }
+
+                if(0 != result)
+                {
+                    if(NULL != pairArray)
+                    {
+                        cAllocator_freeAligned(pInstance->allocator, pairArray, header.arraySize, pInstance->baseAlign);
+                    }
+
+                    if(NULL != hashIndex)
+                    {
+                        cAllocator_free(pInstance->allocator, (void*)hashIndex, indexBytes);
+                    }
+                }
+            }
+
+            (void)fclose(file);
+        }
+    }
+
+    return result;
+}
+
+int     cMap_map(cMap* pInstance, cPersistMapping* pMapping, const char* path, cMapHashFunc hashFunc, cMapCompareFunc compareFunc, unsigned int flags)
+{
+    int result = -1;
+
+    if((NULL != pInstance) && (NULL != pMapping) && (NULL != path))
+    {
+        const cPersistHeader* pHeader = cPersist_openMapping(pMapping, path, CPERSIST_KIND_MAP, flags);
+
+        if(NULL != pHeader)
+        {
+            if((0 == cPersist_constructMap(pInstance, pHeader, hashFunc, compareFunc)) && (pInstance->baseAlign <= CPERSIST_DATA_ALIGN))
+            {
+                void* pairArray = NULL;
+                size_t* hashIndex = NULL;
+
+                if((size_t)(0) != pHeader->count)
+                {
+                    pairArray = (void*)((size_t)(pMapping->address) + pHeader->arrayOffset);
+                }
+
+                if((size_t)(0) != pHeader->indexSize)
+                {
+                    hashIndex = (size_t*)((size_t)(pMapping->address) + pHeader->indexOffset);
+                }
+
+                /*The arrays belong to the mapping, which aligns them*/
+                pInstance->allocator = &cPersistMappedAllocator;
+                pInstance->baseAlign = (size_t)(0);
+                cPersist_attachMap(pInstance, pHeader, pairArray, hashIndex);
+                result = 0;
+            }
+            else
+            {
+                cPersist_unmap(pMapping);
+            }
+        }
+    }
+
+    return result;
+}
@@ -0,0 +1,121 @@
+/*
+ Persistent snapshots of cVector and cMap
+
+ cVector and cMap keep their elements in one flat array (and the hashed maps an index of
+ pair positions beside it), so they can be written to a file as they are and used again
+ without rebuilding them element by element. The file holds a versioned header (element
+ sizes, alignment, layout flags and an Adler-32 checksum), followed by the raw array and the
+ hash index, each starting at a CPERSIST_DATA_ALIGN boundary.
+
+ - save / load : the container is written with stdio and read back into allocated memory.
+ - map         : the file is mapped into the memory (mmap on POSIX, MapViewOfFile on Windows)
+                 and the container points into the mapping, so that it is ready to serve
+                 lookups without copying or parsing the elements.
+
+ A mapped container can be read and modified in place (the mapping is copy-on-write, the file
+ is never changed), but it cannot grow: its allocator refuses any allocation, so the insertions
+ needing memory fail. It must not be used after its mapping is closed by cPersist_unmap.
+
+ NOTE: The files are only portable between processes with the same byte order, size_t size and
+ container layout, which are checked by the header. Hash and comparison functions cannot be
+ stored, so a map saved with custom ones must be loaded with the same functions. The mapping
+ requires POSIX or Windows, unlike the strict ANSI C core containers.
+
+ Authors: akozan
+
+ Change Log:
+ 16.10.2026 first release
+ 16.10.2026 version 2 of the format, the element and array alignments are saved
+ ------------------------------------------------------------------------------------------------*/
+
+
+#ifndef CPERSIST_H
+#define CPERSIST_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stddef.h>
+#include "cvector.h"
+#include "cmap.h"
+
+/*Version of the file format*/
+#define CPERSIST_VERSION            2UL
+
+/*Alignment of the array and the hash index in the file, in bytes*/
+#define CPERSIST_DATA_ALIGN         ((size_t)(64))
+
+/*cPersist_map flags*/
+/*The checksum of the file is verified before the container is used. It reads the whole
+file, so it is left to the caller to trade the startup time for the check.*/
+#define CPERSIST_FLAG_VERIFY        (0x01U)
+
+/*cPersistMapping type, a file mapped by cVector_map or cMap_map.
+ These members are intended to be private.
+ DO NOT MODIFY THE VALUES DIRECTLY!*/
+typedef struct {
+    /*address of the mapping, NULL if nothing is mapped*/
+    void* address;
+    /*size of the mapping in bytes*/
+    size_t size;
+} cPersistMapping;
+
+/* Writes the vector to the given file.
+	\param instance : cVector instance pointer
+	\param path 	: path of the file, replaced if it exists
+	\return 		: result: 0 = Success, -1 = Failure*/
+int     cVector_save(const cVector* pInstance, const char* path);
+
+/* Constructs a vector from the given file, reading its array into allocated memory.
+   It should be cleared at the end of its use, like any other vector.
+	\param instance : cVector pointer to be constructed
+	\param path 	: path of the file
+	\return 		: result: 0 = Success, -1 = Failure (unreadable, corrupt or incompatible file)*/
+int     cVector_load(cVector* pInstance, const char* path);
+
+/* Constructs a vector on the mapping of the given file.
+	\param instance : cVector pointer to be constructed
+	\param pMapping : mapping of the file, to be closed by cPersist_unmap
+	\param path 	: path of the file
+	\param flags    : CPERSIST_FLAG_XXX bits
+	\return 		: result: 0 = Success, -1 = Failure (unreadable, corrupt or incompatible file)*/
+int     cVector_map(cVector* pInstance, cPersistMapping* pMapping, const char* path, unsigned int flags);
+
+/* Writes the map to the given file, with its hash index if it is hashed.
+	\param instance : cMap instance pointer
+	\param path 	: path of the file, replaced if it exists
+	\return 		: result: 0 = Success, -1 = Failure*/
+int     cMap_save(const cMap* pInstance, const char* path);
+
+/* Constructs a map from the given file, reading its pairs and hash index into allocated
+   memory. It should be cleared at the end of its use, like any other map.
+	\param instance    : cMap pointer to be constructed
+	\param path 	   : path of the file
+	\param hashFunc    : hash function of a hashed map, NULL for cMap_defaultHash. it must be the
+                         one the map was saved with
+	\param compareFunc : comparison function of the keys, NULL for bytewise comparison
+	\return 		   : result: 0 = Success, -1 = Failure (unreadable, corrupt or incompatible file)*/
+int     cMap_load(cMap* pInstance, const char* path, cMapHashFunc hashFunc, cMapCompareFunc compareFunc);
+
+/* Constructs a map on the mapping of the given file.
+	\param instance    : cMap pointer to be constructed
+	\param pMapping    : mapping of the file, to be closed by cPersist_unmap
+	\param path 	   : path of the file
+	\param hashFunc    : hash function of a hashed map, NULL for cMap_defaultHash. it must be the
+                         one the map was saved with
+	\param compareFunc : comparison function of the keys, NULL for bytewise comparison
+	\param flags       : CPERSIST_FLAG_XXX bits
+	\return 		   : result: 0 = Success, -1 = Failure (unreadable, corrupt or incompatible file)*/
+int     cMap_map(cMap* pInstance, cPersistMapping* pMapping, const char* path, cMapHashFunc hashFunc, cMapCompareFunc compareFunc, unsigned int flags);
+
+/* Closes a mapping. The containers on it must not be used anymore.
+	\param pMapping : mapping of a file
+	\return         : none*/
+void    cPersist_unmap(cPersistMapping* pMapping);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
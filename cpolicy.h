@@ -0,0 +1,48 @@
+/*
+ ANSI C growth policy of the dynamic containers
+ 
+ cVector and cMap keep their elements in a single array that is grown and shrunk by
+ reallocation. The policy given here decides when and how much the array is resized,
+ so that it can be set per instance.
+ 
+ The array is grown by "growthFactor" when it is full, and it is shrunk by the same
+ factor only when the number of elements drops below 1/shrinkDivisor of the allocation.
+ The gap between the two thresholds prevents a push/pop sequence at the boundary from
+ reallocating the array on every call.
+
+ Authors: akozan
+ 
+ Change Log:
+ 16.10.2026 first release
+ ------------------------------------------------------------------------------------------------*/
+
+
+#ifndef CPOLICY_H
+#define CPOLICY_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stddef.h>
+
+/*This value of shrinkDivisor disables the shrinking, the allocation is released only by "clear"
+or "shrinkToFit" methods.*/
+#define CPOLICY_NEVER_SHRINK    ((size_t)(0))
+
+/*cGrowthPolicy type.*/
+typedef struct {
+    /*multiplier of the allocation size when the array is full. It is also the initial
+      allocation size. If given 1, the array is grown by one element on every insertion.
+      NOTE: Do not define it as 0!*/
+    size_t growthFactor;
+    /*the array is shrunk when the number of elements drops below 1/shrinkDivisor of the
+      allocation size. CPOLICY_NEVER_SHRINK disables the shrinking.*/
+    size_t shrinkDivisor;
+} cGrowthPolicy;
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,391 @@
+#include <stdlib.h>
+#include <string.h>
+#include "csnapshotmap.h"
+
+/*Platform writer lock operations*/
+#if defined(_WIN32)
+#define CSNAPSHOTMAP_LOCK_INIT(pLock)           (InitializeSRWLock(pLock), 0)
+#define CSNAPSHOTMAP_LOCK_DESTROY(pLock)        ((void)(pLock))
+#define CSNAPSHOTMAP_LOCK(pLock)                AcquireSRWLockExclusive(pLock)
+#define CSNAPSHOTMAP_UNLOCK(pLock)              ReleaseSRWLockExclusive(pLock)
+#else
+#define CSNAPSHOTMAP_LOCK_INIT(pLock)           pthread_mutex_init((pLock), NULL)
+#define CSNAPSHOTMAP_LOCK_DESTROY(pLock)        ((void)pthread_mutex_destroy(pLock))
+#define CSNAPSHOTMAP_LOCK(pLock)                ((void)pthread_mutex_lock(pLock))
+#define CSNAPSHOTMAP_UNLOCK(pLock)              ((void)pthread_mutex_unlock(pLock))
+#endif
+
+/*Creates an empty version.
+  \return : the version, NULL on failure*/
+static cSnapshotVersion* cSnapshotMap_newVersion(const cSnapshotMap* pInstance)
+{
+    cSnapshotVersion* pVersion = (cSnapshotVersion*)malloc(sizeof(cSnapshotVersion));
+
+    if(NULL != pVersion)
+    {
+        concreteConstructCHashMap(&(pVersion->map), pInstance->keySize, pInstance->valueSize, pInstance->hashFunc, pInstance->compareFunc);
+        cMap_setSharedReads(&(pVersion->map));
+        atomic_init(&(pVersion->refCount), (size_t)(0));
+        pVersion->retireEpoch = (size_t)(0);
+        pVersion->nextRetired = NULL;
+    }
+
+    return pVersion;
+}
+
+/*Releases a version.*/
+static void cSnapshotMap_freeVersion(cSnapshotVersion* pVersion)
+{
+    cMap_clear(&(pVersion->map));
+    free((void*)pVersion);
+}
+
+/*Creates a copy of the published version. It is called by the writers only, under the lock.
+  \return : the version, NULL on failure*/
+static cSnapshotVersion* cSnapshotMap_copyCurrent(cSnapshotMap* pInstance)
+{
+    cSnapshotVersion* pCurrent = atomic_load_explicit(&(pInstance->current), memory_order_relaxed);
+    cSnapshotVersion* pVersion = cSnapshotMap_newVersion(pInstance);
+
+    if(NULL != pVersion)
+    {
+        const size_t mapSize = cMap_size(&(pCurrent->map));
+
+        if(0 == cMap_reserve(&(pVersion->map), mapSize))
+        {
+            size_t idx;
+            cPair pair;
+
+            for(idx = 0; idx < mapSize; ++idx)
+            {
+                (void)cMap_getAt(&(pCurrent->map), idx, &pair);
+
+                if(0 != cMap_insert(&(pVersion->map), &pair))
+                {
+                    break;
+                }
+            }
+
+            if(idx < mapSize)
+            {
+                cSnapshotMap_freeVersion(pVersion);
+                pVersion = NULL;
+            }
+        }
+        else
+        {
+            cSnapshotMap_freeVersion(pVersion);
+            pVersion = NULL;
+        }
+    }
+
+    return pVersion;
+}
+
+/*Publishes the given version and retires the replaced one. The readers which may still
+  see the replaced version have entered their sections at an epoch before retireEpoch.*/
+static void cSnapshotMap_replace(cSnapshotMap* pInstance, cSnapshotVersion* pVersion)
+{
+    cSnapshotVersion* pOld = atomic_exchange(&(pInstance->current), pVersion);
+
+    pOld->retireEpoch = atomic_fetch_add(&(pInstance->epoch), (size_t)(1)) + 1;
+    pOld->nextRetired = pInstance->retiredList;
+    pInstance->retiredList = pOld;
+}
+
+/*Releases the retired versions which can not be seen by any reader anymore.
+  It is called by the writers only, under the lock.*/
+static void cSnapshotMap_reclaimLocked(cSnapshotMap* pInstance)
+{
+    if(NULL != pInstance->retiredList)
+    {
+        size_t minEpoch = atomic_load(&(pInstance->epoch));
+        cSnapshotVersion** ppVersion = &(pInstance->retiredList);
+        size_t readerIdx;
+
+        /*The oldest epoch of the readers in a section*/
+        for(readerIdx = 0; readerIdx < CSNAPSHOTMAP_MAX_READERS; ++readerIdx)
+        {
+            const size_t readerEpoch = atomic_load(&(pInstance->readerArray[readerIdx].slot.epoch));
+
+            if(((size_t)(0) != readerEpoch) && (readerEpoch < minEpoch))
+            {
+                minEpoch = readerEpoch;
+            }
+        }
+
+        while(NULL != *ppVersion)
+        {
+            cSnapshotVersion* pVersion = *ppVersion;
+
+            /*The snapshots are counted after the epochs, since a snapshot is taken in a section*/
+            if((pVersion->retireEpoch <= minEpoch) &&
+               ((size_t)(0) == atomic_load_explicit(&(pVersion->refCount), memory_order_acquire)))
+            {
+                *ppVersion = pVersion->nextRetired;
+                cSnapshotMap_freeVersion(pVersion);
+            }
+            else
+            {
+                ppVersion = &(pVersion->nextRetired);
+            }
+        }
+    }
+}
+
+int 	cSnapshotMap_registerReader(cSnapshotMap* pInstance, cSnapshotReader** ppReader)
+{
+    int result = -1;
+    size_t readerIdx;
+
+    for(readerIdx = 0; readerIdx < CSNAPSHOTMAP_MAX_READERS; ++readerIdx)
+    {
+        int expected = 0;
+
+        if(atomic_compare_exchange_strong(&(pInstance->readerArray[readerIdx].slot.inUse), &expected, 1))
+        {
+            *ppReader = &(pInstance->readerArray[readerIdx]);
+            result = 0;
+            break;
+        }
+    }
+
+    return result;
+}
+
+void 	cSnapshotMap_unregisterReader(cSnapshotMap* pInstance, cSnapshotReader* pReader)
+{
+    (void)pInstance;
+    atomic_store_explicit(&(pReader->slot.epoch), (size_t)(0), memory_order_release);
+    atomic_store_explicit(&(pReader->slot.inUse), 0, memory_order_release);
+}
+
+cMap* 	cSnapshotMap_enter(cSnapshotMap* pInstance, cSnapshotReader* pReader)
+{
+    /*The epoch must be visible to the writers before the version is read*/
+    atomic_store(&(pReader->slot.epoch), atomic_load_explicit(&(pInstance->epoch), memory_order_relaxed));
+
+    return &(atomic_load(&(pInstance->current))->map);
+}
+
+void 	cSnapshotMap_leave(cSnapshotMap* pInstance, cSnapshotReader* pReader)
+{
+    (void)pInstance;
+    atomic_store_explicit(&(pReader->slot.epoch), (size_t)(0), memory_order_release);
+}
+
+int 	cSnapshotMap_find(cSnapshotMap* pInstance, cSnapshotReader* pReader, const void* key, void* value)
+{
+    int result = -1;
+
+    if(NULL != key)
+    {
+        cMap* pMap = cSnapshotMap_enter(pInstance, pReader);
+        cPair pair;
+
+        if(0 == cMap_find(pMap, key, &pair))
+        {
+            if(NULL != value)
+            {
+                memcpy(value, pair.second, pInstance->valueSize);
+            }
+            result = 0;
+        }
+
+        cSnapshotMap_leave(pInstance, pReader);
+    }
+
+    return result;
+}
+
+cSnapshotVersion* cSnapshotMap_acquire(cSnapshotMap* pInstance, cSnapshotReader* pReader)
+{
+    cSnapshotVersion* pVersion;
+
+    (void)cSnapshotMap_enter(pInstance, pReader);
+
+    pVersion = atomic_load(&(pInstance->current));
+    (void)atomic_fetch_add_explicit(&(pVersion->refCount), (size_t)(1), memory_order_relaxed);
+
+    cSnapshotMap_leave(pInstance, pReader);
+
+    return pVersion;
+}
+
+void 	cSnapshotMap_release(cSnapshotMap* pInstance, cSnapshotVersion* pVersion)
+{
+    (void)pInstance;
+    (void)atomic_fetch_sub_explicit(&(pVersion->refCount), (size_t)(1), memory_order_release);
+}
+
+int 	cSnapshotMap_publish(cSnapshotMap* pInstance, const void* keys, const void* values, const size_t count)
+{
+    int result = -1;
+    cSnapshotVersion* pVersion;
+
+    CSNAPSHOTMAP_LOCK(&(pInstance->writerLock));
+
+    pVersion = cSnapshotMap_newVersion(pInstance);
+
+    if(NULL != pVersion)
+    {
+        if(0 == cMap_buildFrom(&(pVersion->map), keys, values, count))
+        {
+            cSnapshotMap_replace(pInstance, pVersion);
+            result = 0;
+        }
+        else
+        {
+            cSnapshotMap_freeVersion(pVersion);
+        }
+    }
+
+    cSnapshotMap_reclaimLocked(pInstance);
+
+    CSNAPSHOTMAP_UNLOCK(&(pInstance->writerLock));
+
+    return result;
+}
+
+int 	cSnapshotMap_insertBatch(cSnapshotMap* pInstance, const void* keys, const void* values, const size_t count)
+{
+    int result = -1;
+    cSnapshotVersion* pVersion;
+
+    CSNAPSHOTMAP_LOCK(&(pInstance->writerLock));
+
+    pVersion = cSnapshotMap_copyCurrent(pInstance);
+
+    if(NULL != pVersion)
+    {
+        if(0 == cMap_insertBatch(&(pVersion->map), keys, values, count))
+        {
+            cSnapshotMap_replace(pInstance, pVersion);
+            result = 0;
+        }
+        else
+        {
+            cSnapshotMap_freeVersion(pVersion);
+        }
+    }
+
+    cSnapshotMap_reclaimLocked(pInstance);
+
+    CSNAPSHOTMAP_UNLOCK(&(pInstance->writerLock));
+
+    return result;
+}
+
+int 	cSnapshotMap_erase(cSnapshotMap* pInstance, const void* key)
+{
+    int result = -1;
+    cPair pair;
+
+    CSNAPSHOTMAP_LOCK(&(pInstance->writerLock));
+
+    /*Copy the version only if the key is there*/
+    if(0 == cMap_find(&(atomic_load_explicit(&(pInstance->current), memory_order_relaxed)->map), key, &pair))
+    {
+        cSnapshotVersion* pVersion = cSnapshotMap_copyCurrent(pInstance);
+
+        if(NULL != pVersion)
+        {
+            if(0 == cMap_erase(&(pVersion->map), key))
+            {
+                cSnapshotMap_replace(pInstance, pVersion);
+                result = 0;
+            }
+            else
+            {
+                cSnapshotMap_freeVersion(pVersion);
+            }
+        }
+    }
+
+    cSnapshotMap_reclaimLocked(pInstance);
+
+    CSNAPSHOTMAP_UNLOCK(&(pInstance->writerLock));
+
+    return result;
+}
+
+void 	cSnapshotMap_reclaim(cSnapshotMap* pInstance)
+{
+    CSNAPSHOTMAP_LOCK(&(pInstance->writerLock));
+    cSnapshotMap_reclaimLocked(pInstance);
+    CSNAPSHOTMAP_UNLOCK(&(pInstance->writerLock));
+}
+
+void 	cSnapshotMap_destroy(cSnapshotMap* pInstance)
+{
+    cSnapshotVersion* pCurrent = atomic_load(&(pInstance->current));
+
+    while(NULL != pInstance->retiredList)
+    {
+        cSnapshotVersion* pVersion = pInstance->retiredList;
+        pInstance->retiredList = pVersion->nextRetired;
+        cSnapshotMap_freeVersion(pVersion);
+    }
+
+    if(NULL != pCurrent)
+    {
+        cSnapshotMap_freeVersion(pCurrent);
+        atomic_store(&(pInstance->current), (cSnapshotVersion*)NULL);
+    }
+
+    if(NULL != pInstance->readerArray)
+    {
+        free((void*)pInstance->readerArray);
+        pInstance->readerArray = NULL;
+        CSNAPSHOTMAP_LOCK_DESTROY(&(pInstance->writerLock));
+    }
+}
+
+int concreteConstructCSnapshotMap(cSnapshotMap* instance, size_t keySize, size_t valueSize,
+                                  cMapHashFunc hashFunc, cMapCompareFunc compareFunc)
+{
+    int result = -1;
+
+    if(NULL != instance)
+    {
+        cSnapshotVersion* pVersion;
+
+        instance->keySize     = keySize;
+        instance->valueSize   = valueSize;
+        instance->hashFunc    = (NULL != hashFunc) ? hashFunc : cMap_defaultHash;
+        instance->compareFunc = compareFunc;
+        instance->retiredList = NULL;
+        atomic_init(&(instance->epoch), (size_t)(1));
+        atomic_init(&(instance->current), (cSnapshotVersion*)NULL);
+
+        instance->readerArray = (cSnapshotReader*)malloc(CSNAPSHOTMAP_MAX_READERS * sizeof(cSnapshotReader));
+        pVersion = cSnapshotMap_newVersion(instance);
+
+        if((NULL != instance->readerArray) && (NULL != pVersion) &&
+           (0 == CSNAPSHOTMAP_LOCK_INIT(&(instance->writerLock))))
+        {
+            size_t readerIdx;
+
+            for(readerIdx = 0; readerIdx < CSNAPSHOTMAP_MAX_READERS; ++readerIdx)
+            {
+                atomic_init(&(instance->readerArray[readerIdx].slot.epoch), (size_t)(0));
+                atomic_init(&(instance->readerArray[readerIdx].slot.inUse), 0);
+            }
+
+            atomic_init(&(instance->current), pVersion);
+            result = 0;
+        }
+        else
+        {
+            free((void*)instance->readerArray);
+            instance->readerArray = NULL;
+
+            if(NULL != pVersion)
+            {
+                cSnapshotMap_freeVersion(pVersion);
+            }
+        }
+    }
+
+    return result;
+}
@@ -0,0 +1,221 @@
+ /*
+ Snapshot (read-copy-update) map implementation
+
+ It is a thread safe map for read-mostly tables. The pairs are kept in an immutable version, a
+ hashed cMap which is never modified once it is published. Writers build a new version (by the
+ bulk build of cMap, or by a copy of the current version with the changes applied) and publish
+ it with an atomic pointer swap. Readers never take a lock and never write a shared cache line:
+
+ - Read sections: a reader registered once per thread enters a section by writing the current
+   epoch into its own reader slot, runs any number of lookups on the version, and leaves it.
+   The lookups themselves are plain cMap_find calls without any atomic operation.
+ - Snapshots: a reader can also hold a version beyond a read section by acquiring a reference
+   counted snapshot, and release it later from any thread.
+
+ The replaced versions are reclaimed by the writers (epoch based reclamation): a version is
+ released once no reader is in a section entered before it was replaced and no snapshot of it is
+ held anymore.
+
+ NOTE: It requires C11 atomics (<stdatomic.h>) and the platform threads (POSIX threads, or SRW
+ locks on Windows) for the writer lock. It should be deallocated by using "destroy" method at the
+ end of its use, after all of the readers are unregistered.
+
+ Authors: akozan
+
+ Change Log:
+ 16.10.2026 first release
+ ------------------------------------------------------------------------------------------------*/
+
+
+#ifndef CSNAPSHOTMAP_H
+#define CSNAPSHOTMAP_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#if defined(__cplusplus) || !defined(__STDC_VERSION__) || (__STDC_VERSION__ < 201112L) || defined(__STDC_NO_ATOMICS__)
+#error "csnapshotmap requires C11 atomics"
+#endif
+
+#include <stddef.h>
+#include <stdatomic.h>
+#include "cmap.h"
+
+#if defined(_WIN32)
+#include <windows.h>
+/*lock of the writers*/
+typedef SRWLOCK cSnapshotMapLock;
+#else
+#include <pthread.h>
+/*lock of the writers*/
+typedef pthread_mutex_t cSnapshotMapLock;
+#endif
+
+/*Size of the cache line the reader slots are padded to*/
+#ifndef CSNAPSHOTMAP_CACHE_LINE_SIZE
+#define CSNAPSHOTMAP_CACHE_LINE_SIZE        64
+#endif
+
+/*Maximum number of the readers registered at the same time*/
+#ifndef CSNAPSHOTMAP_MAX_READERS
+#define CSNAPSHOTMAP_MAX_READERS            64
+#endif
+
+/*Immutable version of the map*/
+typedef struct cSnapshotVersionType cSnapshotVersion;
+
+struct cSnapshotVersionType{
+     /*pairs of the version, a hashed cMap. DO NOT MODIFY!*/
+     cMap map;
+     /*number of the snapshots held*/
+     atomic_size_t refCount;
+     /*epoch the version was replaced at*/
+     size_t retireEpoch;
+     /*next version in the list of the replaced ones*/
+     cSnapshotVersion* nextRetired;
+};
+
+/*Reader slot, owned by a single reader thread. It is padded to a whole cache line, so
+  that the readers do not write the same line.*/
+typedef union {
+     struct {
+         /*epoch of the read section, 0 out of the sections*/
+         atomic_size_t epoch;
+         /*whether the slot is registered*/
+         atomic_int inUse;
+     } slot;
+     char padding[CSNAPSHOTMAP_CACHE_LINE_SIZE];
+} cSnapshotReader;
+
+typedef struct cSnapshotMapType cSnapshotMap;
+
+/*cSnapshotMap type.
+ These members are intended to be private.
+ DO NOT MODIFY THE VALUES DIRECTLY!*/
+struct cSnapshotMapType{
+     /*published version*/
+     _Atomic(cSnapshotVersion*) current;
+     /*global epoch, incremented when a version is replaced. Starts from 1*/
+     atomic_size_t epoch;
+     /*reader slots*/
+     cSnapshotReader* readerArray;
+     /*replaced versions waiting to be released*/
+     cSnapshotVersion* retiredList;
+     /*lock of the writers*/
+     cSnapshotMapLock writerLock;
+     /*size of the key type in bytes*/
+     size_t keySize;
+     /*size of the value type in bytes*/
+     size_t valueSize;
+     /*hash function of the keys*/
+     cMapHashFunc hashFunc;
+     /*comparison function of the keys, NULL for bytewise comparison*/
+     cMapCompareFunc compareFunc;
+};
+
+/* Registers the calling thread as a reader.
+	\param instance : cSnapshotMap instance pointer
+	\param ppReader : the reader slot of the thread
+	\return 		: result: 0 = Success, -1 = Failure (all of the slots are in use)*/
+int 	cSnapshotMap_registerReader(cSnapshotMap* pInstance, cSnapshotReader** ppReader);
+
+/* Unregisters a reader. It must be out of any read section.
+	\param instance : cSnapshotMap instance pointer
+	\param pReader  : reader slot
+	\return 		: none.*/
+void 	cSnapshotMap_unregisterReader(cSnapshotMap* pInstance, cSnapshotReader* pReader);
+
+/* Enters a read section and returns the published version. The version stays valid until
+   the section is left, and it can be searched by cMap_find and iterated by cMap_getAt, but
+   it must NOT be modified. Sections must not be nested.
+	\param instance : cSnapshotMap instance pointer
+	\param pReader  : reader slot of the calling thread
+	\return 		: the map of the version*/
+cMap* 	cSnapshotMap_enter(cSnapshotMap* pInstance, cSnapshotReader* pReader);
+
+/* Leaves the read section.
+	\param instance : cSnapshotMap instance pointer
+	\param pReader  : reader slot of the calling thread
+	\return 		: none.*/
+void 	cSnapshotMap_leave(cSnapshotMap* pInstance, cSnapshotReader* pReader);
+
+/* Copies the value of the given key in a read section of its own.
+	\param instance : cSnapshotMap instance pointer
+	\param pReader  : reader slot of the calling thread
+	\param key 		: pointer of the key.
+	\param value 	: buffer of valueSize bytes receiving the value, may be NULL to test the key only
+	\return 		: result: 0 = Success, -1 = Failure (the key is not found)*/
+int 	cSnapshotMap_find(cSnapshotMap* pInstance, cSnapshotReader* pReader, const void* key, void* value);
+
+/* Takes a reference of the published version, which stays valid until it is released.
+	\param instance : cSnapshotMap instance pointer
+	\param pReader  : reader slot of the calling thread
+	\return 		: the version. Its "map" member can be searched but must NOT be modified*/
+cSnapshotVersion* cSnapshotMap_acquire(cSnapshotMap* pInstance, cSnapshotReader* pReader);
+
+/* Releases a version taken by cSnapshotMap_acquire. It can be called from any thread.
+	\param instance : cSnapshotMap instance pointer
+	\param pVersion : the version
+	\return 		: none.*/
+void 	cSnapshotMap_release(cSnapshotMap* pInstance, cSnapshotVersion* pVersion);
+
+/* Replaces the whole map with the given pairs, built by cMap_buildFrom.
+	\param instance : cSnapshotMap instance pointer
+	\param keys 	: array of "count" keys, keySize bytes each.
+	\param values 	: array of "count" values, valueSize bytes each.
+	\param count 	: number of the pairs.
+	\return 		: result: 0 = Success, -1 = Failure*/
+int 	cSnapshotMap_publish(cSnapshotMap* pInstance, const void* keys, const void* values, const size_t count);
+
+/* Publishes a copy of the map with the given pairs added, as cMap_insertBatch does.
+	\param instance : cSnapshotMap instance pointer
+	\param keys 	: array of "count" keys, keySize bytes each.
+	\param values 	: array of "count" values, valueSize bytes each.
+	\param count 	: number of the pairs.
+	\return 		: result: 0 = Success, -1 = Failure*/
+int 	cSnapshotMap_insertBatch(cSnapshotMap* pInstance, const void* keys, const void* values, const size_t count);
+
+/* Publishes a copy of the map without the pair containing given key.
+	\param instance : cSnapshotMap instance pointer
+	\param key 		: pointer of the key.
+	\return 		: result: 0 = Success, -1 = Failure (the key is not found)*/
+int 	cSnapshotMap_erase(cSnapshotMap* pInstance, const void* key);
+
+/* Releases the replaced versions which are not used by the readers anymore. It is
+   also run by every write.
+	\param instance : cSnapshotMap instance pointer
+	\return 		: none.*/
+void 	cSnapshotMap_reclaim(cSnapshotMap* pInstance);
+
+/* Releases all of the versions, the reader slots and the lock. The map must not be
+   in use by any other thread.
+	\param instance : cSnapshotMap instance pointer
+	\return 		: none.*/
+void 	cSnapshotMap_destroy(cSnapshotMap* pInstance);
+
+
+/*---------------------------------------------------------------------------*/
+/*This function constructs an allocated cSnapshotMap object with an empty version.
+  Need to call after the creation of object. Unlike the other constructors it
+  allocates, so it may fail.
+  \param instance 	 : allocated cSnapshotMap pointer to be constructed
+  \param keySize 	 : size of the key type
+  \param valueSize 	 : size of the value type
+  \param hashFunc 	 : hash function of the keys, NULL for cMap_defaultHash
+  \param compareFunc : comparison function of the keys, NULL for bytewise comparison
+  \return		  	 : result: 0 = Success, -1 = Failure*/
+int concreteConstructCSnapshotMap(cSnapshotMap* instance, size_t keySize, size_t valueSize,
+                                  cMapHashFunc hashFunc, cMapCompareFunc compareFunc);
+
+/*This is a macro wrapper for "concreteConstructCSnapshotMap" function, provides creation using
+typenames. (C++ template logic)*/
+#define constructCSnapshotMap(instance, TYPE1, TYPE2, hashFunc, compareFunc)\
+        concreteConstructCSnapshotMap(instance, sizeof(TYPE1), sizeof(TYPE2), hashFunc, compareFunc)
+/*---------------------------------------------------------------------------*/
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
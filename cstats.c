@@ -0,0 +1,139 @@
+#include <stdio.h>
+#include "cstats.h"
+
+/*Registry of the containers holding an allocation, the last registered one first*/
+static cStatsEntry* cStatsRegistry = NULL;
+
+/*Lock of the registry*/
+static void (*cStatsLockFunc)(void* context) = NULL;
+static void (*cStatsUnlockFunc)(void* context) = NULL;
+static void* cStatsLockContext = NULL;
+
+static void cStats_lock(void)
+{
+    if(NULL != cStatsLockFunc)
+    {
+        cStatsLockFunc(cStatsLockContext);
+    }
+}
+
+static void cStats_unlock(void)
+{
+    if(NULL != cStatsUnlockFunc)
+    {
+        cStatsUnlockFunc(cStatsLockContext);
+    }
+}
+
+void    cStats_setLock(void (*lockFunc)(void* context), void (*unlockFunc)(void* context), void* context)
+{
+    cStatsLockFunc    = lockFunc;
+    cStatsUnlockFunc  = unlockFunc;
+    cStatsLockContext = context;
+}
+
+static void cStats_register(cStatsEntry* pEntry, const void* container)
+{
+    if(0 == pEntry->registered)
+    {
+        cStats_lock();
+
+        pEntry->container = container;
+        pEntry->prev = NULL;
+        pEntry->next = cStatsRegistry;
+
+        if(NULL != cStatsRegistry)
+        {
+            cStatsRegistry->prev = pEntry;
+        }
+        cStatsRegistry = pEntry;
+        pEntry->registered = 1;
+
+        cStats_unlock();
+    }
+}
+
+static void cStats_unregister(cStatsEntry* pEntry)
+{
+    if(0 != pEntry->registered)
+    {
+        cStats_lock();
+
+        if(NULL != pEntry->prev)
+        {
+            pEntry->prev->next = pEntry->next;
+        }
+        else
+        {
+            cStatsRegistry = pEntry->next;
+        }
+
+        if(NULL != pEntry->next)
+        {
+            pEntry->next->prev = pEntry->prev;
+        }
+
+        pEntry->prev = NULL;
+        pEntry->next = NULL;
+        pEntry->registered = 0;
+
+        cStats_unlock();
+    }
+}
+
+void    cStats_recordAlloc(cStatsEntry* pEntry, const void* container, size_t allocSize, int isAllocated)
+{
+    ++(pEntry->stats.reallocCount);
+
+    if(allocSize > pEntry->stats.peakAllocSize)
+    {
+        pEntry->stats.peakAllocSize = allocSize;
+    }
+
+    if(0 != isAllocated)
+    {
+        cStats_register(pEntry, container);
+    }
+    else
+    {
+        cStats_unregister(pEntry);
+    }
+}
+
+size_t  cStats_forEach(cStatsVisitFunc visit, void* context)
+{
+    size_t count = 0;
+    const cStatsEntry* pEntry;
+
+    cStats_lock();
+
+    for(pEntry = cStatsRegistry; NULL != pEntry; pEntry = pEntry->next)
+    {
+        if(NULL != visit)
+        {
+            visit(pEntry->kind, pEntry->container, &(pEntry->stats), context);
+        }
+        ++count;
+    }
+
+    cStats_unlock();
+
+    return count;
+}
+
+static void cStats_print(cStatsKind kind, const void* container, const cStats* pStats, void* context)
+{
+    FILE* file = (FILE*)context;
+    const double comparesPerFind = (0 != pStats->findCount) ? ((double)pStats->compareCount / (double)pStats->findCount) : 0.0;
+
+    fprintf(file, "%-7s %p finds %lu compares %lu (%.1f/find) inserts %lu erases %lu reallocs %lu moved %lu bytes peak alloc %lu\n",
+            (CSTATS_KIND_VECTOR == kind) ? "cVector" : "cMap", (void*)container,
+            (unsigned long)pStats->findCount, (unsigned long)pStats->compareCount, comparesPerFind,
+            (unsigned long)pStats->insertCount, (unsigned long)pStats->eraseCount, (unsigned long)pStats->reallocCount,
+            (unsigned long)pStats->bytesMoved, (unsigned long)pStats->peakAllocSize);
+}
+
+size_t  cStats_dump(FILE* file)
+{
+    return cStats_forEach(cStats_print, (void*)file);
+}
@@ -0,0 +1,154 @@
+/*
+ ANSI C operation statistics of the dynamic containers
+
+ When CSTATS_ENABLED is defined, cVector and cMap count the work done by their hot paths per
+ instance: finds, key comparisons (compared elements, probed slots and binary search steps),
+ inserts, erases, reallocations of their arrays, bytes moved by the shifting insert and erase
+ and the peak allocation size. They can be queried by cVector_stats and cMap_stats.
+
+ The containers holding an allocation are also linked into a global registry, so that all of
+ them can be visited by cStats_forEach or printed by cStats_dump, e.g. periodically, to spot
+ the ones doing long linear scans or reallocating constantly. A container joins the registry
+ when its array is allocated and leaves it when the array is released (by "clear" or by
+ shrinking to empty).
+
+ When CSTATS_ENABLED is not defined, the counting compiles to nothing, the containers carry no
+ statistics members, cVector_stats and cMap_stats fail and the registry is empty.
+
+ NOTE: CSTATS_ENABLED changes the layout of cVector and cMap, so it must be defined for all of
+ the sources of the project, not per file. A registered container must not be copied or moved.
+ The registry itself is not thread safe: if containers are allocated or released from several
+ threads (e.g. the shards of cConcurrentMap), a lock must be given by cStats_setLock. The
+ counters of an instance are updated by the thread modifying it, without any lock.
+
+ Authors: akozan
+
+ Change Log:
+ 16.10.2026 first release
+ ------------------------------------------------------------------------------------------------*/
+
+
+#ifndef CSTATS_H
+#define CSTATS_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stddef.h>
+#include <stdio.h>
+
+/*Kind of a registered container*/
+typedef enum {
+    CSTATS_KIND_VECTOR = 0,
+    CSTATS_KIND_MAP
+} cStatsKind;
+
+/*cStats type, the counters of a container since its construction*/
+typedef struct {
+    /*number of the key lookups, including the ones made by insert and erase*/
+    size_t findCount;
+    /*number of the key comparisons: compared elements of the linear scans, probed slots of
+      the hash index and steps of the binary searches*/
+    size_t compareCount;
+    /*number of the successful insertions, including the overwritten values*/
+    size_t insertCount;
+    /*number of the successful erasures*/
+    size_t eraseCount;
+    /*number of the allocations, reallocations and releases of the arrays*/
+    size_t reallocCount;
+    /*number of the bytes moved to open or close a gap by insert and erase*/
+    size_t bytesMoved;
+    /*peak allocation size, in terms of elements (cVector) or pairs (cMap)*/
+    size_t peakAllocSize;
+} cStats;
+
+typedef struct cStatsEntryType cStatsEntry;
+
+/*cStatsEntry type, the statistics member of a container.
+ These members are intended to be private.
+ DO NOT MODIFY THE VALUES DIRECTLY!*/
+struct cStatsEntryType {
+    /*counters of the container*/
+    cStats stats;
+    /*kind of the container*/
+    cStatsKind kind;
+    /*container owning the entry, set at its registration*/
+    const void* container;
+    /*whether the entry is linked into the registry*/
+    int registered;
+    /*neighbours in the registry*/
+    cStatsEntry* prev;
+    cStatsEntry* next;
+};
+
+/*Visitor function type of cStats_forEach.
+  \param kind      : kind of the container
+  \param container : cVector or cMap instance pointer
+  \param pStats    : counters of the container
+  \param context   : user data given to cStats_forEach
+  \return          : none*/
+typedef void (*cStatsVisitFunc)(cStatsKind kind, const void* container, const cStats* pStats, void* context);
+
+/* Sets the lock of the registry, needed only if containers are allocated or released from
+   several threads. It should be called before any container is registered.
+	\param lockFunc   : acquires the lock, NULL for none
+	\param unlockFunc : releases the lock, NULL for none
+	\param context    : user data passed to the functions
+	\return           : none*/
+void    cStats_setLock(void (*lockFunc)(void* context), void (*unlockFunc)(void* context), void* context);
+
+/* Calls "visit" for each of the registered containers, under the lock of the registry.
+   The visitor must not allocate or release any container array.
+	\param visit   : visitor function
+	\param context : user data passed to the visitor
+	\return        : number of the registered containers*/
+size_t  cStats_forEach(cStatsVisitFunc visit, void* context);
+
+/* Prints a line per registered container with its counters and the average comparisons
+   per find, which exposes the long linear scans.
+	\param file : output stream
+	\return     : number of the registered containers*/
+size_t  cStats_dump(FILE* file);
+
+/* Internal function of the containers. It records an allocator call on the arrays of a
+   container and its new allocation size, and links the container into the registry or unlinks
+   it from there according to whether it still holds an allocation.*/
+void    cStats_recordAlloc(cStatsEntry* pEntry, const void* container, size_t allocSize, int isAllocated);
+
+#ifdef CSTATS_ENABLED
+
+/*Declares the statistics member of a container*/
+#define CSTATS_MEMBER                               cStatsEntry statsEntry;
+
+/*Initializes the statistics member of a container of the given kind*/
+#define CSTATS_INIT(pInstance, entryKind)           do {\
+        memset((void*)&((pInstance)->statsEntry), 0, sizeof((pInstance)->statsEntry));\
+        (pInstance)->statsEntry.kind = (entryKind);\
+    } while(0)
+
+/*Adds "count" to the given counter*/
+#define CSTATS_ADD(pInstance, counter, count)       ((pInstance)->statsEntry.stats.counter += (size_t)(count))
+
+/*Records an allocator call on the arrays of a container, see cStats_recordAlloc*/
+#define CSTATS_ALLOC(pInstance, allocSize, isAllocated)  cStats_recordAlloc(&((pInstance)->statsEntry), (const void*)(pInstance), (allocSize), (isAllocated))
+
+/*Copies the counters of a container to *pStats
+  \return : result: 0 = Success, -1 = Failure*/
+#define CSTATS_GET(pInstance, pStats)               ((NULL != (pStats)) ? (*(pStats) = (pInstance)->statsEntry.stats, 0) : -1)
+
+#else
+
+#define CSTATS_MEMBER
+#define CSTATS_INIT(pInstance, entryKind)           ((void)0)
+#define CSTATS_ADD(pInstance, counter, count)       ((void)0)
+#define CSTATS_ALLOC(pInstance, allocSize, isAllocated)  ((void)0)
+#define CSTATS_GET(pInstance, pStats)               ((void)(pInstance), (void)(pStats), -1)
+
+#endif
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
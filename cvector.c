@@ -1,11 +1,12 @@
 #include <stdlib.h>
 #include <string.h>
 #include "cvector.h"
+#include "cfind.h"
 
-/*This macro defines the power value used in calculation of vector allocation size, in terms of pair count.
-If given 1, the insert and erase methods will reallocate the vector whenever an element is
-added or removed.
-Otherwise, these methods will reallocate the vector if required, with the nearest power of the
+/*This macro defines the default power value used in calculation of vector allocation size, in terms of
+element count. It can be changed per instance by cVector_setPolicy.
+If given 1, the insert method will reallocate the vector whenever an element is added.
+Otherwise, it will reallocate the vector if required, with the nearest power of the
 CVECTOR_ALLOC_POWER_SIZE.
 The value 2 will make it work in the same allocation strategy with C++ std::vector container.
 It provides lesser memory fragmentation.
@@ -13,6 +14,10 @@ NOTE: Do not define it as 0!*/
 #define CVECTOR_ALLOC_POWER_SIZE                2
 #define CVECTOR_ALLOC_POWER_SIZE_RND            ((size_t)(CVECTOR_ALLOC_POWER_SIZE))
 
+/*This macro defines the default shrink divisor of the vectors. The erase methods shrink the vector
+when it is less than 1/CVECTOR_SHRINK_DIVISOR full. CPOLICY_NEVER_SHRINK disables the shrinking.*/
+#define CVECTOR_SHRINK_DIVISOR                  ((size_t)(4))
+
 /*Gives the pointer integer value of the array element at the specified index
   Why not to return directly the void pointer? That's because we need the
   pointer address value in integer to perform pointer arithmetics on void
@@ -23,6 +28,105 @@ NOTE: Do not define it as 0!*/
 #define CVECTOR_ALIGN_SIZE(size, align)  ((size) % (align)) ? ((size) + ((align) - ((size) % (align)))) : (size)
 
 
+/*Tells whether the value is a power of 2*/
+#define CVECTOR_IS_POWER_OF_2(value)                (((size_t)(0) != (value)) && ((size_t)(0) == ((value) & ((value) - 1))))
+
+/*Tells whether the array is on the heap (or in the allocator), instead of the inline buffer*/
+#define CVECTOR_IS_ARRAY_ALLOCATED(pInstance)       ((NULL != (pInstance)->array) && ((pInstance)->inlineBuffer != (pInstance)->array))
+
+/*Reallocates the array with "newAllocSize" elements, or releases it if zero. The inline
+  buffer of a small vector is used instead whenever it can hold "newAllocSize" elements.
+  \return : result: 0 = Success, -1 = Failure*/
+static int cVector_resize(cVector* pInstance, const size_t newAllocSize)
+{
+    int result = 0;
+
+    if((size_t)(0) == newAllocSize)
+    {
+        if(CVECTOR_IS_ARRAY_ALLOCATED(pInstance))
+        {
+            cAllocator_freeAligned(pInstance->allocator, pInstance->array, (pInstance->allocSize * pInstance->elemSizeAligned), pInstance->baseAlign);
+            CSTATS_ALLOC(pInstance, (size_t)(0), 0);
+        }
+        pInstance->array = NULL;
+        pInstance->allocSize = (size_t)(0);
+    }
+    else if(newAllocSize <= pInstance->inlineSize)
+    {
+        if(CVECTOR_IS_ARRAY_ALLOCATED(pInstance))
+        {
+            memcpy(pInstance->inlineBuffer, pInstance->array, (pInstance->vectSize * pInstance->elemSizeAligned));
+            cAllocator_freeAligned(pInstance->allocator, pInstance->array, (pInstance->allocSize * pInstance->elemSizeAligned), pInstance->baseAlign);
+            CSTATS_ALLOC(pInstance, pInstance->inlineSize, 0);
+        }
+        pInstance->array = pInstance->inlineBuffer;
+        pInstance->allocSize = pInstance->inlineSize;
+    }
+    else if(newAllocSize != pInstance->allocSize)
+    {
+        void* newArrayPtr;
+
+        if(CVECTOR_IS_ARRAY_ALLOCATED(pInstance))
+        {
+            newArrayPtr = cAllocator_reallocAligned(pInstance->allocator, pInstance->array, (pInstance->allocSize * pInstance->elemSizeAligned), (newAllocSize * pInstance->elemSizeAligned), pInstance->baseAlign);
+        }
+        else
+        {
+            newArrayPtr = cAllocator_allocAligned(pInstance->allocator, (newAllocSize * pInstance->elemSizeAligned), pInstance->baseAlign);
+
+            if((NULL != newArrayPtr) && (NULL != pInstance->array))
+            {
+                /*Spill the inline buffer to the heap*/
+                memcpy(newArrayPtr, pInstance->array, (pInstance->vectSize * pInstance->elemSizeAligned));
+            }
+        }
+
+        if(NULL != newArrayPtr)
+        {
+            pInstance->array = newArrayPtr;
+            pInstance->allocSize = newAllocSize;
+            CSTATS_ALLOC(pInstance, newAllocSize, 1);
+        }
+        else
+        {
+            result = -1;
+        }
+    }
+
+    return result;
+}
+
+/*Makes the array able to hold "count" elements, growing it with the nearest power of the
+  growth factor in a single reallocation.
+  \return : result: 0 = Success, -1 = Failure*/
+static int cVector_reserveFor(cVector* pInstance, const size_t count)
+{
+    int result = 0;
+
+    if(count > pInstance->allocSize)
+    {
+        const size_t growthFactor = pInstance->policy.growthFactor;
+        size_t newAllocSize = ((size_t)(0) == pInstance->allocSize) ? growthFactor : pInstance->allocSize;
+
+        if((size_t)(1) < growthFactor)
+        {
+            /*Allocate space with the nearest power*/
+            while(newAllocSize < count)
+            {
+                newAllocSize *= growthFactor;
+            }
+        }
+        else if(newAllocSize < count)
+        {
+            newAllocSize = count;
+        }
+
+        result = cVector_resize(pInstance, newAllocSize);
+    }
+
+    return result;
+}
+
 void* 	cVector_getAt(cVector* pInstance, const size_t idx)
 {
     return (idx < pInstance->vectSize) ? (void*)CVECTOR_CALC_IDX_PTR_VAL(pInstance, idx) : NULL;
@@ -35,11 +139,12 @@ size_t 	cVector_size(const cVector* pInstance)
 
 void 	cVector_clear(cVector* pInstance)
 {
-    if(NULL != pInstance->array)
+    if(CVECTOR_IS_ARRAY_ALLOCATED(pInstance))
     {
-        free(pInstance->array);
-        pInstance->array = NULL;
+        cAllocator_freeAligned(pInstance->allocator, pInstance->array, (pInstance->allocSize * pInstance->elemSizeAligned), pInstance->baseAlign);
+        CSTATS_ALLOC(pInstance, (size_t)(0), 0);
     }
+    pInstance->array = NULL;
     pInstance->vectSize = (size_t)(0);
     pInstance->allocSize = (size_t)(0);
 }
@@ -51,73 +156,176 @@ size_t 	cVector_find(cVector* pInstance, const void* elem)
     
     if(NULL != elem)
     {
-	    for(idx = 0; idx < pInstance->vectSize; ++idx)
-	    {
-	        if(0 == memcmp(elem, (void*)CVECTOR_CALC_IDX_PTR_VAL(pInstance, idx), pInstance->elemSize))
-	        {                
-		        break;
-	        }
-	    }	
+        idx = cFind_first(pInstance->array, pInstance->vectSize, pInstance->elemSizeAligned, elem, pInstance->elemSize);
+
+        CSTATS_ADD(pInstance, findCount, 1);
+        CSTATS_ADD(pInstance, compareCount, (idx < pInstance->vectSize) ? (idx + 1) : idx);
     }
     
     return idx;
 }
 
 
-int		cVector_insert(cVector* pInstance, const void* newElem, const size_t idx)
+void*	cVector_emplaceAt(cVector* pInstance, const size_t idx)
 {
-    int result = -1;
-    
+    void* slot = NULL;
+
     if(NULL != pInstance)
     {
-        if(NULL != newElem)
+        if(idx <= pInstance->vectSize)
         {
-            if(idx <= pInstance->vectSize)
+            if(0 == cVector_reserveFor(pInstance, pInstance->vectSize + 1))
             {
-                void* newArrayPtr = pInstance->array;
-                
-                if((size_t)(0) == pInstance->vectSize)
+                if(idx < pInstance->vectSize)
                 {
-                    pInstance->allocSize = CVECTOR_ALLOC_POWER_SIZE_RND;
-                    newArrayPtr = (void*)malloc((pInstance->allocSize * pInstance->elemSizeAligned));
+                    memmove((void*)CVECTOR_CALC_IDX_PTR_VAL(pInstance, idx+1), (const void*)CVECTOR_CALC_IDX_PTR_VAL(pInstance, idx), ((pInstance->vectSize * pInstance->elemSizeAligned) - (CVECTOR_CALC_IDX_PTR_VAL(pInstance, idx) - (size_t)pInstance->array)));
+                    CSTATS_ADD(pInstance, bytesMoved, (pInstance->vectSize - idx) * pInstance->elemSizeAligned);
                 }
-                else
+
+                ++pInstance->vectSize;
+                CSTATS_ADD(pInstance, insertCount, 1);
+
+                slot = (void*)CVECTOR_CALC_IDX_PTR_VAL(pInstance, idx);
+            }
+        }
+    }
+
+    return slot;
+}
+
+int		cVector_insert(cVector* pInstance, const void* newElem, const size_t idx)
+{
+    int result = -1;
+    
+    if(NULL != newElem)
+    {
+        void* slot = cVector_emplaceAt(pInstance, idx);
+
+        if(NULL != slot)
+        {
+            memcpy(slot, newElem, pInstance->elemSize);
+            result = 0;
+        }
+    }
+
+    return result;
+}
+
+
+int     cVector_insertRange(cVector* pInstance, const void* src, const size_t count, const size_t idx)
+{
+    int result = -1;
+
+    if((NULL != pInstance) && (idx <= pInstance->vectSize) && ((NULL != src) || ((size_t)(0) == count)))
+    {
+        if((size_t)(0) == count)
+        {
+            result = 0;
+        }
+        else if((count <= ((size_t)(-1) - pInstance->vectSize)) && (0 == cVector_reserveFor(pInstance, pInstance->vectSize + count)))
+        {
+            if(idx < pInstance->vectSize)
+            {
+                memmove((void*)CVECTOR_CALC_IDX_PTR_VAL(pInstance, idx + count), (const void*)CVECTOR_CALC_IDX_PTR_VAL(pInstance, idx), ((pInstance->vectSize - idx) * pInstance->elemSizeAligned));
+                CSTATS_ADD(pInstance, bytesMoved, (pInstance->vectSize - idx) * pInstance->elemSizeAligned);
+            }
+
+            if(pInstance->elemSize == pInstance->elemSizeAligned)
+            {
+                memcpy((void*)CVECTOR_CALC_IDX_PTR_VAL(pInstance, idx), src, (count * pInstance->elemSize));
+            }
+            else
+            {
+                /*The source array is not padded like the vector array*/
+                size_t srcIdx;
+
+                for(srcIdx = 0; srcIdx < count; ++srcIdx)
                 {
-#if (1 < CVECTOR_ALLOC_POWER_SIZE)						
-                    if(pInstance->vectSize == pInstance->allocSize)
-                    {
-                        /*Allocate space with the nearest power*/					
-                        pInstance->allocSize *= CVECTOR_ALLOC_POWER_SIZE_RND;
-                        newArrayPtr = (void*)realloc(pInstance->array, (pInstance->allocSize * pInstance->elemSizeAligned));
-                    }                   	
-#else
-                    ++(pInstance->allocSize);
-                    newArrayPtr = (void*)realloc(pInstance->array, (pInstance->allocSize * pInstance->elemSizeAligned));
-#endif
+                    memcpy((void*)CVECTOR_CALC_IDX_PTR_VAL(pInstance, idx + srcIdx), (const void*)((size_t)src + (srcIdx * pInstance->elemSize)), pInstance->elemSize);
                 }
-                
-                if(NULL != newArrayPtr)
-                {
-                    pInstance->array = newArrayPtr;                                        
+            }
+
+            pInstance->vectSize += count;
+            CSTATS_ADD(pInstance, insertCount, count);
+
+            result = 0;
+        }
+    }
+
+    return result;
+}
 
-                    if(idx < pInstance->vectSize)
-                    {
-                        memmove((void*)CVECTOR_CALC_IDX_PTR_VAL(pInstance, idx+1), (const void*)CVECTOR_CALC_IDX_PTR_VAL(pInstance, idx), ((pInstance->vectSize * pInstance->elemSizeAligned) - (CVECTOR_CALC_IDX_PTR_VAL(pInstance, idx) - (size_t)pInstance->array)));
-                    }                    
+int     cVector_append(cVector* pInstance, const cVector* pOther)
+{
+    int result = -1;
+
+    if((NULL != pInstance) && (NULL != pOther) && (pInstance->elemSize == pOther->elemSize))
+    {
+        const size_t count = pOther->vectSize;
 
-                    memcpy((void*)CVECTOR_CALC_IDX_PTR_VAL(pInstance, idx), newElem, pInstance->elemSizeAligned);
-                   
-                    ++pInstance->vectSize;
+        if((size_t)(0) == count)
+        {
+            result = 0;
+        }
+        else if((count <= ((size_t)(-1) - pInstance->vectSize)) && (0 == cVector_reserveFor(pInstance, pInstance->vectSize + count)))
+        {
+            /*The source is read after the reservation in case the vector is appended to itself*/
+            if(pInstance->elemSizeAligned == pOther->elemSizeAligned)
+            {
+                memcpy((void*)CVECTOR_CALC_IDX_PTR_VAL(pInstance, pInstance->vectSize), (const void*)pOther->array, (count * pInstance->elemSizeAligned));
+            }
+            else
+            {
+                /*The vectors have different element alignments, see cVector_setAlignment*/
+                size_t srcIdx;
 
-                    result = 0;
+                for(srcIdx = 0; srcIdx < count; ++srcIdx)
+                {
+                    memcpy((void*)CVECTOR_CALC_IDX_PTR_VAL(pInstance, pInstance->vectSize + srcIdx), (const void*)CVECTOR_CALC_IDX_PTR_VAL(pOther, srcIdx), pInstance->elemSize);
                 }
             }
+
+            pInstance->vectSize += count;
+            CSTATS_ADD(pInstance, insertCount, count);
+
+            result = 0;
         }
     }
 
     return result;
 }
 
+/*Shrinks the array after an erase according to the growth policy. The array is
+  divided by the growth factor while it is less than 1/shrinkDivisor full, but it is
+  never shrunk below the initial allocation size.*/
+static void cVector_shrinkAfterErase(cVector* pInstance)
+{
+    if(CPOLICY_NEVER_SHRINK != pInstance->policy.shrinkDivisor)
+    {
+        const size_t growthFactor = pInstance->policy.growthFactor;
+        size_t newAllocSize = pInstance->allocSize;
+
+        while((pInstance->vectSize * pInstance->policy.shrinkDivisor) < newAllocSize)
+        {
+            size_t nextAllocSize = ((size_t)(1) < growthFactor) ? (newAllocSize / growthFactor) : pInstance->vectSize;
+
+            if(nextAllocSize < growthFactor)
+            {
+                nextAllocSize = growthFactor;
+            }
+
+            if((nextAllocSize < pInstance->vectSize) || (nextAllocSize >= newAllocSize))
+            {
+                break;
+            }
+
+            newAllocSize = nextAllocSize;
+        }
+
+        /*Shrinking realloc keeps the array on failure, so the result is not needed*/
+        (void)cVector_resize(pInstance, newAllocSize);
+    }
+}
 
 int 	cVector_eraseAt(cVector* pInstance, const size_t idx)
 {
@@ -130,27 +338,12 @@ int 	cVector_eraseAt(cVector* pInstance, const size_t idx)
         if((size_t)(0) < pInstance->vectSize)
         {
             memmove((void*)CVECTOR_CALC_IDX_PTR_VAL(pInstance, idx), (const void*)CVECTOR_CALC_IDX_PTR_VAL(pInstance, idx+1), ((pInstance->vectSize * pInstance->elemSizeAligned) - (CVECTOR_CALC_IDX_PTR_VAL(pInstance, idx) - (size_t)pInstance->array)));
-			
-#if (1 < CVECTOR_ALLOC_POWER_SIZE)
-			if(CVECTOR_ALLOC_POWER_SIZE_RND < pInstance->allocSize)
-            {				
-				if(pInstance->vectSize == (pInstance->allocSize / CVECTOR_ALLOC_POWER_SIZE_RND))				
-				{				
-					pInstance->array = (void*)realloc(pInstance->array, (pInstance->vectSize * pInstance->elemSizeAligned));
-					
-					pInstance->allocSize /= CVECTOR_ALLOC_POWER_SIZE_RND;
-				}
-			}
-#else
-			pInstance->array = (void*)realloc(pInstance->array, (pInstance->vectSize * pInstance->elemSizeAligned));
-			--(pInstance->allocSize);
-#endif		
-	    }
-	    else
-	    {
-			free(pInstance->array);
-			pInstance->allocSize = (size_t)(0);
+            CSTATS_ADD(pInstance, bytesMoved, (pInstance->vectSize - idx) * pInstance->elemSizeAligned);
 	    }
+
+        CSTATS_ADD(pInstance, eraseCount, 1);
+
+        cVector_shrinkAfterErase(pInstance);
         
         returnVal = 0;
     }
@@ -158,11 +351,132 @@ int 	cVector_eraseAt(cVector* pInstance, const size_t idx)
     return returnVal;
 }
 
+int     cVector_eraseRange(cVector* pInstance, const size_t first, const size_t last)
+{
+    int returnVal = -1;
+
+    if((first <= last) && (last <= pInstance->vectSize))
+    {
+        if(first < last)
+        {
+            if(last < pInstance->vectSize)
+            {
+                memmove((void*)CVECTOR_CALC_IDX_PTR_VAL(pInstance, first), (const void*)CVECTOR_CALC_IDX_PTR_VAL(pInstance, last), ((pInstance->vectSize - last) * pInstance->elemSizeAligned));
+                CSTATS_ADD(pInstance, bytesMoved, (pInstance->vectSize - last) * pInstance->elemSizeAligned);
+            }
+
+            pInstance->vectSize -= (last - first);
+            CSTATS_ADD(pInstance, eraseCount, last - first);
+
+            cVector_shrinkAfterErase(pInstance);
+        }
+
+        returnVal = 0;
+    }
+
+    return returnVal;
+}
+
+int 	cVector_eraseAtUnordered(cVector* pInstance, const size_t idx)
+{
+    int returnVal = -1;
+
+    if(idx < pInstance->vectSize)
+    {
+        --(pInstance->vectSize);
+
+        if(idx < pInstance->vectSize)
+        {
+            memcpy((void*)CVECTOR_CALC_IDX_PTR_VAL(pInstance, idx), (const void*)CVECTOR_CALC_IDX_PTR_VAL(pInstance, pInstance->vectSize), pInstance->elemSizeAligned);
+            CSTATS_ADD(pInstance, bytesMoved, pInstance->elemSizeAligned);
+        }
+
+        CSTATS_ADD(pInstance, eraseCount, 1);
+
+        cVector_shrinkAfterErase(pInstance);
+
+        returnVal = 0;
+    }
+
+    return returnVal;
+}
+
 int     cVector_erase(cVector* pInstance, const void* elem)
 {
     return cVector_eraseAt(pInstance, cVector_find(pInstance, elem));
 }
 
+int     cVector_eraseUnordered(cVector* pInstance, const void* elem)
+{
+    return cVector_eraseAtUnordered(pInstance, cVector_find(pInstance, elem));
+}
+
+int     cVector_reserve(cVector* pInstance, const size_t count)
+{
+    int result = 0;
+
+    if(count > pInstance->allocSize)
+    {
+        result = cVector_resize(pInstance, count);
+    }
+
+    return result;
+}
+
+int     cVector_shrinkToFit(cVector* pInstance)
+{
+    return cVector_resize(pInstance, pInstance->vectSize);
+}
+
+int     cVector_setPolicy(cVector* pInstance, const cGrowthPolicy* pPolicy)
+{
+    int result = -1;
+
+    if((NULL != pPolicy) && ((size_t)(0) < pPolicy->growthFactor))
+    {
+        pInstance->policy = *pPolicy;
+        result = 0;
+    }
+
+    return result;
+}
+
+int     cVector_setAlignment(cVector* pInstance, const size_t elemAlign, const size_t baseAlign)
+{
+    int result = -1;
+    const size_t newElemAlign = ((size_t)(0) == elemAlign) ? sizeof(int) : elemAlign;
+
+    if((NULL == pInstance->array) && (NULL == pInstance->inlineBuffer) &&
+       CVECTOR_IS_POWER_OF_2(newElemAlign) && (((size_t)(0) == baseAlign) || CVECTOR_IS_POWER_OF_2(baseAlign)))
+    {
+        pInstance->elemSizeAligned = CVECTOR_ALIGN_SIZE(pInstance->elemSize, newElemAlign);
+        pInstance->elemAlign = newElemAlign;
+        /*The elements are aligned only if the array is*/
+        pInstance->baseAlign = (baseAlign < newElemAlign) ? newElemAlign : baseAlign;
+        result = 0;
+    }
+
+    return result;
+}
+
+int     cVector_stats(const cVector* pInstance, cStats* pStats)
+{
+    return CSTATS_GET(pInstance, pStats);
+}
+
+int     cVector_setAllocator(cVector* pInstance, const cAllocator* pAllocator)
+{
+    int result = -1;
+
+    if(!CVECTOR_IS_ARRAY_ALLOCATED(pInstance))
+    {
+        pInstance->allocator = pAllocator;
+        result = 0;
+    }
+
+    return result;
+}
+
 void concreteConstructCVector(cVector* instance, size_t elemSize)
 {
     if(NULL != instance)
@@ -171,8 +485,42 @@ void concreteConstructCVector(cVector* instance, size_t elemSize)
         instance->vectSize  = (size_t)(0);
         instance->allocSize = (size_t)(0);
         instance->array = NULL;
+        instance->allocator = NULL;
+        instance->inlineBuffer = NULL;
+        instance->inlineSize = (size_t)(0);
+        instance->elemAlign = sizeof(int);
+        instance->baseAlign = (size_t)(0);
 
         instance->elemSizeAligned = CVECTOR_ALIGN_SIZE(instance->elemSize, (sizeof(int)));
+
+        instance->policy.growthFactor  = CVECTOR_ALLOC_POWER_SIZE_RND;
+        instance->policy.shrinkDivisor = CVECTOR_SHRINK_DIVISOR;
+
+        CSTATS_INIT(instance, CSTATS_KIND_VECTOR);
     } 
 }
 
+
+void concreteConstructCVectorAligned(cVector* instance, size_t elemSize, size_t elemAlign, size_t baseAlign)
+{
+    concreteConstructCVector(instance, elemSize);
+
+    if(NULL != instance)
+    {
+        /*Invalid alignments leave the default ones*/
+        (void)cVector_setAlignment(instance, elemAlign, baseAlign);
+    }
+}
+
+
+
+void concreteConstructCSmallVector(cVector* instance, size_t elemSize, void* inlineBuffer, size_t inlineBufferSize)
+{
+    concreteConstructCVector(instance, elemSize);
+
+    if(NULL != instance)
+    {
+        instance->inlineBuffer = inlineBuffer;
+        instance->inlineSize = (NULL != inlineBuffer) ? (inlineBufferSize / instance->elemSizeAligned) : (size_t)(0);
+    }
+}
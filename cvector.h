@@ -14,6 +14,15 @@
  
  Change Log:
  22.03.2019 first release
+ 16.10.2026 unordered (swap with last) erase
+ 16.10.2026 per instance growth policy, reserve and shrinkToFit
+ 16.10.2026 pluggable allocator
+ 16.10.2026 small vector (inline buffer) variant
+ 16.10.2026 vectorized find kernel (cfind)
+ 16.10.2026 operation statistics (cstats)
+ 16.10.2026 emplace (in place construction)
+ 16.10.2026 range insert, range erase and append
+ 16.10.2026 configurable element and array alignment
  ------------------------------------------------------------------------------------------------*/
 
 
@@ -25,6 +34,9 @@ extern "C" {
 #endif
 
 #include <stddef.h>
+#include "cpolicy.h"
+#include "callocator.h"
+#include "cstats.h"
 
 typedef struct cVectorType cVector;
 
@@ -45,8 +57,44 @@ struct cVectorType{
      size_t allocSize;
 	 /*dynamic array of the recorded elements*/
      void* array;
+     /*growth policy of the array*/
+     cGrowthPolicy policy;
+     /*allocator of the array, NULL for the standard library*/
+     const cAllocator* allocator;
+     /*inline buffer of a small vector, NULL for the others*/
+     void* inlineBuffer;
+     /*capacity of the inline buffer, in terms of elements*/
+     size_t inlineSize;
+     /*alignment of the elements in bytes*/
+     size_t elemAlign;
+     /*alignment of the array address in bytes, 0 for that of the allocator*/
+     size_t baseAlign;
+     /*operation statistics, only if CSTATS_ENABLED is defined*/
+     CSTATS_MEMBER
 };
 
+/*This is the type definition macro of a small vector holding up to INLINE_ALLOC elements
+  without any allocation. It is used through its "vector" member with all of the cVector
+  methods, and the array spills to the heap only when it exceeds INLINE_ALLOC elements.
+  
+  NOTE: the array of a small vector may point to the struct itself, so the struct must
+  not be copied or moved. It still has to be cleared at the end of the scope.
+  
+  Example:
+     cSmallVector(uint32_t, 8) idList;
+     constructCSmallVector(&idList, uint32_t);
+     cVector_pushb(&idList.vector, &id);
+     ...
+     cVector_clear(&idList.vector);*/
+#define cSmallVector(VALUE_TYPE, INLINE_ALLOC)\
+    struct {\
+        cVector vector;\
+        union {\
+            VALUE_TYPE alignment;\
+            int buffer[(INLINE_ALLOC) * ((sizeof(VALUE_TYPE) + sizeof(int) - 1) / sizeof(int))];\
+        } inlineStorage;\
+    }
+
 /* Returns the element at the index "idx".
 	\param instance : cVector instance pointer
 	\param idx 		: index value.
@@ -75,6 +123,33 @@ size_t 	cVector_find(cVector* pInstance, const void* elem);
 	\return 		: result: 0 = Success, -1 = Failure*/
 int		cVector_insert(cVector* pInstance, const void* newElem, const size_t idx);
 
+/* Opens an uninitialized slot at the index "idx", so that the element can be built in place
+   instead of being copied from another one.
+   NOTE: the slot is valid until the next insertion or erasure of the vector.
+	\param instance : cVector instance pointer
+	\param idx 		: index value.
+	\return 		: pointer of the slot, NULL on failure*/
+void*	cVector_emplaceAt(cVector* pInstance, const size_t idx);
+
+/* Adds "count" elements to the index "idx" with a single reallocation and a single move of
+   the following elements.
+   NOTE: "src" must not point into the vector, see cVector_append.
+	\param instance : cVector instance pointer
+	\param src      : array of the elements to be added, of the element type
+	\param count    : number of the elements
+	\param idx 		: the insertion index
+	\return 		: result: 0 = Success, -1 = Failure*/
+int     cVector_insertRange(cVector* pInstance, const void* src, const size_t count, const size_t idx);
+
+/* Adds the elements of another vector of the same element size to the end of the vector, with
+   a single reallocation. The element alignments of the vectors may differ (see
+   cVector_setAlignment), the elements are then copied one by one. The vector can be appended
+   to itself.
+	\param instance : cVector instance pointer
+	\param pOther   : the vector whose elements are added
+	\return 		: result: 0 = Success, -1 = Failure*/
+int     cVector_append(cVector* pInstance, const cVector* pOther);
+
 
 /* Deletes the element at the index "idx".
 	\param instance : cVector instance pointer
@@ -88,9 +163,78 @@ int 	cVector_eraseAt(cVector* pInstance, const size_t idx);
 	\return 		: result: 0 = Success, -1 = Failure*/
 int     cVector_erase(cVector* pInstance, const void* elem);   
 
+/* Deletes the elements in the index range ["first", "last") with a single move of the following
+   elements. The vector is shrunk at most once, by the policy of the erase methods.
+	\param instance : cVector instance pointer
+	\param first 	: index of the first element to be deleted
+	\param last 	: index after the last element to be deleted
+	\return 		: result: 0 = Success, -1 = Failure*/
+int     cVector_eraseRange(cVector* pInstance, const size_t first, const size_t last);
+
+/* Deletes the element at the index "idx" in O(1) time by moving the last element
+   into its place. The element order is not kept.
+	\param instance : cVector instance pointer
+	\param idx 		: index value.
+	\return 		: result: 0 = Success, -1 = Failure*/
+int 	cVector_eraseAtUnordered(cVector* pInstance, const size_t idx);
+
+/* Deletes the element given by moving the last element into its place.
+   The element order is not kept.
+	\param instance : cVector instance pointer
+	\param elem 	: pointer of the element.
+	\return 		: result: 0 = Success, -1 = Failure*/
+int     cVector_eraseUnordered(cVector* pInstance, const void* elem);
+
+/* Makes the vector able to hold "count" elements without any reallocation.
+	\param instance : cVector instance pointer
+	\param count 	: number of the elements.
+	\return 		: result: 0 = Success, -1 = Failure*/
+int     cVector_reserve(cVector* pInstance, const size_t count);
+
+/* Reallocates the vector with the number of elements it holds. An empty
+   vector is released.
+	\param instance : cVector instance pointer
+	\return 		: result: 0 = Success, -1 = Failure*/
+int     cVector_shrinkToFit(cVector* pInstance);
+
+/* Sets the growth policy of the vector. The default policy grows the vector
+   by 2 and shrinks it when it is less than 1/4 full.
+	\param instance : cVector instance pointer
+	\param pPolicy  : pointer of the policy. growthFactor must be greater than 0.
+	\return 		: result: 0 = Success, -1 = Failure*/
+int     cVector_setPolicy(cVector* pInstance, const cGrowthPolicy* pPolicy);
+
+/* Sets the allocator of the vector. It should be called after the construction,
+   before the first element is added.
+	\param instance   : cVector instance pointer
+	\param pAllocator : allocator pointer, NULL for the standard library. It must
+                         outlive the vector.
+	\return 		  : result: 0 = Success, -1 = Failure (the array is already allocated)*/
+int     cVector_setAllocator(cVector* pInstance, const cAllocator* pAllocator);
+
+/* Sets the alignment of the elements and of the array, e.g. 16 or 32 bytes for SIMD types,
+   64 bytes (a cache line) to keep the elements updated by different threads apart, or 4096
+   bytes (a page) for the array. It is applied to every allocation of the array. It should be
+   called after the construction, before the first element is added. Small vectors keep the
+   alignment of their inline buffer.
+	\param instance  : cVector instance pointer
+	\param elemAlign : alignment of the elements in bytes, a power of 2. The element size is
+                        padded to it. 0 for the default, sizeof(int)
+	\param baseAlign : alignment of the array address in bytes, a power of 2. 0 for elemAlign
+	\return 		  : result: 0 = Success, -1 = Failure (invalid alignment, the array is
+                        already allocated or the vector is small)*/
+int     cVector_setAlignment(cVector* pInstance, const size_t elemAlign, const size_t baseAlign);
+
+/* Gives the operation statistics of the vector.
+	\param instance : cVector instance pointer
+	\param pStats   : the counters of the vector since its construction
+	\return 		: result: 0 = Success, -1 = Failure (CSTATS_ENABLED is not defined)*/
+int     cVector_stats(const cVector* pInstance, cStats* pStats);
+
 /* Macro Extensions */
 /*---------------------------------------------------------------------------*/
 /* Adds new element to the start of the vector.
+   NOTE: it shifts the whole array. Use cDeque for queues.
 	\param instance : cVector instance pointer
 	\param newElem	: pointer of the element to be added.
 	\return 		: result: 0 = Success, -1 = Failure*/
@@ -110,6 +254,12 @@ int     cVector_erase(cVector* pInstance, const void* elem);
 #define cVector_pushb(pInstance, newElem)\
         cVector_insert(pInstance, newElem, (pInstance)->vectSize)
 
+/* Opens an uninitialized slot at the end of the vector.
+	\param instance : cVector instance pointer
+	\return 		: pointer of the slot, NULL on failure*/
+#define cVector_emplaceBack(pInstance)\
+        cVector_emplaceAt(pInstance, (pInstance)->vectSize)
+
 /* Clears the element at the end of the vector.
 	\param instance : cVector instance pointer	
 	\return 		: result: 0 = Success, -1 = Failure*/
@@ -129,6 +279,32 @@ void concreteConstructCVector(cVector* instance, size_t elemSize);
 /*This is a macro wrapper for "concreteConstructCVector" function, provides creation
 using typenames. (C++ template logic)*/
 #define constructCVector(instance, TYPE)  concreteConstructCVector(instance, sizeof(TYPE))
+
+/*This function constructs an allocated cVector object with the given alignments, see
+  cVector_setAlignment. Invalid alignments leave the default ones.
+  \param instance 	: allocated cVector pointer to be constructed
+  \param elemSize 	: size of the element type
+  \param elemAlign 	: alignment of the elements in bytes, 0 for the default
+  \param baseAlign 	: alignment of the array address in bytes, 0 for elemAlign
+  \return		  	: none*/
+void concreteConstructCVectorAligned(cVector* instance, size_t elemSize, size_t elemAlign, size_t baseAlign);
+
+/*This is a macro wrapper for "concreteConstructCVectorAligned" function, provides creation
+using typenames. (C++ template logic)*/
+#define constructCVectorAligned(instance, TYPE, elemAlign, baseAlign)  concreteConstructCVectorAligned(instance, sizeof(TYPE), elemAlign, baseAlign)
+
+/*This function constructs a cVector object using the given buffer as its inline storage.
+  \param instance 	      : allocated cVector pointer to be constructed
+  \param elemSize 	      : size of the element type
+  \param inlineBuffer     : buffer used before any allocation, aligned for the element type
+  \param inlineBufferSize : size of the buffer in bytes
+  \return		  	      : none*/
+void concreteConstructCSmallVector(cVector* instance, size_t elemSize, void* inlineBuffer, size_t inlineBufferSize);
+
+/*This is a macro wrapper for "concreteConstructCSmallVector" function, constructs a
+cSmallVector typed object.*/
+#define constructCSmallVector(pSmallVector, TYPE)  concreteConstructCSmallVector(&((pSmallVector)->vector), sizeof(TYPE),\
+        (void*)&((pSmallVector)->inlineStorage), sizeof((pSmallVector)->inlineStorage))
 /*---------------------------------------------------------------------------*/
 
 #ifdef __cplusplus
@@ -0,0 +1,216 @@
+/*
+ Tests of cMap in all of its modes
+
+ Each mode (linear, unordered erase, structure of arrays, sorted, hashed and hashed with
+ colliding hashes) is filled with the same keys, then searched one by one and in batches, and
+ half of the keys are erased. NULL keys must be refused without touching the map.
+ ------------------------------------------------------------------------------------------------*/
+
+#include "cmap.h"
+#include "testcommon.h"
+
+/*Number of the keys of a test*/
+#define TEST_MAP_KEY_COUNT          ((unsigned int)(300))
+/*Number of the keys looked up by a batch*/
+#define TEST_MAP_BATCH_SIZE         ((size_t)(50))
+
+typedef enum {
+    TEST_MAP_LINEAR = 0,
+    TEST_MAP_UNORDERED,
+    TEST_MAP_SOA,
+    TEST_MAP_SORTED,
+    TEST_MAP_HASHED,
+    TEST_MAP_COLLIDING,
+    TEST_MAP_MODE_COUNT
+} testMapMode;
+
+static const char* const testMapModeNames[TEST_MAP_MODE_COUNT] = {
+    "linear", "unordered", "soa", "sorted", "hashed", "colliding"
+};
+
+/*Orders the keys by their value, unlike the bytewise comparison*/
+static int testCompareKeys(const void* key1, const void* key2, size_t keySize)
+{
+    const unsigned int value1 = *(const unsigned int*)key1;
+    const unsigned int value2 = *(const unsigned int*)key2;
+
+    (void)keySize;
+
+    return (value1 < value2) ? -1 : ((value1 > value2) ? 1 : 0);
+}
+
+/*Puts the keys into a few slots only, so that the probes go through long clusters*/
+static size_t testCollidingHash(const void* key, size_t keySize)
+{
+    (void)keySize;
+
+    return (size_t)((*(const unsigned int*)key) % 7U);
+}
+
+/*Key of the given position, in a scrambled order*/
+static unsigned int testKeyAt(const unsigned int idx)
+{
+    return ((idx * 37U) % TEST_MAP_KEY_COUNT) * 2U;
+}
+
+static void testConstructMap(cMap* pMap, const testMapMode mode)
+{
+    switch(mode)
+    {
+        case TEST_MAP_UNORDERED:
+            constructCMapFlags(pMap, unsigned int, unsigned int, CMAP_FLAG_UNORDERED_ERASE);
+            break;
+        case TEST_MAP_SOA:
+            constructCMapFlags(pMap, unsigned int, unsigned int, CMAP_FLAG_SOA_LAYOUT);
+            break;
+        case TEST_MAP_SORTED:
+            constructCSortedMap(pMap, unsigned int, unsigned int, testCompareKeys);
+            break;
+        case TEST_MAP_HASHED:
+            constructCHashMap(pMap, unsigned int, unsigned int, NULL, NULL);
+            break;
+        case TEST_MAP_COLLIDING:
+            constructCHashMap(pMap, unsigned int, unsigned int, testCollidingHash, testCompareKeys);
+            break;
+        default:
+            constructCMap(pMap, unsigned int, unsigned int);
+            break;
+    }
+}
+
+/*Checks that the map holds exactly the keys of [first, TEST_MAP_KEY_COUNT) positions*/
+static void testCheckContents(cMap* pMap, const testMapMode mode, const unsigned int first)
+{
+    unsigned int idx;
+
+    TEST_CHECK(cMap_size(pMap) == (size_t)(TEST_MAP_KEY_COUNT - first));
+
+    for(idx = 0; idx < TEST_MAP_KEY_COUNT; ++idx)
+    {
+        const unsigned int key = testKeyAt(idx);
+        const unsigned int missingKey = key + 1U;
+        cPair pair;
+
+        if(idx < first)
+        {
+            TEST_CHECK(0 != cMap_find(pMap, &key, &pair));
+        }
+        else
+        {
+            TEST_CHECK((0 == cMap_find(pMap, &key, &pair)) && (key * 3U == *(unsigned int*)pair.second));
+        }
+        TEST_CHECK(0 != cMap_find(pMap, &missingKey, &pair));
+    }
+
+    if(TEST_MAP_SORTED == mode)
+    {
+        cPair prevPair;
+        cPair pair;
+
+        for(idx = 1; idx < (unsigned int)cMap_size(pMap); ++idx)
+        {
+            (void)cMap_getAt(pMap, idx - 1, &prevPair);
+            (void)cMap_getAt(pMap, idx, &pair);
+            TEST_CHECK(*(unsigned int*)prevPair.first < *(unsigned int*)pair.first);
+        }
+    }
+}
+
+static void testFindBatch(cMap* pMap)
+{
+    unsigned int keys[TEST_MAP_BATCH_SIZE];
+    cPair results[TEST_MAP_BATCH_SIZE];
+    size_t idx;
+
+    /*The even positions hold keys of the map, the odd ones keys which are not*/
+    for(idx = 0; idx < TEST_MAP_BATCH_SIZE; ++idx)
+    {
+        keys[idx] = testKeyAt((unsigned int)idx) + (unsigned int)(idx % 2);
+    }
+
+    TEST_CHECK(cMap_findBatch(pMap, keys, TEST_MAP_BATCH_SIZE, results) == (TEST_MAP_BATCH_SIZE / 2));
+
+    for(idx = 0; idx < TEST_MAP_BATCH_SIZE; ++idx)
+    {
+        if(0 == (idx % 2))
+        {
+            TEST_CHECK((NULL != results[idx].second) && (keys[idx] * 3U == *(unsigned int*)results[idx].second));
+        }
+        else
+        {
+            TEST_CHECK((NULL == results[idx].first) && (NULL == results[idx].second));
+        }
+    }
+}
+
+static void testMode(const testMapMode mode)
+{
+    cMap map;
+    unsigned int idx;
+    unsigned int key;
+    unsigned int value;
+    cPair pair;
+    int inserted;
+    const unsigned long failCount = testFailCount;
+
+    testConstructMap(&map, mode);
+
+    for(idx = 0; idx < TEST_MAP_KEY_COUNT; ++idx)
+    {
+        key = testKeyAt(idx);
+        value = key * 3U;
+        pair.first  = (void*)&key;
+        pair.second = (void*)&value;
+        TEST_CHECK(0 == cMap_insert(&map, &pair));
+    }
+    testCheckContents(&map, mode, 0U);
+    testFindBatch(&map);
+
+    /*emplace finds the pairs already in the map*/
+    key = testKeyAt(0U);
+    TEST_CHECK((0 == cMap_emplace(&map, &key, &pair, &inserted)) && (0 == inserted));
+    TEST_CHECK(cMap_size(&map) == (size_t)TEST_MAP_KEY_COUNT);
+
+    /*NULL keys are refused*/
+    TEST_CHECK(0 != cMap_find(&map, NULL, &pair));
+    TEST_CHECK(0 != cMap_erase(&map, NULL));
+    TEST_CHECK(0 != cMap_emplace(&map, NULL, &pair, &inserted));
+    TEST_CHECK(cMap_size(&map) == (size_t)TEST_MAP_KEY_COUNT);
+
+    for(idx = 0; idx < (TEST_MAP_KEY_COUNT / 2); ++idx)
+    {
+        key = testKeyAt(idx);
+        TEST_CHECK(0 == cMap_erase(&map, &key));
+        TEST_CHECK(0 != cMap_erase(&map, &key));
+    }
+    testCheckContents(&map, mode, TEST_MAP_KEY_COUNT / 2);
+
+    if(TEST_MAP_SORTED == mode)
+    {
+        /*The bounds of the smallest key left*/
+        key = 0U;
+        TEST_CHECK(0 == cMap_getAt(&map, cMap_lowerBound(&map, &key), &pair));
+        key = *(unsigned int*)pair.first;
+        TEST_CHECK(cMap_upperBound(&map, &key) == (cMap_lowerBound(&map, &key) + 1));
+    }
+
+    cMap_clear(&map);
+    TEST_CHECK((size_t)(0) == cMap_size(&map));
+
+    if(failCount != testFailCount)
+    {
+        fprintf(stderr, "failed mode: %s\n", testMapModeNames[mode]);
+    }
+}
+
+int main(void)
+{
+    int mode;
+
+    for(mode = 0; mode < (int)TEST_MAP_MODE_COUNT; ++mode)
+    {
+        testMode((testMapMode)mode);
+    }
+
+    return testResult();
+}
@@ -0,0 +1,124 @@
+/*
+ Tests of the parallel map build
+
+ cParallel_buildMap must give the same map as cMap_buildFrom from the same pairs, including the
+ duplicate keys whose last value wins, for each map kind and a few pool sizes.
+ ------------------------------------------------------------------------------------------------*/
+
+#include <stdlib.h>
+#include "cparallel.h"
+#include "testcommon.h"
+
+/*Number of the pairs of a build, large enough to be split between the workers*/
+#define TEST_PARALLEL_COUNT         ((size_t)(20000))
+/*Keys are drawn from [0, TEST_PARALLEL_KEY_RANGE), so that about half of them are duplicates*/
+#define TEST_PARALLEL_KEY_RANGE     10000UL
+
+typedef enum {
+    TEST_PARALLEL_LINEAR = 0,
+    TEST_PARALLEL_SORTED,
+    TEST_PARALLEL_HASHED,
+    TEST_PARALLEL_COLLIDING,
+    TEST_PARALLEL_KIND_COUNT
+} testParallelMapKind;
+
+/*Puts the keys into a few slots only, so that the probes go through long clusters*/
+static size_t testCollidingHash(const void* key, size_t keySize)
+{
+    (void)keySize;
+
+    return (size_t)((*(const unsigned long*)key) % 61UL);
+}
+
+static void testConstructMap(cMap* pMap, const testParallelMapKind kind)
+{
+    switch(kind)
+    {
+        case TEST_PARALLEL_SORTED:
+            constructCSortedMap(pMap, unsigned long, unsigned long, NULL);
+            break;
+        case TEST_PARALLEL_HASHED:
+            constructCHashMap(pMap, unsigned long, unsigned long, NULL, NULL);
+            break;
+        case TEST_PARALLEL_COLLIDING:
+            constructCHashMap(pMap, unsigned long, unsigned long, testCollidingHash, NULL);
+            break;
+        default:
+            constructCMap(pMap, unsigned long, unsigned long);
+            break;
+    }
+}
+
+/*Builds a map of the given kind both ways and compares them*/
+static void testBuild(cThreadPool* pPool, const testParallelMapKind kind, const unsigned long* keys, const unsigned long* values)
+{
+    cMap parallelMap;
+    cMap serialMap;
+    size_t idx;
+
+    testConstructMap(&parallelMap, kind);
+    testConstructMap(&serialMap, kind);
+
+    TEST_CHECK(0 == cParallel_buildMap(pPool, &parallelMap, keys, values, TEST_PARALLEL_COUNT));
+    TEST_CHECK(0 == cMap_buildFrom(&serialMap, keys, values, TEST_PARALLEL_COUNT));
+    TEST_CHECK(cMap_size(&parallelMap) == cMap_size(&serialMap));
+
+    for(idx = 0; idx < cMap_size(&serialMap); ++idx)
+    {
+        cPair serialPair;
+        cPair parallelPair;
+
+        (void)cMap_getAt(&serialMap, idx, &serialPair);
+        TEST_CHECK((0 == cMap_find(&parallelMap, serialPair.first, &parallelPair)) &&
+                   (*(unsigned long*)serialPair.second == *(unsigned long*)parallelPair.second));
+    }
+
+    cMap_clear(&parallelMap);
+    cMap_clear(&serialMap);
+}
+
+int main(void)
+{
+    static const size_t workerCounts[] = { 1, 2, 4 };
+    unsigned long* keys = (unsigned long*)malloc(TEST_PARALLEL_COUNT * sizeof(unsigned long));
+    unsigned long* values = (unsigned long*)malloc(TEST_PARALLEL_COUNT * sizeof(unsigned long));
+    unsigned long seed = 2463534242UL;
+    size_t idx;
+
+    if((NULL == keys) || (NULL == values))
+    {
+        fprintf(stderr, "cannot allocate the pairs\n");
+        return EXIT_FAILURE;
+    }
+
+    for(idx = 0; idx < TEST_PARALLEL_COUNT; ++idx)
+    {
+        seed = (seed * 1103515245UL + 12345UL) & 0xFFFFFFFFUL;
+        keys[idx] = (seed >> 8) % TEST_PARALLEL_KEY_RANGE;
+        values[idx] = (unsigned long)idx;
+    }
+
+    for(idx = 0; idx < (sizeof(workerCounts) / sizeof(workerCounts[0])); ++idx)
+    {
+        cThreadPool pool;
+        int kind;
+
+        if(0 != concreteConstructCThreadPool(&pool, workerCounts[idx]))
+        {
+            fprintf(stderr, "cannot construct a pool of %lu workers\n", (unsigned long)workerCounts[idx]);
+            return EXIT_FAILURE;
+        }
+
+        for(kind = 0; kind < (int)TEST_PARALLEL_KIND_COUNT; ++kind)
+        {
+            testBuild(&pool, (testParallelMapKind)kind, keys, values);
+        }
+
+        cThreadPool_destroy(&pool);
+    }
+
+    free((void*)keys);
+    free((void*)values);
+
+    return testResult();
+}
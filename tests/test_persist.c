@@ -0,0 +1,159 @@
+/*
+ Tests of the persistent snapshots
+
+ A vector and maps of each kind are saved, then loaded and mapped back, and must hold the same
+ elements with the same layout, including their element and array alignments.
+ ------------------------------------------------------------------------------------------------*/
+
+#include <stdio.h>
+#include "cpersist.h"
+#include "testcommon.h"
+
+/*Number of the elements of a test*/
+#define TEST_PERSIST_COUNT          ((unsigned int)(500))
+/*Alignments the containers are saved with*/
+#define TEST_PERSIST_ELEM_ALIGN     ((size_t)(8))
+#define TEST_PERSIST_BASE_ALIGN     ((size_t)(64))
+
+typedef enum {
+    TEST_PERSIST_LINEAR = 0,
+    TEST_PERSIST_SOA,
+    TEST_PERSIST_SORTED,
+    TEST_PERSIST_HASHED
+} testPersistMapKind;
+
+typedef struct {
+    unsigned int key;
+    unsigned int tag;
+    unsigned char flag;
+} testPersistElem;
+
+static const char* const testVectorPath = "test_persist_vector.bin";
+static const char* const testMapPath = "test_persist_map.bin";
+
+static void testCheckVector(cVector* pVector)
+{
+    unsigned int idx;
+
+    TEST_CHECK(cVector_size(pVector) == (size_t)TEST_PERSIST_COUNT);
+    TEST_CHECK(pVector->elemAlign == TEST_PERSIST_ELEM_ALIGN);
+    TEST_CHECK(0 == ((size_t)(pVector->array) % TEST_PERSIST_BASE_ALIGN));
+
+    for(idx = 0; idx < TEST_PERSIST_COUNT; ++idx)
+    {
+        const testPersistElem* pElem = (const testPersistElem*)cVector_getAt(pVector, idx);
+
+        TEST_CHECK((NULL != pElem) && (idx == pElem->key) && ((idx * 5U) == pElem->tag));
+    }
+}
+
+static void testVector(void)
+{
+    cVector vector;
+    cVector loaded;
+    cPersistMapping mapping;
+    unsigned int idx;
+
+    constructCVectorAligned(&vector, testPersistElem, TEST_PERSIST_ELEM_ALIGN, TEST_PERSIST_BASE_ALIGN);
+
+    for(idx = 0; idx < TEST_PERSIST_COUNT; ++idx)
+    {
+        testPersistElem elem;
+
+        elem.key  = idx;
+        elem.tag  = idx * 5U;
+        elem.flag = (unsigned char)(idx & 1U);
+        TEST_CHECK(0 == cVector_pushb(&vector, &elem));
+    }
+    TEST_CHECK(0 == cVector_save(&vector, testVectorPath));
+
+    TEST_CHECK(0 == cVector_load(&loaded, testVectorPath));
+    testCheckVector(&loaded);
+    TEST_CHECK(loaded.baseAlign == vector.baseAlign);
+    cVector_clear(&loaded);
+
+    TEST_CHECK(0 == cVector_map(&loaded, &mapping, testVectorPath, CPERSIST_FLAG_VERIFY));
+    testCheckVector(&loaded);
+    cPersist_unmap(&mapping);
+
+    cVector_clear(&vector);
+    (void)remove(testVectorPath);
+}
+
+static void testCheckMap(cMap* pMap)
+{
+    unsigned int key;
+
+    TEST_CHECK(cMap_size(pMap) == (size_t)TEST_PERSIST_COUNT);
+    TEST_CHECK(pMap->elemAlign == TEST_PERSIST_ELEM_ALIGN);
+
+    for(key = 0; key < TEST_PERSIST_COUNT; ++key)
+    {
+        const unsigned int missingKey = key + TEST_PERSIST_COUNT;
+        cPair pair;
+
+        TEST_CHECK((0 == cMap_find(pMap, &key, &pair)) && ((key * 7U) == *(unsigned int*)pair.second));
+        TEST_CHECK(0 != cMap_find(pMap, &missingKey, &pair));
+    }
+}
+
+/*Saves a map of the given kind, loads and maps it back*/
+static void testMap(const testPersistMapKind kind)
+{
+    cMap map;
+    cMap loaded;
+    cPersistMapping mapping;
+    unsigned int key;
+
+    switch(kind)
+    {
+        case TEST_PERSIST_SOA:
+            constructCMapFlags(&map, unsigned int, unsigned int, CMAP_FLAG_SOA_LAYOUT);
+            break;
+        case TEST_PERSIST_SORTED:
+            constructCSortedMap(&map, unsigned int, unsigned int, NULL);
+            break;
+        case TEST_PERSIST_HASHED:
+            constructCHashMap(&map, unsigned int, unsigned int, NULL, NULL);
+            break;
+        default:
+            constructCMap(&map, unsigned int, unsigned int);
+            break;
+    }
+    TEST_CHECK(0 == cMap_setAlignment(&map, TEST_PERSIST_ELEM_ALIGN, TEST_PERSIST_BASE_ALIGN));
+
+    for(key = 0; key < TEST_PERSIST_COUNT; ++key)
+    {
+        unsigned int value = key * 7U;
+        cPair pair;
+
+        pair.first  = (void*)&key;
+        pair.second = (void*)&value;
+        TEST_CHECK(0 == cMap_insert(&map, &pair));
+    }
+    TEST_CHECK(0 == cMap_save(&map, testMapPath));
+
+    TEST_CHECK(0 == cMap_load(&loaded, testMapPath, NULL, NULL));
+    testCheckMap(&loaded);
+    TEST_CHECK(loaded.baseAlign == map.baseAlign);
+    TEST_CHECK(0 == ((size_t)(loaded.pairArray) % TEST_PERSIST_BASE_ALIGN));
+    cMap_clear(&loaded);
+
+    TEST_CHECK(0 == cMap_map(&loaded, &mapping, testMapPath, NULL, NULL, CPERSIST_FLAG_VERIFY));
+    testCheckMap(&loaded);
+    cPersist_unmap(&mapping);
+
+    cMap_clear(&map);
+    (void)remove(testMapPath);
+}
+
+int main(void)
+{
+    testVector();
+    testMap(TEST_PERSIST_LINEAR);
+    testMap(TEST_PERSIST_SOA);
+    testMap(TEST_PERSIST_SORTED);
+    testMap(TEST_PERSIST_HASHED);
+
+    return testResult();
+}
@@ -0,0 +1,31 @@
+/*
+ Checks shared by the test programs run by ctest
+
+ TEST_CHECK reports a failed condition with its file and line and lets the test go on, so that
+ one run lists all of the failures. A test program returns testResult() from main.
+ ------------------------------------------------------------------------------------------------*/
+
+#ifndef TESTCOMMON_H
+#define TESTCOMMON_H
+
+#include <stdio.h>
+#include <stdlib.h>
+
+/*Number of the failed checks of the program*/
+static unsigned long testFailCount = 0UL;
+
+static void testFail(const char* condition, const char* file, const int line)
+{
+    fprintf(stderr, "%s:%d: check failed: %s\n", file, line, condition);
+    ++testFailCount;
+}
+
+/*Exit status of the program*/
+static int testResult(void)
+{
+    return (0UL == testFailCount) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+#define TEST_CHECK(condition)   ((condition) ? (void)0 : testFail(#condition, __FILE__, __LINE__))
+
+#endif